@@ -112,6 +112,18 @@ int		SG_OMP_Get_Max_Num_Procs	(void)	{	return( 1 );	}
 int		SG_OMP_Get_Thread_Num		(void)	{	return( 0 );	}
 #endif
 
+//---------------------------------------------------------
+/**
+  * Returns the size of the chunks into which a row of nItems
+  * is split for parallel processing. This is at most nMax, but
+  * smaller for short rows, so that each thread gets one.
+*/
+//---------------------------------------------------------
+int		SG_OMP_Get_Chunk_Size		(int nItems, int nMax)
+{
+	return( M_GET_MAX(1, M_GET_MIN(nMax, 1 + (nItems - 1) / SG_OMP_Get_Max_Num_Threads())) );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -180,6 +180,7 @@ SAGA_API_DLL_EXPORT void			SG_OMP_Set_Max_Num_Threads	(int iCores);
 SAGA_API_DLL_EXPORT int				SG_OMP_Get_Max_Num_Threads	(void);
 SAGA_API_DLL_EXPORT int				SG_OMP_Get_Max_Num_Procs	(void);
 SAGA_API_DLL_EXPORT int				SG_OMP_Get_Thread_Num		(void);
+SAGA_API_DLL_EXPORT int				SG_OMP_Get_Chunk_Size		(int nItems, int nMax);
 
 
 ///////////////////////////////////////////////////////////
@@ -1088,6 +1089,23 @@ SAGA_API_DLL_EXPORT int				SG_Data_Type_Get_Flag		(TSG_Data_Type Type);
 SAGA_API_DLL_EXPORT bool			SG_Data_Type_is_Numeric		(TSG_Data_Type Type);
 SAGA_API_DLL_EXPORT bool			SG_Data_Type_Range_Check	(TSG_Data_Type Type, double &Value);
 
+//---------------------------------------------------------
+#ifndef SWIG
+/** Returns the data type identifier corresponding to the built-in type TValue or SG_DATATYPE_Undefined. */
+template <typename TValue> inline TSG_Data_Type	SG_Data_Type_Get_Type	(void)	{	return( SG_DATATYPE_Undefined );	}
+
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<BYTE  >	(void)	{	return( SG_DATATYPE_Byte   );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<char  >	(void)	{	return( SG_DATATYPE_Char   );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<WORD  >	(void)	{	return( SG_DATATYPE_Word   );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<short >	(void)	{	return( SG_DATATYPE_Short  );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<DWORD >	(void)	{	return( SG_DATATYPE_DWord  );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<int   >	(void)	{	return( SG_DATATYPE_Int    );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<uLong >	(void)	{	return( SG_DATATYPE_ULong  );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<sLong >	(void)	{	return( SG_DATATYPE_Long   );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<float >	(void)	{	return( SG_DATATYPE_Float  );	}
+template <> inline TSG_Data_Type	SG_Data_Type_Get_Type<double>	(void)	{	return( SG_DATATYPE_Double );	}
+#endif	// #ifndef SWIG
+
 
 ///////////////////////////////////////////////////////////
 //														 //
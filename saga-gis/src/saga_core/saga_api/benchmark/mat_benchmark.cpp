@@ -0,0 +1,326 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   mat_benchmark.cpp                   //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Times the CSG_Matrix kernels (multiply, inverse, Cholesky
+// solver, symmetric eigen decomposition) against straight
+// forward reference implementations for a number of matrix
+// sizes and reports the largest deviation of the results.
+//
+// usage: saga_api_benchmark [size ...] [-r repetitions] [-t threads]
+//
+// To compare against an earlier revision of the library,
+// run the same binary with that revision's saga_api.
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static CSG_Matrix	Get_Random		(int n)
+{
+	CSG_Matrix A(n, n);
+
+	for(int y=0; y<n; y++) for(int x=0; x<n; x++)
+	{
+		A[y][x] = CSG_Random::Get_Uniform(-1., 1.);
+	}
+
+	return( A );
+}
+
+//---------------------------------------------------------
+static CSG_Matrix	Get_Symmetric	(int n)	// positive definite too
+{
+	CSG_Matrix B(Get_Random(n)), A(B.Multiply_Transposed(B));
+
+	for(int i=0; i<n; i++)
+	{
+		A[i][i] += n;
+	}
+
+	return( A );
+}
+
+//---------------------------------------------------------
+static double		Get_Difference	(const CSG_Matrix &A, const CSG_Matrix &B)
+{
+	double d = 0.;
+
+	for(int y=0; y<A.Get_NY(); y++) for(int x=0; x<A.Get_NX(); x++)
+	{
+		d = M_GET_MAX(d, fabs(A[y][x] - B[y][x]));
+	}
+
+	return( d );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Reference implementations, as the matrix operations were
+// done before the cache-blocked kernels had been introduced.
+
+//---------------------------------------------------------
+static CSG_Matrix	Ref_Multiply	(const CSG_Matrix &A, const CSG_Matrix &B)
+{
+	CSG_Matrix C(B.Get_NX(), A.Get_NY());
+
+	for(int y=0; y<C.Get_NY(); y++) for(int x=0; x<C.Get_NX(); x++)
+	{
+		double z = 0.;
+
+		for(int k=0; k<A.Get_NX(); k++)
+		{
+			z += A[y][k] * B[k][x];
+		}
+
+		C[y][x] = z;
+	}
+
+	return( C );
+}
+
+//---------------------------------------------------------
+static CSG_Matrix	Ref_Inverse		(const CSG_Matrix &A)
+{
+	int n = A.Get_NX(); CSG_Matrix LU(A), I(n, n); CSG_Array Permutation(sizeof(int), n); CSG_Vector v(n);
+
+	if( SG_Matrix_LU_Decomposition(n, (int *)Permutation.Get_Array(), LU.Get_Data()) )
+	{
+		for(int x=0; x<n; x++)
+		{
+			v.Assign(0.); v[x] = 1.;
+
+			SG_Matrix_LU_Solve(n, (int *)Permutation.Get_Array(), LU, v.Get_Data());
+
+			for(int y=0; y<n; y++)
+			{
+				I[y][x] = v[y];
+			}
+		}
+	}
+
+	return( I );
+}
+
+//---------------------------------------------------------
+static CSG_Vector	Ref_Solve		(const CSG_Matrix &A, const CSG_Vector &b)
+{
+	CSG_Matrix LU(A); CSG_Vector x(b);
+
+	SG_Matrix_Solve(LU, x);
+
+	return( x );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static int	g_nRepetitions	= 3;
+
+#define BENCHMARK(Seconds, Statement)	{ Seconds = -1.; for(int iRun=0; iRun<g_nRepetitions; iRun++) {\
+	std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now(); Statement;\
+	double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();\
+	if( Seconds < 0. || s < Seconds ) { Seconds = s; } } }
+
+//---------------------------------------------------------
+static void	Report	(const char *Name, int n, double Reference, double Current, double Difference)
+{
+	if( Reference > 0. )
+	{
+		printf("%-10s %6d %12.4f %12.4f %8.2f %12.3e\n", Name, n, Reference, Current, Current > 0. ? Reference / Current : 0., Difference);
+	}
+	else	// no reference, difference is a residual
+	{
+		printf("%-10s %6d %12s %12.4f %8s %12.3e\n", Name, n, "-", Current, "-", Difference);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static void	Benchmark	(int n)
+{
+	double tRef, tCur;
+
+	//-----------------------------------------------------
+	{
+		CSG_Matrix A(Get_Random(n)), B(Get_Random(n)), R, C;
+
+		BENCHMARK(tRef, R = Ref_Multiply(A, B));
+		BENCHMARK(tCur, C = A.Multiply(B));
+
+		Report("multiply", n, tRef, tCur, Get_Difference(R, C));
+	}
+
+	//-----------------------------------------------------
+	{
+		CSG_Matrix A(Get_Random(n)), R, C;
+
+		for(int i=0; i<n; i++)	// keep it well conditioned
+		{
+			A[i][i] += n;
+		}
+
+		BENCHMARK(tRef, R = Ref_Inverse(A));
+		BENCHMARK(tCur, C = A.Get_Inverse());
+
+		Report("inverse", n, tRef, tCur, Get_Difference(R, C));
+	}
+
+	//-----------------------------------------------------
+	{
+		CSG_Matrix A(Get_Symmetric(n)), L; CSG_Vector b(n), R, C;
+
+		for(int i=0; i<n; i++)
+		{
+			b[i] = CSG_Random::Get_Uniform(-1., 1.);
+		}
+
+		BENCHMARK(tRef, R = Ref_Solve(A, b));
+		BENCHMARK(tCur, L = A; C = b; SG_Matrix_Cholesky_Decomposition(n, L.Get_Data()); SG_Matrix_Cholesky_Solve(n, L, C.Get_Data()));
+
+		double d = 0.; for(int i=0; i<n; i++) { d = M_GET_MAX(d, fabs(R[i] - C[i])); }
+
+		Report("cholesky", n, tRef, tCur, d);
+	}
+
+	//-----------------------------------------------------
+	{
+		CSG_Matrix A(Get_Symmetric(n)), E; CSG_Vector v;
+
+		BENCHMARK(tCur, SG_Matrix_Eigen_Reduction(A, E, v));
+
+		CSG_Matrix AE(A.Multiply(E));	// residual of A * E = E * diag(v)
+
+		double d = 0.; for(int y=0; y<n; y++) for(int x=0; x<n; x++) { d = M_GET_MAX(d, fabs(AE[y][x] - E[y][x] * v[x])); }
+
+		Report("eigen", n, 0., tCur, d);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int		main	(int argc, char *argv[])
+{
+	CSG_Array_Int Sizes;
+
+	for(int i=1; i<argc; i++)
+	{
+		if( !strcmp(argv[i], "-r") && i + 1 < argc )
+		{
+			g_nRepetitions = atoi(argv[++i]); if( g_nRepetitions < 1 ) { g_nRepetitions = 1; }
+		}
+		else if( !strcmp(argv[i], "-t") && i + 1 < argc )
+		{
+			SG_OMP_Set_Max_Num_Threads(atoi(argv[++i]));
+		}
+		else if( atoi(argv[i]) > 0 )
+		{
+			Sizes += atoi(argv[i]);
+		}
+		else
+		{
+			printf("usage: %s [size ...] [-r repetitions] [-t threads]\n", argv[0]);
+
+			return( 1 );
+		}
+	}
+
+	if( Sizes.Get_Size() < 1 )
+	{
+		Sizes += 100; Sizes += 250; Sizes += 500;
+	}
+
+	//-----------------------------------------------------
+	CSG_Random::Initialize(1234);
+
+	printf("threads: %d, repetitions: %d (best time in seconds)\n\n", SG_OMP_Get_Max_Num_Threads(), g_nRepetitions);
+	printf("%-10s %6s %12s %12s %8s %12s\n", "kernel", "n", "reference", "current", "speedup", "max.diff.");
+
+	for(sLong i=0; i<Sizes.Get_Size(); i++)
+	{
+		Benchmark(Sizes[i]);
+	}
+
+	return( 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -311,14 +311,24 @@ CSG_Data_Object * CSG_Data_Manager::Add(CSG_Data_Object *pObject)
 {
 	if( pObject != DATAOBJECT_NOTSET && pObject != DATAOBJECT_CREATE )
 	{
-		if( Exists(pObject) )
+		bool bExists = false, bAdded = false;
+
+		#pragma omp critical(SG_Data_Manager)	// tools of a tool chain might be executed concurrently
 		{
-			return( pObject ); // don't add more than once
+			if( (bExists = Exists(pObject)) == false )	// don't add more than once
+			{
+				CSG_Data_Collection *pCollection = _Get_Collection(pObject);
+
+				bAdded = pCollection && pCollection->Add(pObject);
+			}
 		}
 
-		CSG_Data_Collection *pCollection = _Get_Collection(pObject);
+		if( bExists )
+		{
+			return( pObject );
+		}
 
-		if( pCollection && pCollection->Add(pObject) )
+		if( bAdded )
 		{
 			if( this == &g_Data_Manager ) // SAGA API's global data manager ?
 			{
@@ -622,9 +632,16 @@ CSG_Grids * CSG_Data_Manager::Add_Grids(void)
 //---------------------------------------------------------
 bool CSG_Data_Manager::Delete(CSG_Data_Object *pObject, bool bDetach)
 {
-	CSG_Data_Collection *pCollection = _Get_Collection(pObject);
+	bool bDeleted = false;
+
+	#pragma omp critical(SG_Data_Manager)
+	{
+		CSG_Data_Collection *pCollection = _Get_Collection(pObject);
+
+		bDeleted = pCollection && pCollection->Delete(pObject, bDetach);
+	}
 
-	return( pCollection && pCollection->Delete(pObject, bDetach) );
+	return( bDeleted );
 }
 
 //---------------------------------------------------------
@@ -48,9 +48,15 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <limits.h>
+
 #include "grid.h"
 #include "data_manager.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -211,7 +217,12 @@ void CSG_Grid::_On_Construction(void)
 
 	m_Values       = NULL;
 
+	m_Memory_Map   = NULL;
+	m_Memory_Map_Size = 0;
+
 	m_Cache_Stream = NULL;
+	m_Cache_Buffer = NULL;
+	m_Cache_Source = NULL;
 	m_Cache_Offset = 0;
 	m_Cache_bSwap  = false;
 	m_Cache_bFlip  = false;
@@ -221,6 +232,9 @@ void CSG_Grid::_On_Construction(void)
 
 	m_Index        = NULL;
 
+	m_Statistics_Counts  = NULL;
+	m_Statistics_Changes = -1;
+
 	m_pOwner       = NULL;
 
 	Set_Update_Flag();
@@ -442,7 +456,7 @@ bool CSG_Grid::is_Valid(void) const
 {
 	if(	m_System.is_Valid() && m_Type != SG_DATATYPE_Undefined )
 	{
-		return( m_Values != NULL || is_Cached() );
+		return( m_Values != NULL || is_Buffered() );
 	}
 
 	return( false );
@@ -953,6 +967,59 @@ inline bool CSG_Grid::_Get_ValAtPos_Fill4x4Submatrix(int x, int y, double v_xy[4
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// 8 and 16 bit integer grids count the occurrence of each
+// raw value while collecting the statistics. The histogram
+// can then be derived from the counts without another pass
+// and single cell changes can be tracked incrementally.
+
+//---------------------------------------------------------
+inline size_t	SG_Grid_Counts_Size		(TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Byte : case SG_DATATYPE_Char : return( 0x100   );
+	case SG_DATATYPE_Word : case SG_DATATYPE_Short: return( 0x10000 );
+	default                                       : return( 0       );
+	}
+}
+
+//---------------------------------------------------------
+inline int		SG_Grid_Counts_Offset	(TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Char : return( -CHAR_MIN );	// char is unsigned on some platforms (e.g. ARM), counts range from 0 to 0xFF then
+	case SG_DATATYPE_Short: return( 0x8000 );
+	default               : return( 0      );
+	}
+}
+
+//---------------------------------------------------------
+template <typename TValue>
+void	SG_Grid_Row_Count		(const TValue *pRow, int nx, int Offset, sLong *Counts)
+{
+	for(int x=0; x<nx; x++)
+	{
+		Counts[(int)pRow[x] + Offset]++;
+	}
+}
+
+//---------------------------------------------------------
+template <typename TValue>
+void	SG_Grid_Row_Statistics	(const TValue *pRow, int nx, double NoData_Lo, double NoData_Hi, double Offset, double Scaling, CSG_Simple_Statistics &Statistics)
+{
+	for(int x=0; x<nx; x++)
+	{
+		double	z	= (double)pRow[x];
+
+		if( !SG_is_NaN(z) && (z < NoData_Lo || NoData_Hi < z) )
+		{
+			Statistics	+= Scaling ? Offset + Scaling * z : z;
+		}
+	}
+}
+
 //---------------------------------------------------------
 bool CSG_Grid::On_Update(void)
 {
@@ -962,10 +1029,13 @@ bool CSG_Grid::On_Update(void)
 	}
 
 	SG_FREE_SAFE(m_Index);
+	SG_FREE_SAFE(m_Statistics_Counts);
 
 	m_Statistics.Invalidate();
 	m_Histogram.Destroy();
 
+	m_Statistics_Changes	= -1;
+
 	double	Offset = Get_Offset(), Scaling = is_Scaled() ? Get_Scaling() : 0.;
 
 	if( Get_Max_Samples() > 0 && Get_Max_Samples() < Get_NCells() )
@@ -985,23 +1055,214 @@ bool CSG_Grid::On_Update(void)
 		m_Statistics.Set_Count(m_Statistics.Get_Count() >= Get_Max_Samples() ? Get_NCells()	// any no-data cells ?
 			: (sLong)(Get_NCells() * (double)m_Statistics.Get_Count() / (double)Get_Max_Samples())
 		);
+
+		return( true );	// sampled statistics are not tracked incrementally
 	}
+
+	//-----------------------------------------------------
+	// rows are distributed over threads, each collecting its
+	// own counts or statistics, which are merged at the end
+
+	int		nThreads	= SG_OMP_Get_Max_Num_Threads(), nBand = 64 * nThreads;	// rows per band, progress is reported in between
+
+	size_t	nCounts		= SG_Grid_Counts_Size(m_Type);
+
+	sLong	*Counts		= nCounts > 0 && Get_NCells() >= 4 * (sLong)nCounts	// not for grids smaller than the counts array
+		? (sLong *)SG_Calloc(nThreads * nCounts, sizeof(sLong)) : NULL;
+
+	if( Counts )
+	{
+		int	Counts_Offset	= SG_Grid_Counts_Offset(m_Type);
+
+		for(int yBand=0; yBand<Get_NY() && SG_UI_Process_Set_Progress(yBand, Get_NY()); yBand+=nBand)
+		{
+			int	yEnd	= M_GET_MIN(yBand + nBand, Get_NY());
+
+			#pragma omp parallel for
+			for(int y=yBand; y<yEnd; y++)
+			{
+				sLong	*pCounts	= Counts + nCounts * SG_OMP_Get_Thread_Num();
+
+				const void	*pRow	= Get_Row_Data(y);
+
+				switch( pRow ? m_Type : SG_DATATYPE_Undefined )
+				{
+				case SG_DATATYPE_Byte : SG_Grid_Row_Count((const BYTE  *)pRow, Get_NX(), Counts_Offset, pCounts); break;
+				case SG_DATATYPE_Char : SG_Grid_Row_Count((const char  *)pRow, Get_NX(), Counts_Offset, pCounts); break;
+				case SG_DATATYPE_Word : SG_Grid_Row_Count((const WORD  *)pRow, Get_NX(), Counts_Offset, pCounts); break;
+				case SG_DATATYPE_Short: SG_Grid_Row_Count((const short *)pRow, Get_NX(), Counts_Offset, pCounts); break;
+
+				default:	// cached
+					for(int x=0; x<Get_NX(); x++)
+					{
+						pCounts[(int)asDouble(x, y, false) + Counts_Offset]++;
+					}
+					break;
+				}
+			}
+		}
+
+		SG_UI_Process_Set_Ready();
+
+		for(int i=1; i<nThreads; i++)
+		{
+			for(size_t j=0; j<nCounts; j++)
+			{
+				Counts[j]	+= Counts[i * nCounts + j];
+			}
+		}
+
+		m_Statistics_Counts	= (sLong *)SG_Realloc(Counts, nCounts * sizeof(sLong));
+
+		_Statistics_from_Counts();
+	}
+
+	//-----------------------------------------------------
 	else
 	{
-		for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+		CSG_Simple_Statistics	*Statistics	= new CSG_Simple_Statistics[nThreads];
+
+		double	NoData_Lo	= Get_NoData_Value(), NoData_Hi = M_GET_MAX(NoData_Lo, Get_NoData_Value(true));
+
+		for(int yBand=0; yBand<Get_NY() && SG_UI_Process_Set_Progress(yBand, Get_NY()); yBand+=nBand)
 		{
-			for(int x=0; x<Get_NX(); x++)
+			int	yEnd	= M_GET_MIN(yBand + nBand, Get_NY());
+
+			#pragma omp parallel for
+			for(int y=yBand; y<yEnd; y++)
 			{
-				double	Value	= asDouble(x, y, false);
+				CSG_Simple_Statistics	&s	= Statistics[SG_OMP_Get_Thread_Num()];
 
-				if( !is_NoData_Value(Value) )
+				const void	*pRow	= Get_Row_Data(y);
+
+				switch( pRow ? m_Type : SG_DATATYPE_Undefined )
 				{
-					m_Statistics	+= Scaling ? Offset + Scaling * Value : Value;
+				case SG_DATATYPE_Byte  : SG_Grid_Row_Statistics((const BYTE   *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Char  : SG_Grid_Row_Statistics((const char   *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Word  : SG_Grid_Row_Statistics((const WORD   *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Short : SG_Grid_Row_Statistics((const short  *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_DWord : SG_Grid_Row_Statistics((const DWORD  *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Int   : SG_Grid_Row_Statistics((const int    *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_ULong : SG_Grid_Row_Statistics((const uLong  *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Long  : SG_Grid_Row_Statistics((const sLong  *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Float : SG_Grid_Row_Statistics((const float  *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+				case SG_DATATYPE_Double: SG_Grid_Row_Statistics((const double *)pRow, Get_NX(), NoData_Lo, NoData_Hi, Offset, Scaling, s); break;
+
+				default:	// cached or bit
+					for(int x=0; x<Get_NX(); x++)
+					{
+						double	Value	= asDouble(x, y, false);
+
+						if( !is_NoData_Value(Value) )
+						{
+							s	+= Scaling ? Offset + Scaling * Value : Value;
+						}
+					}
+					break;
 				}
 			}
 		}
 
 		SG_UI_Process_Set_Ready();
+
+		for(int i=0; i<nThreads; i++)
+		{
+			m_Statistics	+= Statistics[i];
+		}
+
+		delete[](Statistics);
+	}
+
+	m_Statistics_Changes	= 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Valid statistics are updated incrementally with single
+  * cell changes, as long as these are few compared to the
+  * number of cells and are not made from parallel threads.
+*/
+bool CSG_Grid::_Statistics_Track(void)	const
+{
+	#ifdef _OPENMP
+	if( omp_in_parallel() )
+	{
+		return( false );
+	}
+	#endif
+
+	return( m_Statistics_Changes >= 0 && m_Statistics_Changes < 1 + Get_NCells() / 10 );
+}
+
+//---------------------------------------------------------
+/**
+  * Replaces the raw value Previous by Value in the statistics.
+  * Returns false if the statistics need a full update, e.g.
+  * because the minimum or maximum value has been replaced.
+*/
+bool CSG_Grid::_Statistics_Update(double Previous, double Value)
+{
+	SG_FREE_SAFE(m_Index);
+
+	if( m_Histogram.Get_Class_Count() > 0 )
+	{
+		m_Histogram.Destroy();
+	}
+
+	m_Statistics_Changes++;
+
+	if( m_Statistics_Counts )
+	{
+		int	Counts_Offset	= SG_Grid_Counts_Offset(m_Type);
+
+		m_Statistics_Counts[(int)Previous + Counts_Offset]--;
+		m_Statistics_Counts[(int)Value    + Counts_Offset]++;
+	}
+
+	double	Offset = Get_Offset(), Scaling = is_Scaled() ? Get_Scaling() : 0.;
+
+	bool	bResult	= is_NoData_Value(Previous) || m_Statistics.Del_Value(Scaling ? Offset + Scaling * Previous : Previous);
+
+	if( bResult && !is_NoData_Value(Value) )
+	{
+		m_Statistics	+= Scaling ? Offset + Scaling * Value : Value;
+	}
+
+	if( !bResult && !_Statistics_from_Counts() )
+	{
+		m_Statistics_Changes	= -1;
+
+		return( false );
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Statistics_from_Counts(void)
+{
+	if( !m_Statistics_Counts )
+	{
+		return( false );
+	}
+
+	m_Statistics.Invalidate();
+
+	size_t	nCounts		= SG_Grid_Counts_Size  (m_Type);
+	int		Counts_Offset	= SG_Grid_Counts_Offset(m_Type);
+
+	double	Offset = Get_Offset(), Scaling = is_Scaled() ? Get_Scaling() : 0.;
+
+	for(size_t i=0; i<nCounts; i++)
+	{
+		double	Value	= (double)((int)i - Counts_Offset);
+
+		if( m_Statistics_Counts[i] > 0 && !is_NoData_Value(Value) )
+		{
+			m_Statistics.Add_Values(Scaling ? Offset + Scaling * Value : Value, m_Statistics_Counts[i]);
+		}
 	}
 
 	return( true );
@@ -1177,7 +1438,34 @@ const CSG_Histogram & CSG_Grid::Get_Histogram(size_t nClasses)
 
 	if( m_Histogram.Get_Statistics().Get_Count() < 1 )
 	{
-		m_Histogram.Create(nClasses > 1 ? nClasses : SG_GRID_HISTOGRAM_CLASSES_DEFAULT, Get_Min(), Get_Max(), this, (size_t)Get_Max_Samples());
+		nClasses	= nClasses > 1 ? nClasses : SG_GRID_HISTOGRAM_CLASSES_DEFAULT;
+
+		if( m_Statistics_Counts )	// no need to pass through the data again
+		{
+			if( m_Histogram.Create(nClasses, Get_Min(), Get_Max()) )
+			{
+				size_t	nCounts		= SG_Grid_Counts_Size  (m_Type);
+				int		Counts_Offset	= SG_Grid_Counts_Offset(m_Type);
+
+				double	Offset = Get_Offset(), Scaling = is_Scaled() ? Get_Scaling() : 0.;
+
+				for(size_t i=0; i<nCounts; i++)
+				{
+					double	Value	= (double)((int)i - Counts_Offset);
+
+					if( m_Statistics_Counts[i] > 0 && !is_NoData_Value(Value) )
+					{
+						m_Histogram.Add_Value(Scaling ? Offset + Scaling * Value : Value, (size_t)m_Statistics_Counts[i]);
+					}
+				}
+
+				m_Histogram.Update();
+			}
+		}
+		else
+		{
+			m_Histogram.Create(nClasses, Get_Min(), Get_Max(), this, (size_t)Get_Max_Samples());
+		}
 	}
 
 	return( m_Histogram );
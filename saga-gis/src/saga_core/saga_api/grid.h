@@ -460,6 +460,37 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					CSG_Grid_Source						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Source is the interface for external storage, from
+  * which a grid reads its values block-wise on first access
+  * instead of holding them in memory, e.g. a raster data set
+  * kept open by an import library. See CSG_Grid::Set_Source().
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Source
+{
+public:
+	virtual ~CSG_Grid_Source(void)	{}
+
+	/** Preferred number of rows per request, e.g. the height of the source's native blocks. */
+	virtual int					Get_Block_Rows		(void)	const	{	return( 1 );	}
+
+	/** Reads nRows rows starting with row yFirst in source order into Buffer, as raw values of the grid's data type. */
+	virtual bool				Read_Rows			(int yFirst, int nRows, void *Buffer)	= 0;
+
+	/** Optionally fills pGrid, which has a coarser resolution, with values resampled by the source itself, e.g. from overviews. */
+	virtual bool				Read_Resampled		(class CSG_Grid *pGrid, TSG_Grid_Resampling Resampling)	{	return( false );	}
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						CSG_Grid						 //
@@ -605,6 +636,33 @@ public:		///////////////////////////////////////////////
 
 	bool							Set_Cache				(bool bOn);
 	bool							is_Cached				(void)		const	{	return( m_Cache_Stream != NULL );	}
+	/** Returns true, if values are accessed through a block buffer instead of being held in memory as a whole, i.e. if the grid is file cached, compressed or reads from a source. */
+	bool							is_Buffered				(void)		const	{	return( m_Cache_Buffer != NULL );	}
+
+	/** Keeps blocks of rows run length compressed in memory, decompressing only a few recently used blocks at a time. Suited for categorical grids and masks with large constant or no-data areas. */
+	bool							Set_Compression			(bool bOn);
+	bool							is_Compressed			(void)		const	{	return( m_Cache_Buffer != NULL && m_Cache_Stream == NULL && m_Cache_Source == NULL );	}
+	sLong							Get_Memory_Size_Compressed	(void)	const;
+	bool							is_Mapped				(void)		const	{	return( m_Memory_Map   != NULL );	}
+
+	/** Drops the grid's values and reads them on demand from pSource, which is then owned by the grid. Set bFlip, if the source's first row is the grid's top row. Changed blocks are kept compressed in memory, the source itself is never written. Passing NULL reads all values into memory and deletes the current source. */
+	bool							Set_Source				(CSG_Grid_Source *pSource, bool bFlip = true);
+	bool							has_Source				(void)		const	{	return( m_Cache_Source != NULL );	}
+	CSG_Grid_Source *				Get_Source				(void)		const	{	return( m_Cache_Source );	}
+
+
+	//-----------------------------------------------------
+	// Direct Access...
+
+	/** Returns a pointer to the raw (i.e. unscaled) values of row y, or NULL if the values are not held in memory, e.g. when the grid is file cached. Values written through this pointer bypass Set_Value(), so call Set_Modified() when done. */
+	void *							Get_Row_Data			(int y)				{	return( m_Values && y >= 0 && y < Get_NY() ? m_Values[y] : NULL );	}
+	const void *					Get_Row_Data			(int y)		const	{	return( m_Values && y >= 0 && y < Get_NY() ? m_Values[y] : NULL );	}
+
+#ifndef SWIG
+	/** Typed version of Get_Row_Data(). Returns NULL also if TValue does not match the grid's data type, so that kernels can be instantiated per data type and fall back to asDouble()/Set_Value() otherwise. */
+	template <typename TValue> TValue *			Get_Row_Ptr	(int y)			{	return( m_Type == SG_Data_Type_Get_Type<TValue>() ? (      TValue *)Get_Row_Data(y) : NULL );	}
+	template <typename TValue> const TValue *	Get_Row_Ptr	(int y)	const	{	return( m_Type == SG_Data_Type_Get_Type<TValue>() ? (const TValue *)Get_Row_Data(y) : NULL );	}
+#endif	// #ifndef SWIG
 
 
 	//-----------------------------------------------------
@@ -642,6 +700,8 @@ public:		///////////////////////////////////////////////
 		if( bModified )
 		{
 			Set_Update_Flag();
+
+			m_Statistics_Changes	= -1;	// statistics are not tracked until the next full update
 		}
 	}
 
@@ -773,7 +833,7 @@ public:		///////////////////////////////////////////////
 	{
 		double	Value;
 
-		if( is_Cached() )
+		if( is_Buffered() )
 		{
 			Value	= _Cache_Get_Value(x, y);
 		}
@@ -826,7 +886,11 @@ public:		///////////////////////////////////////////////
 			Value	= (Value - m_zOffset) / m_zScale;
 		}
 
-		if( is_Cached() )
+		bool	bTrack	= m_Statistics_Changes >= 0 && !Get_Update_Flag() && _Statistics_Track();	// valid statistics are updated incrementally
+
+		double	Previous	= bTrack ? asDouble(x, y, false) : 0.;
+
+		if( is_Buffered() )
 		{
 			_Cache_Set_Value(x, y, Value);
 		}
@@ -851,7 +915,14 @@ public:		///////////////////////////////////////////////
 				return;
 		}
 
-		Set_Modified();
+		if( bTrack && _Statistics_Update(Previous, asDouble(x, y, false)) )
+		{
+			CSG_Data_Object::Set_Modified();
+		}
+		else
+		{
+			Set_Modified();
+		}
 	}
 
 	//-----------------------------------------------------
@@ -870,13 +941,17 @@ protected:	///////////////////////////////////////////////
 //---------------------------------------------------------
 private:	///////////////////////////////////////////////
 
-	void						**m_Values;
+	void						**m_Values, *m_Memory_Map;
 
 	bool						m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip;
 
-	size_t						m_nBytes_Value, m_nBytes_Line;
+	struct SSG_Grid_Cache		*m_Cache_Buffer;
+
+	CSG_Grid_Source				*m_Cache_Source;
 
-	sLong						*m_Index, m_Cache_Offset;
+	size_t						m_nBytes_Value, m_nBytes_Line, m_Memory_Map_Size;
+
+	sLong						*m_Index, m_Cache_Offset, *m_Statistics_Counts, m_Statistics_Changes;
 
 	double						m_zOffset, m_zScale;
 
@@ -912,6 +987,14 @@ private:	///////////////////////////////////////////////
 	}
 
 
+	//-----------------------------------------------------
+	// Statistics...
+
+	bool						_Statistics_Track		(void)	const;
+	bool						_Statistics_Update		(double Previous, double Value);
+	bool						_Statistics_from_Counts	(void);
+
+
 	//-----------------------------------------------------
 	// Memory handling...
 
@@ -921,12 +1004,23 @@ private:	///////////////////////////////////////////////
 	bool						_Array_Create			(void);
 	void						_Array_Destroy			(void);
 
+	bool						_Memory_Map_Create		(const CSG_String &File, sLong Offset);
+	bool						_Memory_Map_Detach		(void);
+
 	bool						_Cache_Check			(void);
 	bool						_Cache_Create			(const CSG_String &File, TSG_Data_Type Data_Type, sLong Offset, bool bSwap, bool bFlip);
 	bool						_Cache_Create			(void);
+	bool						_Cache_Buffer_Create	(bool bCompressed = false);
+	bool						_Compression_Check		(void);
+	bool						_Compression_Create		(void);
 	bool						_Cache_Destroy			(bool bMemory_Restore);
+	bool						_Cache_Flush			(void)	const;
+	char *						_Cache_Get_Line			(int y, bool bModify)	const;
+	bool						_Cache_Load_Block		(int iBlock)	const;
+	bool						_Cache_Save_Block		(int iBlock)	const;
 	void						_Cache_Set_Value		(int x, int y, double Value);
 	double						_Cache_Get_Value		(int x, int y)	const;
+	bool						_Source_Get_Resampled	(CSG_Grid *pGrid, TSG_Grid_Resampling Resampling)	const;
 
 
 	//-----------------------------------------------------
@@ -1026,6 +1120,25 @@ SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Threshold_MB	(double nMegabytes);
 SAGA_API_DLL_EXPORT sLong			SG_Grid_Cache_Get_Threshold		(void);
 SAGA_API_DLL_EXPORT double			SG_Grid_Cache_Get_Threshold_MB	(void);
 
+/** Set the maximum memory, that each file cached grid uses to buffer blocks of rows */
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Buffer		(sLong nBytes);
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Buffer_MB		(double nMegabytes);
+SAGA_API_DLL_EXPORT sLong			SG_Grid_Cache_Get_Buffer		(void);
+SAGA_API_DLL_EXPORT double			SG_Grid_Cache_Get_Buffer_MB		(void);
+
+/** If enabled, uncompressed native grid files with native byte order are mapped to memory (copy-on-write) instead of being read. Off by default. Unsafe for files that might be truncated or rewritten by other processes while mapped, which lets the grid silently change its values or crashes the program. */
+SAGA_API_DLL_EXPORT void			SG_Grid_Set_Memory_Mapping		(bool bOn);
+SAGA_API_DLL_EXPORT bool			SG_Grid_Get_Memory_Mapping		(void);
+
+/** New grids larger than this size are compressed in memory. Zero (default) switches automatic compression off. */
+SAGA_API_DLL_EXPORT void			SG_Grid_Compression_Set_Threshold		(sLong nBytes);
+SAGA_API_DLL_EXPORT void			SG_Grid_Compression_Set_Threshold_MB	(double nMegabytes);
+SAGA_API_DLL_EXPORT sLong			SG_Grid_Compression_Get_Threshold		(void);
+SAGA_API_DLL_EXPORT double			SG_Grid_Compression_Get_Threshold_MB	(void);
+
+/** Returns the number of grids reading from a source accepted by is_Owned (or from any source, if is_Owned is NULL). A library providing grid sources lets its TLB_Finalize() return false as long as this is not zero, so that it is kept loaded for its sources' code. */
+SAGA_API_DLL_EXPORT int				SG_Grid_Get_Source_Count				(bool (* is_Owned)(const CSG_Grid_Source *pSource));
+
 //---------------------------------------------------------
 SAGA_API_DLL_EXPORT bool					SG_Grid_Set_File_Format_Default		(int Format);
 SAGA_API_DLL_EXPORT TSG_Grid_File_Format	SG_Grid_Get_File_Format_Default		(void);
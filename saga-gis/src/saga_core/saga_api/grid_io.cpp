@@ -254,7 +254,7 @@ bool CSG_Grid::_Load_External(const CSG_String &FileName, bool bCached, bool bLo
 	{
 		CSG_Grid *pGrid = Manager.Grid(0).asGrid();
 
-		if( pGrid->is_Cached() )
+		if( pGrid->is_Buffered() || pGrid->is_Mapped() )
 		{
 			return( Create(*pGrid) );
 		}
@@ -400,6 +400,18 @@ bool CSG_Grid::_Load_Native(const CSG_String &FileName, bool bCached, bool bLoad
 		m_Cache_bSwap	= Info.m_bSwapBytes;
 		m_Cache_bFlip	= Info.m_bFlip;
 
+		if( !bCached && !Info.m_bFlip && !Info.m_bSwapBytes )	// native layout, data can be mapped instead of being read
+		{
+			if( _Memory_Map_Create(Info.m_Data_File                       , Info.m_Offset)
+			||	_Memory_Map_Create(SG_File_Make_Path("", FileName,  "dat"), Info.m_Offset)
+			||	_Memory_Map_Create(SG_File_Make_Path("", FileName, "sdat"), Info.m_Offset) )
+			{
+				Set_File_Type(GRID_FILE_FORMAT_Binary);
+
+				return( true );
+			}
+		}
+
 		if( _Memory_Create(bCached) )
 		{
 			if(	Stream.Open(Info.m_Data_File                       , SG_FILE_R, true)
@@ -442,6 +454,11 @@ bool CSG_Grid::_Save_Native(const CSG_String &_FileName, TSG_Grid_File_Format Fo
 		bBinary	= true;	SG_File_Set_Extension(FileName, "sg-grd");
 	}
 
+	if( is_Mapped() && SG_File_Cmp_Path(m_Cache_File, SG_File_Make_Path("", FileName, "sdat")) && !_Memory_Map_Detach() )
+	{
+		return( false );	// the mapped file is going to be overwritten, so we need our own copy of the data
+	}
+
 	CSG_Grid_File_Info	Info(*this);
 
 	if(	Info.Save(FileName, bBinary) )
@@ -627,7 +644,7 @@ bool CSG_Grid::_Load_Binary(CSG_File &Stream, TSG_Data_Type File_Type, bool bFli
 	{
 		int	nLineBytes	= Get_NX() / 8 + 1;
 
-		if( m_Type == File_Type && !is_Cached() )
+		if( m_Type == File_Type && !is_Buffered() )
 		{
 			for(int y=0; y<Get_NY() && !Stream.is_EOF() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 			{
@@ -661,7 +678,7 @@ bool CSG_Grid::_Load_Binary(CSG_File &Stream, TSG_Data_Type File_Type, bool bFli
 		int	nValueBytes	= (int)SG_Data_Type_Get_Size(File_Type);
 		int	nLineBytes	= Get_NX() * nValueBytes;
 
-		if( m_Type == File_Type && !is_Cached() && !bSwapBytes )
+		if( m_Type == File_Type && !is_Buffered() && !bSwapBytes )
 		{
 			for(int y=0; y<Get_NY() && !Stream.is_EOF() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 			{
@@ -722,7 +739,7 @@ bool CSG_Grid::_Save_Binary(CSG_File &Stream, TSG_Data_Type File_Type, bool bFli
 	{
 		int	nLineBytes	= Get_NX() / 8 + 1;
 
-		if( m_Type == File_Type && !is_Cached() )
+		if( m_Type == File_Type && !is_Buffered() )
 		{
 			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 			{
@@ -756,7 +773,7 @@ bool CSG_Grid::_Save_Binary(CSG_File &Stream, TSG_Data_Type File_Type, bool bFli
 		int	nValueBytes	= (int)SG_Data_Type_Get_Size(File_Type);
 		int	nLineBytes	= Get_NX() * nValueBytes;
 
-		if( m_Type == File_Type && !is_Cached() && !bSwapBytes )
+		if( m_Type == File_Type && !is_Buffered() && !bSwapBytes )
 		{
 			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 			{
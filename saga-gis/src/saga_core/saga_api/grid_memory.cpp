@@ -63,10 +63,24 @@
 
 //---------------------------------------------------------
 #include <memory.h>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "grid.h"
 #include "parameters.h"
 
+#if defined(_SAGA_MSW)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -148,6 +162,151 @@ double				SG_Grid_Cache_Get_Threshold_MB(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static sLong		gSG_Grid_Cache_Buffer	= 256 * N_MEGABYTE_BYTES;
+
+//---------------------------------------------------------
+void				SG_Grid_Cache_Set_Buffer(sLong nBytes)
+{
+	if( nBytes >= 0 )
+	{
+		gSG_Grid_Cache_Buffer	= nBytes;
+	}
+}
+
+//---------------------------------------------------------
+void				SG_Grid_Cache_Set_Buffer_MB(double nMegabytes)
+{
+	SG_Grid_Cache_Set_Buffer((sLong)(nMegabytes * N_MEGABYTE_BYTES));
+}
+
+//---------------------------------------------------------
+sLong				SG_Grid_Cache_Get_Buffer(void)
+{
+	return( gSG_Grid_Cache_Buffer );
+}
+
+//---------------------------------------------------------
+double				SG_Grid_Cache_Get_Buffer_MB(void)
+{
+	return( (double)gSG_Grid_Cache_Buffer / (double)N_MEGABYTE_BYTES );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static bool			gSG_Grid_Memory_Mapping	= false;
+
+//---------------------------------------------------------
+void				SG_Grid_Set_Memory_Mapping(bool bOn)
+{
+	gSG_Grid_Memory_Mapping	= bOn;
+}
+
+//---------------------------------------------------------
+bool				SG_Grid_Get_Memory_Mapping(void)
+{
+	return( gSG_Grid_Memory_Mapping );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static sLong		gSG_Grid_Compression_Threshold	= 0;
+
+//---------------------------------------------------------
+void				SG_Grid_Compression_Set_Threshold(sLong nBytes)
+{
+	if( nBytes >= 0 )
+	{
+		gSG_Grid_Compression_Threshold	= nBytes;
+	}
+}
+
+//---------------------------------------------------------
+void				SG_Grid_Compression_Set_Threshold_MB(double nMegabytes)
+{
+	SG_Grid_Compression_Set_Threshold((sLong)(nMegabytes * N_MEGABYTE_BYTES));
+}
+
+//---------------------------------------------------------
+sLong				SG_Grid_Compression_Get_Threshold(void)
+{
+	return( gSG_Grid_Compression_Threshold );
+}
+
+//---------------------------------------------------------
+double				SG_Grid_Compression_Get_Threshold_MB(void)
+{
+	return( (double)gSG_Grid_Compression_Threshold / (double)N_MEGABYTE_BYTES );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Sources							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static std::vector<CSG_Grid *>	gSG_Grid_Sources;	// grids reading from a source, see CSG_Grid::Set_Source()
+
+//---------------------------------------------------------
+static void			SG_Grid_Sources_Add(CSG_Grid *pGrid)
+{
+	#pragma omp critical(SG_Grid_Sources)
+	{
+		gSG_Grid_Sources.push_back(pGrid);
+	}
+}
+
+//---------------------------------------------------------
+static void			SG_Grid_Sources_Del(CSG_Grid *pGrid)
+{
+	#pragma omp critical(SG_Grid_Sources)
+	{
+		for(size_t i=0; i<gSG_Grid_Sources.size(); i++)
+		{
+			if( gSG_Grid_Sources[i] == pGrid )
+			{
+				gSG_Grid_Sources.erase(gSG_Grid_Sources.begin() + i);
+
+				break;
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+int					SG_Grid_Get_Source_Count(bool (* is_Owned)(const CSG_Grid_Source *pSource))
+{
+	int n = 0;
+
+	#pragma omp critical(SG_Grid_Sources)
+	{
+		for(size_t i=0; i<gSG_Grid_Sources.size(); i++)
+		{
+			if( !is_Owned || is_Owned(gSG_Grid_Sources[i]->Get_Source()) )
+			{
+				n++;
+			}
+		}
+	}
+
+	return( n );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						Memory							 //
@@ -169,6 +328,11 @@ bool CSG_Grid::_Memory_Create(bool bCached)
 		return( _Cache_Create() );
 	}
 
+	if( _Compression_Check() )
+	{
+		return( _Compression_Create() );
+	}
+
 	return( _Array_Create() );
 }
 
@@ -176,8 +340,11 @@ bool CSG_Grid::_Memory_Create(bool bCached)
 void CSG_Grid::_Memory_Destroy(void)
 {
 	SG_FREE_SAFE(m_Index);
+	SG_FREE_SAFE(m_Statistics_Counts);
+
+	m_Statistics_Changes	= -1;
 
-	if( is_Cached() )
+	if( is_Buffered() )
 	{
 		_Cache_Destroy(false);
 	}
@@ -229,7 +396,22 @@ void CSG_Grid::_Array_Destroy(void)
 {
 	if( m_Values )
 	{
-		SG_Free(m_Values[0]);
+		if( m_Memory_Map )
+		{
+		#if defined(_SAGA_MSW)
+			UnmapViewOfFile(m_Memory_Map);
+		#else
+			munmap(m_Memory_Map, m_Memory_Map_Size);
+		#endif
+
+			m_Memory_Map		= NULL;
+			m_Memory_Map_Size	= 0;
+		}
+		else
+		{
+			SG_Free(m_Values[0]);
+		}
+
 		SG_Free(m_Values);
 
 		m_Values	= NULL;
@@ -239,244 +421,1088 @@ void CSG_Grid::_Array_Destroy(void)
 
 ///////////////////////////////////////////////////////////
 //														 //
-//						Cache							 //
+//					Memory Mapping						 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define CACHE_FILE_POS(x, y)	(m_Cache_Offset + (m_Cache_bFlip ? Get_NY() - 1 - y : y) * m_nBytes_Line + x * m_nBytes_Value)
-
-//---------------------------------------------------------
-#if defined(_SAGA_LINUX)
-#define CACHE_FILE_SEEK	fseek
-#else
-#define CACHE_FILE_SEEK	_fseeki64
-#endif
-
+/**
+* Maps the raw data of an uncompressed native grid file, which
+* must not be flipped and must be stored in the system's byte
+* order, directly to the rows of this grid. The mapping is
+* private (copy-on-write), i.e. changing values never touches
+* the file, while unchanged pages are shared with the system's
+* file cache and thus with all other processes using the file.
+* Unchanged pages still reflect the file, so the mapping is
+* unsafe for files that other processes might truncate (access
+* beyond the end crashes) or rewrite (values change silently).
+* Therefore it is only used if explicitly enabled.
+*/
 //---------------------------------------------------------
-bool CSG_Grid::Set_Cache(bool bOn)
+bool CSG_Grid::_Memory_Map_Create(const CSG_String &File, sLong Offset)
 {
-	if( bOn )
+	if( !SG_Grid_Get_Memory_Mapping() || !m_System.is_Valid() || m_Type == SG_DATATYPE_Undefined || !SG_File_Exists(File) )
 	{
-		return( is_Cached()
-			|| _Cache_Create(m_Cache_File                                  , m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
-			|| _Cache_Create(SG_File_Make_Path("", Get_File_Name(),  "dat"), m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
-			|| _Cache_Create(SG_File_Make_Path("", Get_File_Name(), "sdat"), m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
-			|| _Cache_Create()
-		);
+		return( false );
 	}
 
-	return( !is_Cached() || _Cache_Destroy(true) );
-}
+	_Memory_Destroy();
 
+	size_t	Size	= (size_t)Offset + (size_t)Get_NY() * Get_nLineBytes();
 
-///////////////////////////////////////////////////////////
-//														 //
-///////////////////////////////////////////////////////////
+	char	*pMap	= NULL;
 
-//---------------------------------------------------------
-bool CSG_Grid::_Cache_Check(void)
-{
-	sLong	nBytes	= m_System.Get_NCells() * Get_nValueBytes();
+	//-----------------------------------------------------
+#if defined(_SAGA_MSW)
+	HANDLE	hFile	= CreateFileW(File.w_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
 
-	if(	SG_Grid_Cache_Get_Mode() > 0 && nBytes > SG_Grid_Cache_Get_Threshold() )
+	if( hFile == INVALID_HANDLE_VALUE )
 	{
-		if( SG_Grid_Cache_Get_Mode() == 2 )	// confirm
-		{
-			CSG_String	s;
+		return( false );
+	}
 
-			s.Printf("%s\n%s\n%s: %.2fMB",
-				_TL("Shall I activate file caching for new grid."),
-				m_System.Get_Name(),
-				_TL("Total memory size"),
-				(double)nBytes / (double)N_MEGABYTE_BYTES
-			);
+	LARGE_INTEGER	FileSize;
 
-			return( SG_UI_Dlg_Continue(s, _TL("Activate Grid File Cache?")) );
-		}
+	if( GetFileSizeEx(hFile, &FileSize) && (size_t)FileSize.QuadPart >= Size )
+	{
+		HANDLE	hMap	= CreateFileMappingW(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
 
-		return( true );
-	}
+		if( hMap != NULL )
+		{
+			pMap	= (char *)MapViewOfFile(hMap, FILE_MAP_COPY, 0, 0, Size);
 
-	return( false );
-}
+			CloseHandle(hMap);	// the view keeps a reference to the mapping object
+		}
+	}
 
+	CloseHandle(hFile);
 
-///////////////////////////////////////////////////////////
-//														 //
-///////////////////////////////////////////////////////////
+	//-----------------------------------------------------
+#else
+	int		hFile	= open(File.b_str(), O_RDONLY);
 
-//---------------------------------------------------------
-bool CSG_Grid::_Cache_Create(const CSG_String &File, TSG_Data_Type Data_Type, sLong Offset, bool bSwap, bool bFlip)	// open existing file for caching
-{
-	if( !m_System.is_Valid() || m_Type != Data_Type || !SG_File_Exists(File) )
+	if( hFile < 0 )
 	{
 		return( false );
 	}
 
-	if( (m_Cache_Stream = fopen(File, "r+b")) == NULL	// read and write
-	&&  (m_Cache_Stream = fopen(File, "rb" )) == NULL )	// read only
-	{
-		return( false );
-	}
+	struct stat	FileStat;
 
-	m_Cache_File	= File;
-	m_Cache_bTemp	= false;
-	m_Cache_Offset	= Offset;
-	m_Cache_bSwap	= m_Type == SG_DATATYPE_Bit ? false : bSwap;
-	m_Cache_bFlip	= bFlip;
+	if( !fstat(hFile, &FileStat) && (size_t)FileStat.st_size >= Size )
+	{
+		void	*pData	= mmap(NULL, Size, PROT_READ|PROT_WRITE, MAP_PRIVATE, hFile, 0);
 
-	_Array_Destroy();
+		if( pData != MAP_FAILED )
+		{
+			pMap	= (char *)pData;
+		}
+	}
 
-	return( true );
-}
+	close(hFile);	// the mapping keeps a reference to the file
+#endif
 
-//---------------------------------------------------------
-bool CSG_Grid::_Cache_Create(void)	// create temporary cache file
-{
-	if( !m_System.is_Valid() || (m_Type == SG_DATATYPE_Undefined && is_Cached()) )
+	//-----------------------------------------------------
+	if( pMap == NULL )
 	{
 		return( false );
 	}
 
-	CSG_String	File	= SG_File_Get_Name_Temp("sg_grd", SG_Grid_Cache_Get_Directory());
-
-	if( (m_Cache_Stream = fopen(File, "w+b")) == NULL )	// read and write, create empty
+	if( (m_Values = (void **)SG_Malloc(Get_NY() * sizeof(void *))) == NULL )
 	{
+	#if defined(_SAGA_MSW)
+		UnmapViewOfFile(pMap);
+	#else
+		munmap(pMap, Size);
+	#endif
+
 		return( false );
 	}
 
-	m_Cache_File	= File;
-	m_Cache_bTemp	= true;
-	m_Cache_Offset	= 0;
-	m_Cache_bSwap	= false;
-	m_Cache_bFlip	= false;
+	m_Memory_Map		= pMap;
+	m_Memory_Map_Size	= Size;
+	m_Cache_File		= File;
 
-	CSG_Array	Values(1, m_Values ? 0 : Get_nLineBytes());	// dummy
+	char	*pLine	= pMap + Offset;
 
-	for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+	for(int y=0; y<Get_NY(); y++, pLine+=Get_nLineBytes())
 	{
-		fwrite(m_Values ? m_Values[y] : Values.Get_Array(), 1, Get_nLineBytes(), m_Cache_Stream);
+		m_Values[y]	= pLine;
 	}
 
-	SG_UI_Process_Set_Ready();
-
-	_Array_Destroy();
-
 	return( true );
 }
 
 //---------------------------------------------------------
-bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
+/**
+* Copies the values of a memory mapped grid to the heap and
+* releases the mapping. Needed e.g. before the mapped file
+* itself is going to be overwritten.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::_Memory_Map_Detach(void)
 {
-	if( is_Cached() )
+	if( !m_Memory_Map )
 	{
-		if( bMemory_Restore && _Array_Create() && !CACHE_FILE_SEEK(m_Cache_Stream, m_Cache_Offset, SEEK_SET) )
-		{
-			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
-			{
-				fread(m_Values[m_Cache_bFlip ? Get_NY() - 1 - y : y], 1, Get_nLineBytes(), m_Cache_Stream);
+		return( true );
+	}
 
-				if( m_Cache_bSwap )
-				{
-					char	*pValue	= (char *)m_Values[y];
+	char	*pValues	= (char *)SG_Malloc((size_t)Get_NY() * Get_nLineBytes());
 
-					for(int x=0; x<Get_NX(); x++, pValue+=Get_nValueBytes())
-					{
-						_Swap_Bytes(pValue, Get_nValueBytes());
-					}
-				}
-			}
+	if( pValues == NULL )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s [%.2fmb]", _TL("grid"), _TL("memory allocation failed"), (double)Get_NY() * Get_nLineBytes() / N_MEGABYTE_BYTES));
 
-			SG_UI_Process_Set_Ready();
-		}
+		return( false );
+	}
 
-		//-------------------------------------------------
-		fclose(m_Cache_Stream);
+	memcpy(pValues, m_Values[0], (size_t)Get_NY() * Get_nLineBytes());
 
-		m_Cache_Stream	= NULL;
+#if defined(_SAGA_MSW)
+	UnmapViewOfFile(m_Memory_Map);
+#else
+	munmap(m_Memory_Map, m_Memory_Map_Size);
+#endif
 
-		if( m_Cache_bTemp )
-		{
-			SG_File_Delete(m_Cache_File);
-		}
+	m_Memory_Map		= NULL;
+	m_Memory_Map_Size	= 0;
 
-		return( true );
+	for(int y=0; y<Get_NY(); y++)
+	{
+		m_Values[y]	= pValues + (size_t)y * Get_nLineBytes();
 	}
 
-	return( false );
+	return( true );
 }
 
 
 ///////////////////////////////////////////////////////////
 //														 //
+//						Cache							 //
+//														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
+// A file cached grid keeps blocks of consecutive file rows
+// in memory. Blocks are loaded on first access, the least
+// recently used block is dropped (and written back, if it
+// has been modified), when the buffer limit is reached.
+// Row order is that of the file, i.e. flipped grids are
+// resolved when requesting a row.
+
+//---------------------------------------------------------
+#define CACHE_BLOCK_BYTES	(1 * N_MEGABYTE_BYTES)	// target size of a single block
+
+//---------------------------------------------------------
+struct SSG_Grid_Cache
 {
-	char	Buffer[8];
+	int		nLines, nBlocks, nBuffer, nLoaded, Last;
 
-	switch( m_Type )
-	{
-	case SG_DATATYPE_Float : (*(float  *)Buffer) = (float          )(Value); break;
-	case SG_DATATYPE_Double: (*(double *)Buffer) = (double         )(Value); break;
-	case SG_DATATYPE_Byte  : (*(BYTE   *)Buffer) = SG_ROUND_TO_BYTE (Value); break;
-	case SG_DATATYPE_Char  : (*(char   *)Buffer) = SG_ROUND_TO_CHAR (Value); break;
-	case SG_DATATYPE_Word  : (*(WORD   *)Buffer) = SG_ROUND_TO_WORD (Value); break;
-	case SG_DATATYPE_Short : (*(short  *)Buffer) = SG_ROUND_TO_SHORT(Value); break;
-	case SG_DATATYPE_DWord : (*(DWORD  *)Buffer) = SG_ROUND_TO_DWORD(Value); break;
-	case SG_DATATYPE_Int   : (*(int    *)Buffer) = SG_ROUND_TO_INT  (Value); break;
-	case SG_DATATYPE_Long  : (*(sLong  *)Buffer) = SG_ROUND_TO_SLONG(Value); break;
+	sLong	Access, *Accessed;
 
-	default:
-		return;
-	}
+	size_t	nBytes;
 
-	if( m_Cache_bSwap )
-	{
-		_Swap_Bytes(Buffer, Get_nValueBytes());
-	}
+	bool	*bModified;
 
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
-	{
-		fwrite(Buffer, 1, Get_nValueBytes(), m_Cache_Stream);
-	}
-}
+	int		*Loaded;
 
-//---------------------------------------------------------
-double CSG_Grid::_Cache_Get_Value(int x, int y) const
-{
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
-	{
-		char	Buffer[8];
+	char	**Blocks, **Packed;	// packed blocks are only used by compressed grids
 
-		if( fread(Buffer, 1, Get_nValueBytes(), m_Cache_Stream) == (size_t)Get_nValueBytes() )
-		{
-			switch( m_Type )
-			{
-			case SG_DATATYPE_Byte  : return( (double)(*(BYTE   *)Buffer) );
-			case SG_DATATYPE_Char  : return( (double)(*(char   *)Buffer) );
-			case SG_DATATYPE_Word  : return( (double)(*(WORD   *)Buffer) );
-			case SG_DATATYPE_Short : return( (double)(*(short  *)Buffer) );
-			case SG_DATATYPE_DWord : return( (double)(*(DWORD  *)Buffer) );
-			case SG_DATATYPE_Int   : return( (double)(*(int    *)Buffer) );
-			case SG_DATATYPE_Long  : return( (double)(*(sLong  *)Buffer) );
-			case SG_DATATYPE_Float : return( (double)(*(float  *)Buffer) );
-			case SG_DATATYPE_Double: return( (double)(*(double *)Buffer) );
-
-			default:
-				break;
+	size_t	*nPacked;
+
+#ifdef _OPENMP
+	omp_lock_t	Lock;
+#endif
+};
+
+//---------------------------------------------------------
+#ifdef _OPENMP
+	#define CACHE_LOCK(pCache)		omp_set_lock  (&(pCache)->Lock)
+	#define CACHE_UNLOCK(pCache)	omp_unset_lock(&(pCache)->Lock)
+#else
+	#define CACHE_LOCK(pCache)
+	#define CACHE_UNLOCK(pCache)
+#endif
+
+//---------------------------------------------------------
+#define CACHE_FILE_POS(iBlock)	(m_Cache_Offset + (sLong)(iBlock) * m_Cache_Buffer->nLines * m_nBytes_Line)
+
+//---------------------------------------------------------
+#if defined(_SAGA_LINUX)
+#define CACHE_FILE_SEEK	fseek
+#else
+#define CACHE_FILE_SEEK	_fseeki64
+#endif
+
+//---------------------------------------------------------
+// A compressed grid uses the same block buffer, but instead of
+// a file its blocks are backed by run length encoded copies in
+// memory. Runs are detected on whole values, so that constant
+// areas of any data type (e.g. no-data) shrink to a few bytes.
+
+//---------------------------------------------------------
+#define COMPRESSION_BUFFER_BYTES	(16 * N_MEGABYTE_BYTES)	// decompressed blocks kept by a compressed grid
+
+#define COMPRESSION_VALUE_BYTES		(m_Type == SG_DATATYPE_Bit ? 1 : Get_nValueBytes())
+
+//---------------------------------------------------------
+// A grid with a source (see CSG_Grid_Source) uses the block
+// buffer as well. Blocks are aligned to the source's native
+// blocks and read from the source on first access. Modified
+// blocks are packed like those of compressed grids when they
+// are dropped, because the source itself is read only.
+
+//---------------------------------------------------------
+// A packed block starts with a flag byte, which is zero for
+// blocks stored as they are, because encoding would not have
+// made them smaller. Otherwise segments follow, each with a
+// signed count, which is followed by one value to be repeated
+// for positive counts or by -count literal values.
+//---------------------------------------------------------
+static char * SG_Grid_Block_Pack(const char *Block, size_t nBytes, size_t nValue, size_t &nPacked)
+{
+	char	*Packed	= (char *)SG_Malloc(1 + nBytes);
+
+	if( Packed == NULL )
+	{
+		return( NULL );
+	}
+
+	size_t	n	= nBytes / nValue, iPacked = 1;	bool bEncoded = true;
+
+	#define PACK_VALUE(i)	(Block + (i) * nValue)
+
+	for(size_t i=0, j; bEncoded && i<n; i=j)
+	{
+		int		Count;
+
+		if( i + 1 < n && !memcmp(PACK_VALUE(i), PACK_VALUE(i + 1), nValue) )	// run
+		{
+			for(j=i+2; j<n && j-i<0x7FFFFFFF && !memcmp(PACK_VALUE(i), PACK_VALUE(j), nValue); j++) {}
+
+			Count	=  (int)(j - i);
+		}
+		else	// literals until the next run starts
+		{
+			for(j=i+1; j<n && j-i<0x7FFFFFFF && (j + 1 >= n || memcmp(PACK_VALUE(j), PACK_VALUE(j + 1), nValue)); j++) {}
+
+			Count	= -(int)(j - i);
+		}
+
+		size_t	Size	= Count > 0 ? nValue : (j - i) * nValue;
+
+		if( (bEncoded = iPacked + sizeof(Count) + Size < nBytes) == true )
+		{
+			memcpy(Packed + iPacked, &Count      , sizeof(Count));	iPacked	+= sizeof(Count);
+			memcpy(Packed + iPacked, PACK_VALUE(i), Size        );	iPacked	+= Size;
+		}
+	}
+
+	#undef PACK_VALUE
+
+	//-----------------------------------------------------
+	if( bEncoded )
+	{
+		Packed[0]	= 1;
+		Packed		= (char *)SG_Realloc(Packed, iPacked);
+		nPacked		= iPacked;
+	}
+	else
+	{
+		Packed[0]	= 0;
+		memcpy(Packed + 1, Block, nBytes);
+		nPacked		= 1 + nBytes;
+	}
+
+	return( Packed );
+}
+
+//---------------------------------------------------------
+static bool SG_Grid_Block_Unpack(const char *Packed, size_t nPacked, char *Block, size_t nBytes, size_t nValue)
+{
+	if( Packed == NULL )	// has never been written
+	{
+		memset(Block, 0, nBytes);
+
+		return( true );
+	}
+
+	if( Packed[0] == 0 )
+	{
+		memcpy(Block, Packed + 1, M_GET_MIN(nBytes, nPacked - 1));
+
+		return( true );
+	}
+
+	for(size_t i=1, iBlock=0; i<nPacked && iBlock<nBytes; )
+	{
+		int		Count;	memcpy(&Count, Packed + i, sizeof(Count));	i	+= sizeof(Count);
+
+		if( Count > 0 )
+		{
+			if( nValue == 1 )
+			{
+				memset(Block + iBlock, Packed[i], Count);	iBlock	+= Count;
+			}
+			else for(int j=0; j<Count; j++, iBlock+=nValue)
+			{
+				memcpy(Block + iBlock, Packed + i, nValue);
+			}
+
+			i	+= nValue;
+		}
+		else
+		{
+			size_t	Size	= (size_t)(-Count) * nValue;
+
+			memcpy(Block + iBlock, Packed + i, Size);	iBlock	+= Size;	i	+= Size;
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::Set_Cache(bool bOn)
+{
+	if( bOn )
+	{
+		if( is_Cached() )
+		{
+			return( true );
+		}
+
+		if( is_Buffered() && !_Cache_Destroy(true) )	// compressed or reading from a source
+		{
+			return( false );
+		}
+
+		return( _Cache_Create(m_Cache_File                                  , m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
+			|| _Cache_Create(SG_File_Make_Path("", Get_File_Name(),  "dat"), m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
+			|| _Cache_Create(SG_File_Make_Path("", Get_File_Name(), "sdat"), m_Type, m_Cache_Offset, m_Cache_bSwap, m_Cache_bFlip)
+			|| _Cache_Create()
+		);
+	}
+
+	return( !is_Cached() || _Cache_Destroy(true) );
+}
+
+//---------------------------------------------------------
+/**
+* Drops the grid's values and reads them from pSource instead,
+* whenever a block of rows is accessed for the first time. The
+* grid takes the ownership of pSource. Set bFlip, if the
+* source's first row is the grid's top row, as it is usual for
+* image formats. Sources are usually implemented by tool
+* libraries, which therefore stay loaded as long as any grid
+* uses one of their sources (see SG_Grid_Get_Source_Count()).
+* Passing NULL reads all values into memory and deletes the
+* source.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::Set_Source(CSG_Grid_Source *pSource, bool bFlip)
+{
+	if( !pSource )
+	{
+		return( !has_Source() || _Cache_Destroy(true) );
+	}
+
+	if( !m_System.is_Valid() || m_Type == SG_DATATYPE_Undefined || m_Type == SG_DATATYPE_Bit )
+	{
+		return( false );
+	}
+
+	_Memory_Destroy();
+
+	m_Cache_File	.Clear();
+	m_Cache_bTemp	= true;	// nothing to be flushed
+	m_Cache_Offset	= 0;
+	m_Cache_bSwap	= false;
+	m_Cache_bFlip	= bFlip;
+	m_Cache_Source	= pSource;
+
+	SG_Grid_Sources_Add(this);
+
+	return( _Cache_Buffer_Create(true) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Check(void)
+{
+	sLong	nBytes	= m_System.Get_NCells() * Get_nValueBytes();
+
+	if(	SG_Grid_Cache_Get_Mode() > 0 && nBytes > SG_Grid_Cache_Get_Threshold() )
+	{
+		if( SG_Grid_Cache_Get_Mode() == 2 )	// confirm
+		{
+			CSG_String	s;
+
+			s.Printf("%s\n%s\n%s: %.2fMB",
+				_TL("Shall I activate file caching for new grid."),
+				m_System.Get_Name(),
+				_TL("Total memory size"),
+				(double)nBytes / (double)N_MEGABYTE_BYTES
+			);
+
+			return( SG_UI_Dlg_Continue(s, _TL("Activate Grid File Cache?")) );
+		}
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Create(const CSG_String &File, TSG_Data_Type Data_Type, sLong Offset, bool bSwap, bool bFlip)	// open existing file for caching
+{
+	if( !m_System.is_Valid() || m_Type != Data_Type || !SG_File_Exists(File) )
+	{
+		return( false );
+	}
+
+	if( (m_Cache_Stream = fopen(File, "r+b")) == NULL	// read and write
+	&&  (m_Cache_Stream = fopen(File, "rb" )) == NULL )	// read only
+	{
+		return( false );
+	}
+
+	m_Cache_File	= File;
+	m_Cache_bTemp	= false;
+	m_Cache_Offset	= Offset;
+	m_Cache_bSwap	= m_Type == SG_DATATYPE_Bit ? false : bSwap;
+	m_Cache_bFlip	= bFlip;
+
+	_Array_Destroy();
+
+	return( _Cache_Buffer_Create() );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Create(void)	// create temporary cache file
+{
+	if( !m_System.is_Valid() || (m_Type == SG_DATATYPE_Undefined && is_Buffered()) )
+	{
+		return( false );
+	}
+
+	CSG_String	File	= SG_File_Get_Name_Temp("sg_grd", SG_Grid_Cache_Get_Directory());
+
+	if( (m_Cache_Stream = fopen(File, "w+b")) == NULL )	// read and write, create empty
+	{
+		return( false );
+	}
+
+	m_Cache_File	= File;
+	m_Cache_bTemp	= true;
+	m_Cache_Offset	= 0;
+	m_Cache_bSwap	= false;
+	m_Cache_bFlip	= false;
+
+	if( m_Values )	// blocks beyond the end of file are read as zero, so only existing data needs to be written
+	{
+		for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+		{
+			fwrite(m_Values[y], 1, Get_nLineBytes(), m_Cache_Stream);
+		}
+
+		SG_UI_Process_Set_Ready();
+	}
+
+	_Array_Destroy();
+
+	return( _Cache_Buffer_Create() );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Buffer_Create(bool bCompressed)
+{
+	m_Cache_Buffer	= new SSG_Grid_Cache;
+
+	m_Cache_Buffer->nLines	= (int)M_GET_MAX(1, CACHE_BLOCK_BYTES / Get_nLineBytes());
+
+	if( m_Cache_Source )	// whole multiples of the source's native block height
+	{
+		int	nRows	= M_GET_MAX(1, m_Cache_Source->Get_Block_Rows());
+
+		m_Cache_Buffer->nLines	= nRows * M_GET_MAX(1, m_Cache_Buffer->nLines / nRows);
+	}
+
+	if( m_Cache_Buffer->nLines > Get_NY() )
+	{
+		m_Cache_Buffer->nLines	= Get_NY();
+	}
+
+	m_Cache_Buffer->nBytes	= (size_t)m_Cache_Buffer->nLines * Get_nLineBytes();
+	m_Cache_Buffer->nBlocks	= 1 + (Get_NY() - 1) / m_Cache_Buffer->nLines;
+	m_Cache_Buffer->nBuffer	= (int)M_GET_MAX(3, (bCompressed && !m_Cache_Source ? COMPRESSION_BUFFER_BYTES : SG_Grid_Cache_Get_Buffer()) / (sLong)m_Cache_Buffer->nBytes);	// keep at least three blocks for neighbourhood operations
+
+	if( m_Cache_Buffer->nBuffer > m_Cache_Buffer->nBlocks )
+	{
+		m_Cache_Buffer->nBuffer	= m_Cache_Buffer->nBlocks;
+	}
+
+	m_Cache_Buffer->nLoaded		= 0;
+	m_Cache_Buffer->Last		= -1;
+	m_Cache_Buffer->Access		= 0;
+
+	m_Cache_Buffer->Blocks		= (char **)SG_Calloc(m_Cache_Buffer->nBlocks, sizeof(char *));
+	m_Cache_Buffer->Accessed	= (sLong *)SG_Calloc(m_Cache_Buffer->nBlocks, sizeof(sLong ));
+	m_Cache_Buffer->bModified	= (bool  *)SG_Calloc(m_Cache_Buffer->nBlocks, sizeof(bool  ));
+	m_Cache_Buffer->Loaded		= (int   *)SG_Calloc(m_Cache_Buffer->nBuffer, sizeof(int   ));
+
+	m_Cache_Buffer->Packed		= bCompressed ? (char  **)SG_Calloc(m_Cache_Buffer->nBlocks, sizeof(char *)) : NULL;
+	m_Cache_Buffer->nPacked		= bCompressed ? (size_t *)SG_Calloc(m_Cache_Buffer->nBlocks, sizeof(size_t)) : NULL;
+
+#ifdef _OPENMP
+	omp_init_lock(&m_Cache_Buffer->Lock);
+#endif
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
+{
+	if( is_Buffered() )
+	{
+		if( bMemory_Restore && _Array_Create() )
+		{
+			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+			{
+				char	*pLine	= _Cache_Get_Line(y, false);
+
+				if( pLine )
+				{
+					memcpy(m_Values[y], pLine, Get_nLineBytes());
+				}
+			}
+
+			SG_UI_Process_Set_Ready();
+		}
+
+		//-------------------------------------------------
+		if( !m_Cache_bTemp )
+		{
+			_Cache_Flush();
+		}
+
+		for(int i=0; i<m_Cache_Buffer->nLoaded; i++)
+		{
+			SG_Free(m_Cache_Buffer->Blocks[m_Cache_Buffer->Loaded[i]]);
+		}
+
+		SG_Free(m_Cache_Buffer->Blocks   );
+		SG_Free(m_Cache_Buffer->Accessed );
+		SG_Free(m_Cache_Buffer->bModified);
+		SG_Free(m_Cache_Buffer->Loaded   );
+
+		if( m_Cache_Buffer->Packed )
+		{
+			for(int i=0; i<m_Cache_Buffer->nBlocks; i++)
+			{
+				SG_FREE_SAFE(m_Cache_Buffer->Packed[i]);
+			}
+
+			SG_Free(m_Cache_Buffer->Packed );
+			SG_Free(m_Cache_Buffer->nPacked);
+		}
+
+#ifdef _OPENMP
+		omp_destroy_lock(&m_Cache_Buffer->Lock);
+#endif
+
+		delete(m_Cache_Buffer);
+
+		m_Cache_Buffer	= NULL;
+
+		//-------------------------------------------------
+		if( m_Cache_Stream )
+		{
+			fclose(m_Cache_Stream);
+
+			m_Cache_Stream	= NULL;
+
+			if( m_Cache_bTemp )
+			{
+				SG_File_Delete(m_Cache_File);
+			}
+		}
+
+		if( m_Cache_Source )
+		{
+			SG_Grid_Sources_Del(this);	// unregister first, the source is inspected by SG_Grid_Get_Source_Count()
+
+			delete(m_Cache_Source);
+
+			m_Cache_Source	= NULL;
+		}
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Flush(void) const
+{
+	if( !is_Buffered() )
+	{
+		return( false );
+	}
+
+	bool	bResult	= true;
+
+	CACHE_LOCK(m_Cache_Buffer);
+
+	for(int i=0; i<m_Cache_Buffer->nLoaded; i++)
+	{
+		if( m_Cache_Buffer->bModified[m_Cache_Buffer->Loaded[i]] && !_Cache_Save_Block(m_Cache_Buffer->Loaded[i]) )
+		{
+			bResult	= false;
+		}
+	}
+
+	if( m_Cache_Stream )
+	{
+		fflush(m_Cache_Stream);
+	}
+
+	CACHE_UNLOCK(m_Cache_Buffer);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Save_Block(int iBlock) const
+{
+	SSG_Grid_Cache	*pCache	= m_Cache_Buffer;
+
+	int		nLines	= M_GET_MIN(pCache->nLines, Get_NY() - iBlock * pCache->nLines);
+
+	size_t	nBytes	= (size_t)nLines * Get_nLineBytes();
+
+	pCache->bModified[iBlock]	= false;
+	pCache->Last				= -1;	// stream is not positioned for sequential reading anymore
+
+	if( pCache->Packed )
+	{
+		size_t	nPacked;	char	*Packed	= SG_Grid_Block_Pack(pCache->Blocks[iBlock], nBytes, COMPRESSION_VALUE_BYTES, nPacked);
+
+		if( !Packed )
+		{
+			return( false );
+		}
+
+		SG_FREE_SAFE(pCache->Packed[iBlock]);
+
+		pCache->Packed [iBlock]	= Packed;
+		pCache->nPacked[iBlock]	= nPacked;
+
+		return( true );
+	}
+
+	if( CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(iBlock), SEEK_SET) )
+	{
+		return( false );
+	}
+
+	if( m_Cache_bSwap )
+	{
+		CSG_Array	Buffer(1, nBytes);	char	*pValue	= (char *)Buffer.Get_Array();
+
+		memcpy(pValue, pCache->Blocks[iBlock], nBytes);
+
+		for(size_t i=0; i<nBytes; i+=Get_nValueBytes(), pValue+=Get_nValueBytes())
+		{
+			_Swap_Bytes(pValue, Get_nValueBytes());
+		}
+
+		return( fwrite(Buffer.Get_Array(), 1, nBytes, m_Cache_Stream) == nBytes );
+	}
+
+	return( fwrite(pCache->Blocks[iBlock], 1, nBytes, m_Cache_Stream) == nBytes );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Load_Block(int iBlock) const
+{
+	SSG_Grid_Cache	*pCache	= m_Cache_Buffer;
+
+	char	*Block	= NULL;
+
+	if( pCache->nLoaded < pCache->nBuffer )	// there is still space left
+	{
+		if( (Block = (char *)SG_Malloc(pCache->nBytes)) == NULL )
+		{
+			return( false );
+		}
+
+		pCache->Loaded[pCache->nLoaded++]	= iBlock;
+	}
+	else	// drop the least recently used block
+	{
+		int	iLRU	= 0;
+
+		for(int i=1; i<pCache->nLoaded; i++)
+		{
+			if( pCache->Accessed[pCache->Loaded[i]] < pCache->Accessed[pCache->Loaded[iLRU]] )
+			{
+				iLRU	= i;
+			}
+		}
+
+		int	jBlock	= pCache->Loaded[iLRU];
+
+		if( pCache->bModified[jBlock] )
+		{
+			_Cache_Save_Block(jBlock);
+		}
+
+		Block	= pCache->Blocks[jBlock];	pCache->Blocks[jBlock]	= NULL;
+
+		pCache->Loaded[iLRU]	= iBlock;
+	}
+
+	pCache->Blocks   [iBlock]	= Block;
+	pCache->bModified[iBlock]	= false;
+	pCache->Accessed [iBlock]	= ++pCache->Access;
+
+	//-----------------------------------------------------
+	int		nLines	= M_GET_MIN(pCache->nLines, Get_NY() - iBlock * pCache->nLines);
+
+	size_t	nBytes	= (size_t)nLines * Get_nLineBytes(), nRead = 0;
+
+	if( m_Cache_Source && !pCache->Packed[iBlock] )	// not modified since it has been read from the source
+	{
+		if( !m_Cache_Source->Read_Rows(iBlock * pCache->nLines, nLines, Block) )	// keep the block as no-data, instead of trying again and again
+		{
+			SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s [%d-%d]", _TL("grid"), _TL("failed to read rows from source"), iBlock * pCache->nLines, iBlock * pCache->nLines + nLines - 1));
+
+			double	NoData	= Get_NoData_Value();	size_t nValue = Get_nValueBytes();
+
+			switch( m_Type )
+			{
+			case SG_DATATYPE_Float : *((float  *)Block) = (float          )(NoData); break;
+			case SG_DATATYPE_Double: *((double *)Block) = (double         )(NoData); break;
+			case SG_DATATYPE_Byte  : *((BYTE   *)Block) = SG_ROUND_TO_BYTE (NoData); break;
+			case SG_DATATYPE_Char  : *((char   *)Block) = SG_ROUND_TO_CHAR (NoData); break;
+			case SG_DATATYPE_Word  : *((WORD   *)Block) = SG_ROUND_TO_WORD (NoData); break;
+			case SG_DATATYPE_Short : *((short  *)Block) = SG_ROUND_TO_SHORT(NoData); break;
+			case SG_DATATYPE_DWord : *((DWORD  *)Block) = SG_ROUND_TO_DWORD(NoData); break;
+			case SG_DATATYPE_Int   : *((int    *)Block) = SG_ROUND_TO_INT  (NoData); break;
+			case SG_DATATYPE_Long  : *((sLong  *)Block) = SG_ROUND_TO_SLONG(NoData); break;
+			case SG_DATATYPE_ULong : *((uLong  *)Block) = SG_ROUND_TO_ULONG(NoData); break;
+			default                : memset(Block, 0, nValue); break;	// bit grids have no source
 			}
 
-			if( m_Cache_bSwap )
+			for(size_t i=nValue; i<nBytes; i+=nValue)
 			{
-				_Swap_Bytes(Buffer, Get_nValueBytes());
+				memcpy(Block + i, Block, nValue);
 			}
 		}
+
+		return( true );
+	}
+
+	if( pCache->Packed )
+	{
+		return( SG_Grid_Block_Unpack(pCache->Packed[iBlock], pCache->nPacked[iBlock], Block, nBytes, COMPRESSION_VALUE_BYTES) );
+	}
+
+	if( pCache->Last + 1 == iBlock || !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(iBlock), SEEK_SET) )	// no need to seek when reading sequentially
+	{
+		nRead	= fread(Block, 1, nBytes, m_Cache_Stream);
+	}
+
+	if( nRead < nBytes )	// not yet written or beyond the end of file
+	{
+		memset(Block + nRead, 0, nBytes - nRead);
+
+		pCache->Last	= -1;	// stream position is undefined now
+	}
+	else
+	{
+		pCache->Last	= iBlock;
+	}
+
+	if( m_Cache_bSwap )
+	{
+		for(size_t i=0; i<nRead; i+=Get_nValueBytes())
+		{
+			_Swap_Bytes(Block + i, Get_nValueBytes());
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Returns a pointer to row y in the block buffer, loading
+* its block, if necessary. The caller has to hold the cache
+* lock as long as the pointer is in use.
+*/
+//---------------------------------------------------------
+char * CSG_Grid::_Cache_Get_Line(int y, bool bModify) const
+{
+	SSG_Grid_Cache	*pCache	= m_Cache_Buffer;
+
+	if( m_Cache_bFlip )
+	{
+		y	= Get_NY() - 1 - y;
+	}
+
+	int	iBlock	= y / pCache->nLines;
+
+	if( !pCache->Blocks[iBlock] )
+	{
+		bool	bSequential	= pCache->Last + 1 == iBlock;
+
+		if( !_Cache_Load_Block(iBlock) )
+		{
+			return( NULL );
+		}
+
+		if( bSequential && iBlock + 1 < pCache->nBlocks && !pCache->Blocks[iBlock + 1] && pCache->nBuffer > 3 )
+		{
+			_Cache_Load_Block(iBlock + 1);	// read-ahead, when rows are requested in file order
+		}
+	}
+
+	pCache->Accessed[iBlock]	= ++pCache->Access;
+
+	if( bModify )
+	{
+		pCache->bModified[iBlock]	= true;
+	}
+
+	return( pCache->Blocks[iBlock] + (size_t)(y % pCache->nLines) * Get_nLineBytes() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
+{
+	CACHE_LOCK(m_Cache_Buffer);
+
+	char	*pLine	= _Cache_Get_Line(y, true);
+
+	if( pLine ) switch( m_Type )
+	{
+	case SG_DATATYPE_Float : ((float  *)pLine)[x] = (float          )(Value); break;
+	case SG_DATATYPE_Double: ((double *)pLine)[x] = (double         )(Value); break;
+	case SG_DATATYPE_Byte  : ((BYTE   *)pLine)[x] = SG_ROUND_TO_BYTE (Value); break;
+	case SG_DATATYPE_Char  : ((char   *)pLine)[x] = SG_ROUND_TO_CHAR (Value); break;
+	case SG_DATATYPE_Word  : ((WORD   *)pLine)[x] = SG_ROUND_TO_WORD (Value); break;
+	case SG_DATATYPE_Short : ((short  *)pLine)[x] = SG_ROUND_TO_SHORT(Value); break;
+	case SG_DATATYPE_DWord : ((DWORD  *)pLine)[x] = SG_ROUND_TO_DWORD(Value); break;
+	case SG_DATATYPE_Int   : ((int    *)pLine)[x] = SG_ROUND_TO_INT  (Value); break;
+	case SG_DATATYPE_Long  : ((sLong  *)pLine)[x] = SG_ROUND_TO_SLONG(Value); break;
+	case SG_DATATYPE_ULong : ((uLong  *)pLine)[x] = SG_ROUND_TO_ULONG(Value); break;
+	case SG_DATATYPE_Bit   : ((BYTE   *)pLine)[x / 8] = Value != 0.0
+			? ((BYTE *)pLine)[x / 8] |   m_Bitmask[x % 8]
+			: ((BYTE *)pLine)[x / 8] & (~m_Bitmask[x % 8]);
+		break;
+
+	default:
+		break;
+	}
+
+	CACHE_UNLOCK(m_Cache_Buffer);
+}
+
+//---------------------------------------------------------
+double CSG_Grid::_Cache_Get_Value(int x, int y) const
+{
+	double	Value	= 0.;
+
+	CACHE_LOCK(m_Cache_Buffer);
+
+	char	*pLine	= _Cache_Get_Line(y, false);
+
+	if( pLine ) switch( m_Type )
+	{
+	case SG_DATATYPE_Float : Value = (double)((float  *)pLine)[x]; break;
+	case SG_DATATYPE_Double: Value = (double)((double *)pLine)[x]; break;
+	case SG_DATATYPE_Byte  : Value = (double)((BYTE   *)pLine)[x]; break;
+	case SG_DATATYPE_Char  : Value = (double)((char   *)pLine)[x]; break;
+	case SG_DATATYPE_Word  : Value = (double)((WORD   *)pLine)[x]; break;
+	case SG_DATATYPE_Short : Value = (double)((short  *)pLine)[x]; break;
+	case SG_DATATYPE_DWord : Value = (double)((DWORD  *)pLine)[x]; break;
+	case SG_DATATYPE_Int   : Value = (double)((int    *)pLine)[x]; break;
+	case SG_DATATYPE_Long  : Value = (double)((sLong  *)pLine)[x]; break;
+	case SG_DATATYPE_ULong : Value = (double)((uLong  *)pLine)[x]; break;
+	case SG_DATATYPE_Bit   : Value = (((BYTE *)pLine)[x / 8] & m_Bitmask[x % 8]) == 0 ? 0. : 1.; break;
+
+	default:
+		break;
+	}
+
+	CACHE_UNLOCK(m_Cache_Buffer);
+
+	return( Value );
+}
+
+
+//---------------------------------------------------------
+/**
+* Lets the source fill pGrid with resampled values, which is
+* only done as long as none of the values has been changed.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::_Source_Get_Resampled(CSG_Grid *pGrid, TSG_Grid_Resampling Resampling) const
+{
+	if( !m_Cache_Source )
+	{
+		return( false );
+	}
+
+	bool	bModified	= false;
+
+	CACHE_LOCK(m_Cache_Buffer);
+
+	for(int i=0; !bModified && i<m_Cache_Buffer->nBlocks; i++)
+	{
+		bModified	= m_Cache_Buffer->bModified[i] || m_Cache_Buffer->Packed[i] != NULL;
+	}
+
+	CACHE_UNLOCK(m_Cache_Buffer);
+
+	return( !bModified && m_Cache_Source->Read_Resampled(pGrid, Resampling) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Compression						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::Set_Compression(bool bOn)
+{
+	if( bOn )
+	{
+		if( is_Compressed() )
+		{
+			return( true );
+		}
+
+		if( is_Buffered() && !_Cache_Destroy(true) )
+		{
+			return( false );
+		}
+
+		return( _Compression_Create() );
+	}
+
+	return( !is_Compressed() || _Cache_Destroy(true) );
+}
+
+//---------------------------------------------------------
+/**
+* Returns the memory currently used by the compressed blocks,
+* not including the buffer of decompressed blocks.
+*/
+//---------------------------------------------------------
+sLong CSG_Grid::Get_Memory_Size_Compressed(void) const
+{
+	if( !is_Compressed() )
+	{
+		return( Get_Memory_Size() );
+	}
+
+	sLong	nBytes	= 0;
+
+	CACHE_LOCK(m_Cache_Buffer);
+
+	for(int i=0; i<m_Cache_Buffer->nBlocks; i++)
+	{
+		nBytes	+= m_Cache_Buffer->nPacked[i];
+	}
+
+	CACHE_UNLOCK(m_Cache_Buffer);
+
+	return( nBytes );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Compression_Check(void)
+{
+	return( SG_Grid_Compression_Get_Threshold() > 0 && m_System.Get_NCells() * Get_nValueBytes() > SG_Grid_Compression_Get_Threshold() );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Compression_Create(void)
+{
+	if( !m_System.is_Valid() || m_Type == SG_DATATYPE_Undefined || is_Buffered() )
+	{
+		return( false );
+	}
+
+	m_Cache_File	.Clear();
+	m_Cache_bTemp	= true;
+	m_Cache_Offset	= 0;
+	m_Cache_bSwap	= false;
+	m_Cache_bFlip	= false;
+
+	_Cache_Buffer_Create(true);
+
+	if( m_Values )	// blocks that have never been written are zero, so only existing data needs to be packed
+	{
+		SSG_Grid_Cache	*pCache	= m_Cache_Buffer;
+
+		bool	bPacked	= true;
+
+		for(int iBlock=0; bPacked && iBlock<pCache->nBlocks; iBlock++)	// not to be cancelled, all blocks are needed before the array is released
+		{
+			SG_UI_Process_Set_Progress(iBlock, pCache->nBlocks);
+
+			int		nLines	= M_GET_MIN(pCache->nLines, Get_NY() - iBlock * pCache->nLines);
+
+			pCache->Packed[iBlock]	= SG_Grid_Block_Pack((char *)m_Values[iBlock * pCache->nLines], (size_t)nLines * Get_nLineBytes(), COMPRESSION_VALUE_BYTES, pCache->nPacked[iBlock]);
+
+			bPacked	= pCache->Packed[iBlock] != NULL;
+		}
+
+		SG_UI_Process_Set_Ready();
+
+		if( !bPacked )	// keep the uncompressed array
+		{
+			_Cache_Destroy(false);
+
+			return( false );
+		}
 	}
 
-	return( 0.0 );
+	_Array_Destroy();
+
+	return( true );
 }
 
 
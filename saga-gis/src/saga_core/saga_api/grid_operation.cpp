@@ -51,10 +51,146 @@
 
 //---------------------------------------------------------
 #include <memory.h>
+#include <limits>
 
 #include "grid.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Typed Row Kernels					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The data type is resolved once per row. The kernels
+// themselves work on plain arrays of the grid's value type,
+// so that the compiler can inline and vectorize them.
+
+//---------------------------------------------------------
+template <typename TValue> inline TValue	SG_Grid_Round			(double Value)	{	return( (TValue)(Value < 0. ? Value - 0.5 : Value + 0.5) );	}
+template <>                inline float		SG_Grid_Round<float >	(double Value)	{	return( (float)Value );	}
+template <>                inline double	SG_Grid_Round<double>	(double Value)	{	return(        Value );	}
+
+//---------------------------------------------------------
+inline bool	SG_Grid_Row_is_Typed(TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Byte  : case SG_DATATYPE_Char  : case SG_DATATYPE_Word  : case SG_DATATYPE_Short :
+	case SG_DATATYPE_DWord : case SG_DATATYPE_Int   : case SG_DATATYPE_ULong : case SG_DATATYPE_Long  :
+	case SG_DATATYPE_Float : case SG_DATATYPE_Double:
+		return( true );
+
+	default:	// bit grids are not addressable per value
+		return( false );
+	}
+}
+
+//---------------------------------------------------------
+#define SG_GRID_ROW_CALL(Type, Function, pRow, ...)	switch( Type )\
+{\
+case SG_DATATYPE_Byte  : Function((BYTE   *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Char  : Function((char   *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Word  : Function((WORD   *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Short : Function((short  *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_DWord : Function((DWORD  *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Int   : Function((int    *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_ULong : Function((uLong  *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Long  : Function((sLong  *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Float : Function((float  *)(pRow), __VA_ARGS__); break;\
+case SG_DATATYPE_Double: Function((double *)(pRow), __VA_ARGS__); break;\
+default: break;\
+}
+
+//---------------------------------------------------------
+// no-data range held in local variables, so that writing to
+// a row does not force the compiler to reload it per value
+#define SG_GRID_ROW_NODATA_RANGE(Grid)	const double NoData_Lo = Grid.Get_NoData_Value(), NoData_Hi = M_GET_MAX(NoData_Lo, Grid.Get_NoData_Value(true));
+#define SG_GRID_ROW_IS_NODATA(z)		(SG_is_NaN(z) || (NoData_Lo <= (z) && (z) <= NoData_Hi))
+
+//---------------------------------------------------------
+template <typename TValue>
+void	SG_Grid_Row_Fill		(TValue *pRow, int nx, double Value)
+{
+	const TValue	z	= SG_Grid_Round<TValue>(Value);
+
+	for(int x=0; x<nx; x++)
+	{
+		pRow[x]	= z;
+	}
+}
+
+//---------------------------------------------------------
+/** Scaled values of a row, no-data becomes NaN. */
+template <typename TValue>
+void	SG_Grid_Row_Get			(const TValue *pRow, int nx, const CSG_Grid &Grid, double *Values)
+{
+	const double	Scale	= Grid.Get_Scaling(), Offset = Grid.Get_Offset(); SG_GRID_ROW_NODATA_RANGE(Grid);
+
+	for(int x=0; x<nx; x++)
+	{
+		double	z	= (double)pRow[x];
+
+		Values[x]	= SG_GRID_ROW_IS_NODATA(z) ? std::numeric_limits<double>::quiet_NaN() : Offset + Scale * z;
+	}
+}
+
+//---------------------------------------------------------
+/** Stores scaled values to a row, NaN becomes no-data. */
+template <typename TValue>
+void	SG_Grid_Row_Set			(TValue *pRow, int nx, const CSG_Grid &Grid, const double *Values)
+{
+	const double	Scale	= Grid.Get_Scaling(), Offset = Grid.Get_Offset();
+
+	const TValue	NoData	= SG_Grid_Round<TValue>(Grid.Get_NoData_Value());
+
+	for(int x=0; x<nx; x++)
+	{
+		pRow[x]	= SG_is_NaN(Values[x]) ? NoData : SG_Grid_Round<TValue>((Values[x] - Offset) / Scale);
+	}
+}
+
+//---------------------------------------------------------
+/** Applies Operation with either the scalar Value or, if not NULL, with the row of scaled operands in Values (NaN = no-data). */
+template <typename TValue>
+void	SG_Grid_Row_Operation	(TValue *pRow, int nx, const CSG_Grid &Grid, TSG_Grid_Operation Operation, const double *Values, double Value)
+{
+	const double	Scale	= Grid.Get_Scaling(), Offset = Grid.Get_Offset(); SG_GRID_ROW_NODATA_RANGE(Grid);
+
+	const TValue	NoData	= SG_Grid_Round<TValue>(Grid.Get_NoData_Value());
+
+	for(int x=0; x<nx; x++)
+	{
+		double	z	= (double)pRow[x], v = Values ? Values[x] : Value;
+
+		if( !SG_GRID_ROW_IS_NODATA(z) && !SG_is_NaN(v) )
+		{
+			z	= Offset + Scale * z;
+
+			switch( Operation )
+			{
+			case GRID_OPERATION_Addition      : z += v; break;
+			case GRID_OPERATION_Subtraction   : z -= v; break;
+			case GRID_OPERATION_Multiplication: z *= v; break;
+			case GRID_OPERATION_Division      :
+				if( v == 0. )
+				{
+					pRow[x]	= NoData;
+
+					continue;
+				}
+
+				z	*= 1. / v;
+				break;
+			}
+
+			pRow[x]	= SG_Grid_Round<TValue>((z - Offset) / Scale);
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //				Data Assignments - Value				 //
@@ -66,6 +202,19 @@ void CSG_Grid::Assign_NoData(void)
 {
 	double Value = Get_NoData_Value();
 
+	if( Get_Row_Data(0) && SG_Grid_Row_is_Typed(m_Type) )
+	{
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			SG_GRID_ROW_CALL(m_Type, SG_Grid_Row_Fill, m_Values[y], Get_NX(), Value);
+		}
+
+		Set_Modified();
+
+		return;
+	}
+
 	#pragma omp parallel for
 	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
 	{
@@ -81,13 +230,27 @@ bool CSG_Grid::Assign(double Value)
 		return( false );
 	}
 
-	if( Value == 0. && !is_Cached() )
+	if( Value == 0. && Get_Row_Data(0) && !is_Scaled() )
 	{
 		#pragma omp parallel for
 		for(int y=0; y<Get_NY(); y++)
 		{
 			memset(m_Values[y], 0, Get_nLineBytes());
 		}
+
+		Set_Modified();
+	}
+	else if( Get_Row_Data(0) && SG_Grid_Row_is_Typed(m_Type) )
+	{
+		Value	= (Value - m_zOffset) / m_zScale;
+
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			SG_GRID_ROW_CALL(m_Type, SG_Grid_Row_Fill, m_Values[y], Get_NX(), Value);
+		}
+
+		Set_Modified();
 	}
 	else
 	{
@@ -136,7 +299,23 @@ bool CSG_Grid::Assign(CSG_Grid *pGrid, TSG_Grid_Resampling Interpolation)
 	bool	bResult	= false;
 
 	//---------------------------------------------------------
-	if( m_System == pGrid->m_System )
+	if( m_System == pGrid->m_System && Get_Row_Data(0) && SG_Grid_Row_is_Typed(m_Type) && pGrid->Get_Row_Data(0) && SG_Grid_Row_is_Typed(pGrid->m_Type) )
+	{
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			CSG_Vector	Values(Get_NX());
+
+			SG_GRID_ROW_CALL(pGrid->m_Type, SG_Grid_Row_Get,  pGrid->m_Values[y], Get_NX(), *pGrid, Values.Get_Data());
+			SG_GRID_ROW_CALL(       m_Type, SG_Grid_Row_Set,         m_Values[y], Get_NX(), *this , Values.Get_Data());
+		}
+
+		Set_Modified();
+
+		bResult	= true;
+	}
+
+	else if( m_System == pGrid->m_System )
 	{
 		for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 		{
@@ -164,6 +343,11 @@ bool CSG_Grid::Assign(CSG_Grid *pGrid, TSG_Grid_Resampling Interpolation)
 		bResult	= _Assign_Interpolated(pGrid, GRID_RESAMPLING_NearestNeighbour);
 	}
 
+	else if( Get_Cellsize() > pGrid->Get_Cellsize() && pGrid->_Source_Get_Resampled(this, Interpolation) )	// Up-Scaling by the source, e.g. from overviews...
+	{
+		bResult	= true;
+	}
+
 	//---------------------------------------------------------
 	else switch( Interpolation )
 	{
@@ -633,6 +817,22 @@ CSG_Grid & CSG_Grid::_Operation_Arithmetic(const CSG_Grid &Grid, TSG_Grid_Operat
 		?	GRID_RESAMPLING_NearestNeighbour
 		:	GRID_RESAMPLING_BSpline;
 
+		if( m_System == Grid.m_System && Get_Row_Data(0) && SG_Grid_Row_is_Typed(m_Type) && Grid.Get_Row_Data(0) && SG_Grid_Row_is_Typed(Grid.m_Type) )
+		{
+			#pragma omp parallel for
+			for(int y=0; y<Get_NY(); y++)
+			{
+				CSG_Vector	Values(Get_NX());
+
+				SG_GRID_ROW_CALL(Grid.m_Type, SG_Grid_Row_Get      , Grid.m_Values[y], Get_NX(), Grid , Values.Get_Data());
+				SG_GRID_ROW_CALL(     m_Type, SG_Grid_Row_Operation,      m_Values[y], Get_NX(), *this, Operation, Values.Get_Data(), 0.);
+			}
+
+			Set_Modified();
+
+			return( *this );
+		}
+
 		#pragma omp parallel for
 		for(int y=0; y<Get_NY(); y++)
 		{
@@ -699,6 +899,23 @@ CSG_Grid & CSG_Grid::_Operation_Arithmetic(double Value, TSG_Grid_Operation Oper
 		break;
 	}
 
+	//-----------------------------------------------------
+	if( Get_Row_Data(0) && SG_Grid_Row_is_Typed(m_Type) )
+	{
+		TSG_Grid_Operation	Scalar	= Operation == GRID_OPERATION_Subtraction ? GRID_OPERATION_Addition
+									: Operation == GRID_OPERATION_Division    ? GRID_OPERATION_Multiplication : Operation;
+
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			SG_GRID_ROW_CALL(m_Type, SG_Grid_Row_Operation, m_Values[y], Get_NX(), *this, Scalar, (const double *)NULL, Value);
+		}
+
+		Set_Modified();
+
+		return( *this );
+	}
+
 	//-----------------------------------------------------
 	#pragma omp parallel for
 	for(int y=0; y<Get_NY(); y++)
@@ -240,6 +240,184 @@ protected:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Batch Queries						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// A nanoflann result set collecting the Count nearest points
+// within a squared search radius directly into the caller's
+// arrays, so that a query needs no memory allocation at all.
+//---------------------------------------------------------
+class CSG_KDTree_Result_Nearest
+{
+public:
+	CSG_KDTree_Result_Nearest(size_t Capacity, double Radius2, sLong *Indices, double *Distances)
+	{
+		m_Count = 0; m_Capacity = Capacity; m_Radius2 = Radius2; m_Indices = Indices; m_Distances = Distances;
+	}
+
+	size_t					size		(void)	const	{	return( m_Count );	}
+
+	bool					full		(void)	const	{	return( m_Count == m_Capacity );	}
+
+	double					worstDist	(void)	const	{	return( full() ? m_Distances[m_Capacity - 1] : m_Radius2 );	}
+
+	bool					addPoint	(double Distance, size_t Index)
+	{
+		if( Distance < worstDist() )
+		{
+			size_t	i	= m_Count < m_Capacity ? m_Count++ : m_Capacity - 1;
+
+			for( ; i>0 && m_Distances[i - 1] > Distance; i--)
+			{
+				m_Distances[i] = m_Distances[i - 1];
+				m_Indices  [i] = m_Indices  [i - 1];
+			}
+
+			m_Distances[i] = Distance;
+			m_Indices  [i] = (sLong)Index;
+		}
+
+		return( true );	// continue search
+	}
+
+
+private:
+
+	size_t					m_Count, m_Capacity;
+
+	double					m_Radius2, *m_Distances;
+
+	sLong					*m_Indices;
+
+};
+
+//---------------------------------------------------------
+template <class TTree, int Dimension>
+bool	SG_KDTree_Get_Nearest_Points	(const TTree *pTree, const double *Coordinates, size_t nQueries, size_t Count, double Radius, sLong *Indices, double *Distances, size_t *nMatches)
+{
+	if( !pTree || !Coordinates || Count < 1 || !Indices || !Distances )
+	{
+		return( false );
+	}
+
+	double	Radius2	= Radius > 0. ? Radius*Radius : std::numeric_limits<double>::max();
+
+	#pragma omp parallel for
+	for(sLong i=0; i<(sLong)nQueries; i++)
+	{
+		sLong	*pIndices	= Indices   + i * Count;
+		double	*pDistances	= Distances + i * Count;
+
+		CSG_KDTree_Result_Nearest	Result(Count, Radius2, pIndices, pDistances);
+
+		pTree->findNeighbors(Result, Coordinates + i * Dimension, nanoflann::SearchParams());
+
+		size_t	n	= Result.size();
+
+		for(size_t j=0; j<n; j++)
+		{
+			pDistances[j]	= sqrt(pDistances[j]);
+		}
+
+		for(size_t j=n; j<Count; j++)
+		{
+			pIndices  [j]	= -1;
+			pDistances[j]	= -1.;
+		}
+
+		if( nMatches )
+		{
+			nMatches[i]	= n;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+template <class TTree, int Dimension>
+bool	SG_KDTree_Get_Radius_Points		(const TTree *pTree, const double *Coordinates, size_t nQueries, double Radius, CSG_Array_sLong &Offsets, CSG_Array_sLong &Indices, CSG_Vector &Distances, bool bSorted)
+{
+	if( !pTree || !Coordinates || Radius <= 0. || !Offsets.Create(nQueries + 1) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// queries are processed in contiguous chunks, each with
+	// its own match buffer that grows with the matches found
+	// and is reused for all queries of the chunk
+
+	sLong	nChunks	= M_GET_MIN((sLong)nQueries, 16 * (sLong)SG_OMP_Get_Max_Num_Threads()); if( nChunks < 1 ) nChunks = 1;
+
+	std::vector<std::pair<size_t, double>>	*Chunks	= new std::vector<std::pair<size_t, double>>[nChunks];
+
+	double	Radius2	= Radius*Radius;
+
+	Offsets[0]	= 0;
+
+	#pragma omp parallel for schedule(dynamic)
+	for(sLong iChunk=0; iChunk<nChunks; iChunk++)
+	{
+		std::vector<std::pair<size_t, double>>	&Chunk	= Chunks[iChunk];
+
+		std::vector<std::pair<size_t, double>>	Matches;
+
+		sLong	i0 = (sLong)nQueries *  iChunk      / nChunks;
+		sLong	i1 = (sLong)nQueries * (iChunk + 1) / nChunks;
+
+		for(sLong i=i0; i<i1; i++)
+		{
+			size_t	n	= Chunk.size();
+
+			nanoflann::RadiusResultSet<double, size_t>	Result(Radius2, Matches);	// clears, but keeps the capacity
+
+			pTree->findNeighbors(Result, Coordinates + i * Dimension, nanoflann::SearchParams());
+
+			if( bSorted )
+			{
+				std::sort(Matches.begin(), Matches.end(), nanoflann::IndexDist_Sorter());
+			}
+
+			Chunk.insert(Chunk.end(), Matches.begin(), Matches.end());
+
+			Offsets[i + 1]	= (sLong)(Chunk.size() - n);	// match count, turned into offset below
+		}
+	}
+
+	//-----------------------------------------------------
+	for(size_t i=0; i<nQueries; i++)
+	{
+		Offsets[i + 1]	+= Offsets[i];
+	}
+
+	Indices  .Create(Offsets[nQueries]);
+	Distances.Create(Offsets[nQueries]);
+
+	#pragma omp parallel for
+	for(sLong iChunk=0; iChunk<nChunks; iChunk++)
+	{
+		const std::vector<std::pair<size_t, double>>	&Chunk	= Chunks[iChunk];
+
+		sLong	j	= Offsets[(sLong)nQueries * iChunk / nChunks];
+
+		for(size_t i=0; i<Chunk.size(); i++, j++)
+		{
+			Indices  [j]	= (sLong)Chunk[i].first;
+			Distances[j]	= sqrt(Chunk[i].second);
+		}
+	}
+
+	delete[](Chunks);
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -525,31 +703,35 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, dou
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices  [i] = (int)Matches[i]. first ;
+			Indices  [i] = (sLong)Matches[i]. first ;
 			Distances[i] = sqrt(Matches[i].second);
 		}
 	}
 	else if( Count > 0 )
 	{
-		size_t *_Indices = new size_t[Count];
+		Indices.Set_Array(Count, false);	// no reallocation if the arrays are reused with the same size
 
-		Distances.Create(Count);
-
-		Count = Get_Nearest_Points(Coordinate, Count, _Indices, Distances.Get_Data());
-
-		if( Count < (size_t)Distances.Get_N() )
+		if( (size_t)Distances.Get_N() != Count )
 		{
-			Distances.Set_Rows(Count);
+			Distances.Create(Count);
 		}
 
-		Indices.Create(Count);
+		CSG_KDTree_Result_Nearest Result(Count, std::numeric_limits<double>::max(), Indices.Get_Array(), Distances.Get_Data());
+
+		((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->findNeighbors(Result, Coordinate, nanoflann::SearchParams());
+
+		Count = Result.size();
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices[i] = (int)(_Indices[i]);
+			Distances[i] = sqrt(Distances[i]);
 		}
 
-		delete[](_Indices);
+		if( Count < (size_t)Distances.Get_N() )
+		{
+			Indices  .Set_Array(Count);
+			Distances.Set_Rows (Count);
+		}
 	}
 
 	return( Count );
@@ -629,7 +811,7 @@ size_t      CSG_KDTree_2D::Get_Duplicates(double Coordinate[2], CSG_Array_sLong
 		}
 		else
 		{
-			Indices[Count++] = (int)Matches[i].first;
+			Indices[Count++] = (sLong)Matches[i].first;
 		}
 	}
 
@@ -689,6 +871,42 @@ size_t      CSG_KDTree_2D::Get_Duplicates(double x, double y)
 }
 
 
+//---------------------------------------------------------
+/**
+* Batch version of the k nearest neighbours search. The nQueries
+* query points are expected as consecutive x/y tuples in
+* Coordinates. For each query the Count nearest points within the
+* search Radius (ignored if not greater than zero) are written to
+* Indices and Distances, which both need to provide nQueries * Count
+* elements. Unused entries are set to -1. If nMatches is not NULL
+* it receives the number of matches per query. Queries are processed
+* in parallel and the function does not touch any member variables,
+* so that it can also be called concurrently.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_2D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, size_t Count, double Radius, sLong *Indices, double *Distances, size_t *nMatches)	const
+{
+	return( SG_KDTree_Get_Nearest_Points<CSG_KDTree_Adaptor::kd_tree_2d, 2>((const CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree,
+		Coordinates, nQueries, Count, Radius, Indices, Distances, nMatches
+	));
+}
+
+//---------------------------------------------------------
+/**
+* Batch version of the radius search. The matches of query i are
+* stored in Indices and Distances, starting at Offsets[i] and ending
+* before Offsets[i + 1]. Offsets will have nQueries + 1 elements.
+* If bSorted is true, matches are sorted by ascending distance.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_2D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, double Radius, CSG_Array_sLong &Offsets, CSG_Array_sLong &Indices, CSG_Vector &Distances, bool bSorted)	const
+{
+	return( SG_KDTree_Get_Radius_Points<CSG_KDTree_Adaptor::kd_tree_2d, 2>((const CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree,
+		Coordinates, nQueries, Radius, Offsets, Indices, Distances, bSorted
+	));
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -906,31 +1124,35 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, dou
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices  [i] = (int)Matches[i]. first ;
+			Indices  [i] = (sLong)Matches[i]. first ;
 			Distances[i] = sqrt(Matches[i].second);
 		}
 	}
 	else if( Count > 0 )
 	{
-		size_t *_Indices = new size_t[Count];
-
-		Distances.Create(Count);
-
-		Count = Get_Nearest_Points(Coordinate, Count, _Indices, Distances.Get_Data());
+		Indices.Set_Array(Count, false);	// no reallocation if the arrays are reused with the same size
 
-		if( Count < (size_t)Distances.Get_N() )
+		if( (size_t)Distances.Get_N() != Count )
 		{
-			Distances.Set_Rows(Count);
+			Distances.Create(Count);
 		}
 
-		Indices.Create(Count);
+		CSG_KDTree_Result_Nearest Result(Count, std::numeric_limits<double>::max(), Indices.Get_Array(), Distances.Get_Data());
+
+		((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->findNeighbors(Result, Coordinate, nanoflann::SearchParams());
+
+		Count = Result.size();
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices[i] = (int)(_Indices[i]);
+			Distances[i] = sqrt(Distances[i]);
 		}
 
-		delete[](_Indices);
+		if( Count < (size_t)Distances.Get_N() )
+		{
+			Indices  .Set_Array(Count);
+			Distances.Set_Rows (Count);
+		}
 	}
 
 	return( Count );
@@ -1010,7 +1232,7 @@ size_t      CSG_KDTree_3D::Get_Duplicates(double Coordinate[3], CSG_Array_sLong
 		}
 		else
 		{
-			Indices[Count++] = (int)Matches[i].first;
+			Indices[Count++] = (sLong)Matches[i].first;
 		}
 	}
 
@@ -1070,6 +1292,42 @@ size_t      CSG_KDTree_3D::Get_Duplicates(double x, double y, double z)
 }
 
 
+//---------------------------------------------------------
+/**
+* Batch version of the k nearest neighbours search. The nQueries
+* query points are expected as consecutive x/y/z tuples in
+* Coordinates. For each query the Count nearest points within the
+* search Radius (ignored if not greater than zero) are written to
+* Indices and Distances, which both need to provide nQueries * Count
+* elements. Unused entries are set to -1. If nMatches is not NULL
+* it receives the number of matches per query. Queries are processed
+* in parallel and the function does not touch any member variables,
+* so that it can also be called concurrently.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_3D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, size_t Count, double Radius, sLong *Indices, double *Distances, size_t *nMatches)	const
+{
+	return( SG_KDTree_Get_Nearest_Points<CSG_KDTree_Adaptor::kd_tree_3d, 3>((const CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree,
+		Coordinates, nQueries, Count, Radius, Indices, Distances, nMatches
+	));
+}
+
+//---------------------------------------------------------
+/**
+* Batch version of the radius search. The matches of query i are
+* stored in Indices and Distances, starting at Offsets[i] and ending
+* before Offsets[i + 1]. Offsets will have nQueries + 1 elements.
+* If bSorted is true, matches are sorted by ascending distance.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_3D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, double Radius, CSG_Array_sLong &Offsets, CSG_Array_sLong &Indices, CSG_Vector &Distances, bool bSorted)	const
+{
+	return( SG_KDTree_Get_Radius_Points<CSG_KDTree_Adaptor::kd_tree_3d, 3>((const CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree,
+		Coordinates, nQueries, Radius, Offsets, Indices, Distances, bSorted
+	));
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
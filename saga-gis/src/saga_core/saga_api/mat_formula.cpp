@@ -253,6 +253,9 @@ CSG_Formula::CSG_Formula(void)
 	m_ctable			= NULL;
 	m_error				= NULL;
 
+	m_Program_Result	= -1;
+	m_Program_Buffers	=  0;
+
 	//-----------------------------------------------------
 	m_Functions	= (TSG_Function *)SG_Calloc(MAX_CTABLE, sizeof(TSG_Function));
 
@@ -279,6 +282,8 @@ bool CSG_Formula::Destroy(void)
 	SG_FREE_SAFE(m_Formula.code);
 	SG_FREE_SAFE(m_Formula.ctable);
 
+	_Compile();
+
 	m_bError			= false;
 
 	return( true );
@@ -447,6 +452,8 @@ bool CSG_Formula::Set_Formula(const CSG_String &Formula)
 
 		if( m_Formula.code != NULL )
 		{
+			_Compile();
+
 			return( true );
 		}
 	}
@@ -602,13 +609,15 @@ double CSG_Formula::_Get_Value(const double *Parameters, TSG_Formula func) const
 
 		case '&':
 			y		= *--bufp;
-			result	= y && *(--bufp) ? 1.0 : 0.0;
+			x		= *--bufp;
+			result	= x && y ? 1.0 : 0.0;
 			*bufp++	= result;
 			break;
 
 		case '|':
 			y		= *--bufp;
-			result	= y || *(--bufp) ? 1.0 : 0.0;
+			x		= *--bufp;
+			result	= x || y ? 1.0 : 0.0;
 			*bufp++	= result;
 			break;
 
@@ -653,6 +662,474 @@ double CSG_Formula::_Get_Value(const double *Parameters, TSG_Formula func) const
 } 
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+// Batch evaluation                                      //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The byte code is compiled to a register program, which
+// is evaluated block wise over whole arrays. Each program
+// step loops over a block of values, so that the compiler
+// can vectorize it. Constant sub-expressions are folded
+// and equal sub-expressions are evaluated only once.
+//
+#define PROGRAM_BLOCK		256
+
+//---------------------------------------------------------
+enum
+{
+	PROGRAM_SLOT_CONSTANT	= 0,
+	PROGRAM_SLOT_VARIABLE,
+	PROGRAM_SLOT_TEMPORARY
+};
+
+//---------------------------------------------------------
+typedef struct
+{
+	int						Type, Variable, Buffer;
+
+	double					Value;
+}
+TSG_Program_Slot;
+
+//---------------------------------------------------------
+typedef struct
+{
+	char					Operator;	// byte code operator, 'F' for function calls
+
+	bool					bVarying;
+
+	int						Builtin, nArgs, Args[3], Result;	// Builtin: index of a standard function, -1 otherwise
+
+	TSG_Formula_Function_1	Function;
+}
+TSG_Program_Step;
+
+//---------------------------------------------------------
+static void SG_Program_Step(const TSG_Program_Step &Step, const double *a, const double *b, const double *c, double *r, int n)
+{
+	int	i;
+
+	switch( Step.Operator )
+	{
+	case 'M': for(i=0; i<n; i++) { r[i] = -a[i]; } break;
+	case '+': for(i=0; i<n; i++) { r[i] = a[i] + b[i]; } break;
+	case '-': for(i=0; i<n; i++) { r[i] = a[i] - b[i]; } break;
+	case '*': for(i=0; i<n; i++) { r[i] = a[i] * b[i]; } break;
+	case '/': for(i=0; i<n; i++) { r[i] = a[i] / b[i]; } break;
+	case '^': for(i=0; i<n; i++) { r[i] = pow(a[i], b[i]); } break;
+	case '=': for(i=0; i<n; i++) { r[i] = a[i] == b[i] ? 1. : 0.; } break;
+	case '>': for(i=0; i<n; i++) { r[i] = a[i] >  b[i] ? 1. : 0.; } break;
+	case '<': for(i=0; i<n; i++) { r[i] = a[i] <  b[i] ? 1. : 0.; } break;
+	case '&': for(i=0; i<n; i++) { r[i] = (a[i] != 0.) & (b[i] != 0.) ? 1. : 0.; } break;
+	case '|': for(i=0; i<n; i++) { r[i] = (a[i] != 0.) | (b[i] != 0.) ? 1. : 0.; } break;
+
+	//-----------------------------------------------------
+	case 'F': switch( Step.Builtin )
+		{
+		case  0: for(i=0; i<n; i++) { r[i] = exp  (a[i]); } break;
+		case  1: for(i=0; i<n; i++) { r[i] = log  (a[i]); } break;
+		case  2: for(i=0; i<n; i++) { r[i] = sin  (a[i]); } break;
+		case  3: for(i=0; i<n; i++) { r[i] = cos  (a[i]); } break;
+		case  4: for(i=0; i<n; i++) { r[i] = tan  (a[i]); } break;
+		case  5: for(i=0; i<n; i++) { r[i] = asin (a[i]); } break;
+		case  6: for(i=0; i<n; i++) { r[i] = acos (a[i]); } break;
+		case  7: for(i=0; i<n; i++) { r[i] = atan (a[i]); } break;
+		case  8: for(i=0; i<n; i++) { r[i] = atan2(a[i], b[i]); } break;
+		case  9: for(i=0; i<n; i++) { r[i] = fabs (a[i]); } break;
+		case 10: for(i=0; i<n; i++) { r[i] = sqrt (a[i]); } break;
+		case 11: for(i=0; i<n; i++) { r[i] = a[i] > b[i] ? 1. : 0.; } break;
+		case 12: for(i=0; i<n; i++) { r[i] = a[i] < b[i] ? 1. : 0.; } break;
+		case 13: for(i=0; i<n; i++) { r[i] = fabs(a[i] - b[i]) < EPSILON ? 1. : 0.; } break;
+		case 14: for(i=0; i<n; i++) { r[i] = M_PI; } break;
+		case 15: for(i=0; i<n; i++) { r[i] = (int)a[i]; } break;
+		case 16: for(i=0; i<n; i++) { r[i] = fmod (a[i], b[i]); } break;
+		case 17: for(i=0; i<n; i++) { r[i] = a[i] ? b[i] : c[i]; } break;
+		case 18: for(i=0; i<n; i++) { r[i] = log10(a[i]); } break;
+		case 19: for(i=0; i<n; i++) { r[i] = pow  (a[i], b[i]); } break;
+		case 20: for(i=0; i<n; i++) { r[i] = a[i] * a[i]; } break;
+		case 23: for(i=0; i<n; i++) { r[i] = (a[i] != 0.) & (b[i] != 0.) ? 1. : 0.; } break;
+		case 24: for(i=0; i<n; i++) { r[i] = (a[i] != 0.) | (b[i] != 0.) ? 1. : 0.; } break;
+		case 25: for(i=0; i<n; i++) { r[i] = a[i] < b[i] ? a[i] : b[i]; } break;
+		case 26: for(i=0; i<n; i++) { r[i] = a[i] > b[i] ? a[i] : b[i]; } break;
+
+		default: switch( Step.nArgs )	// user defined and random functions
+			{
+			case 0: for(i=0; i<n; i++) { r[i] = ((TSG_Formula_Function_0)Step.Function)(                  ); } break;
+			case 1: for(i=0; i<n; i++) { r[i] = ((TSG_Formula_Function_1)Step.Function)(a[i]              ); } break;
+			case 2: for(i=0; i<n; i++) { r[i] = ((TSG_Formula_Function_2)Step.Function)(a[i], b[i]        ); } break;
+			case 3: for(i=0; i<n; i++) { r[i] = ((TSG_Formula_Function_3)Step.Function)(a[i], b[i], c[i]  ); } break;
+			}
+			break;
+		}
+		break;
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CSG_Formula::_Compile_Slot(int Type, int Variable, double Value)
+{
+	TSG_Program_Slot	*Slots	= (TSG_Program_Slot *)m_Program_Slots.Get_Array();
+
+	for(sLong i=0; Type!=PROGRAM_SLOT_TEMPORARY && i<m_Program_Slots.Get_Size(); i++)
+	{
+		if( Slots[i].Type == Type && (Type == PROGRAM_SLOT_VARIABLE
+			? Slots[i].Variable == Variable
+			: !memcmp(&Slots[i].Value, &Value, sizeof(double))) )
+		{
+			return( (int)i );
+		}
+	}
+
+	if( !m_Program_Slots.Inc_Array() )
+	{
+		return( -1 );
+	}
+
+	TSG_Program_Slot	&Slot	= ((TSG_Program_Slot *)m_Program_Slots.Get_Array())[m_Program_Slots.Get_Size() - 1];
+
+	Slot.Type		= Type;
+	Slot.Variable	= Variable;
+	Slot.Value		= Value;
+	Slot.Buffer		= -1;
+
+	return( (int)m_Program_Slots.Get_Size() - 1 );
+}
+
+//---------------------------------------------------------
+bool CSG_Formula::_Compile(void)
+{
+	m_Program_Slots.Create(sizeof(TSG_Program_Slot));
+	m_Program_Steps.Create(sizeof(TSG_Program_Step));
+
+	m_Program_Result	= -1;
+	m_Program_Buffers	=  0;
+
+	if( !m_Formula.code )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_Array_Int	Stack;
+
+	for(const char *code=m_Formula.code; *code; )
+	{
+		TSG_Program_Step	Step;
+
+		Step.Operator	= *code++;
+		Step.bVarying	= false;
+		Step.Builtin	= -1;
+		Step.nArgs		= 2;
+		Step.Function	= NULL;
+
+		switch( Step.Operator )
+		{
+		case 'D':
+			Stack.Add(_Compile_Slot(PROGRAM_SLOT_CONSTANT, -1, m_Formula.ctable[(unsigned char)*code++]));
+			continue;
+
+		case 'V':
+			Stack.Add(_Compile_Slot(PROGRAM_SLOT_VARIABLE, *code++ - 'a', 0.));
+			continue;
+
+		case 'M':
+			Step.nArgs		= 1;
+			break;
+
+		case 'F': {
+			const TSG_Function	&Function	= m_Functions[(unsigned char)*code++];
+
+			Step.nArgs		= Function.nParameters;
+			Step.bVarying	= Function.bVarying;
+			Step.Function	= Function.Function;
+
+			for(int i=0; !Step.bVarying && gSG_Functions[i].Function; i++)
+			{
+				if( gSG_Functions[i].Function == Function.Function && gSG_Functions[i].nParameters == Function.nParameters )
+				{
+					Step.Builtin	= i;	break;
+				}
+			}
+			break; }
+
+		default:
+			if( !_is_Operand_Code(Step.Operator) )
+			{
+				return( false );
+			}
+			break;
+		}
+
+		//-------------------------------------------------
+		if( Stack.Get_Size() < Step.nArgs )
+		{
+			return( false );
+		}
+
+		bool	bConstant	= !Step.bVarying;
+
+		Step.Args[0] = Step.Args[1] = Step.Args[2] = -1;
+
+		for(int i=Step.nArgs-1; i>=0; i--)
+		{
+			Step.Args[i]	= Stack[Stack.Get_Size() - 1]; Stack.Dec_Array(false);
+
+			if( Step.Args[i] < 0 )
+			{
+				return( false );
+			}
+
+			bConstant	= bConstant && ((TSG_Program_Slot *)m_Program_Slots[Step.Args[i]])->Type == PROGRAM_SLOT_CONSTANT;
+		}
+
+		if( Step.nArgs == 2 && strchr("+*=&|", Step.Operator) && Step.Args[0] > Step.Args[1] )	// commutative, sort operands to find equal expressions
+		{
+			int	i	= Step.Args[0]; Step.Args[0] = Step.Args[1]; Step.Args[1] = i;
+		}
+
+		//-------------------------------------------------
+		if( bConstant )	// fold constant expression
+		{
+			double	Value, Args[3];
+
+			for(int i=0; i<Step.nArgs; i++)
+			{
+				Args[i]	= ((TSG_Program_Slot *)m_Program_Slots[Step.Args[i]])->Value;
+			}
+
+			SG_Program_Step(Step, Args, Args + 1, Args + 2, &Value, 1);
+
+			Stack.Add(_Compile_Slot(PROGRAM_SLOT_CONSTANT, -1, Value));
+
+			continue;
+		}
+
+		//-------------------------------------------------
+		Step.Result	= -1;
+
+		for(sLong i=0; !Step.bVarying && Step.Result<0 && i<m_Program_Steps.Get_Size(); i++)	// reuse equal expression
+		{
+			TSG_Program_Step	&Prev	= *(TSG_Program_Step *)m_Program_Steps[i];
+
+			if( Prev.Operator == Step.Operator && Prev.Function == Step.Function && !Prev.bVarying
+			&&  Prev.Args[0] == Step.Args[0] && Prev.Args[1] == Step.Args[1] && Prev.Args[2] == Step.Args[2] )
+			{
+				Step.Result	= Prev.Result;
+			}
+		}
+
+		if( Step.Result < 0 )
+		{
+			if( (Step.Result = _Compile_Slot(PROGRAM_SLOT_TEMPORARY, -1, 0.)) < 0 || !m_Program_Steps.Inc_Array() )
+			{
+				return( false );
+			}
+
+			*(TSG_Program_Step *)m_Program_Steps[m_Program_Steps.Get_Size() - 1]	= Step;
+		}
+
+		Stack.Add(Step.Result);
+	}
+
+	if( Stack.Get_Size() != 1 || Stack[0] < 0 )
+	{
+		return( false );
+	}
+
+	m_Program_Result	= Stack[0];
+
+	//-----------------------------------------------------
+	// assign block buffers to temporary results, a buffer is
+	// released after the last step that reads it. The last
+	// step writes directly to the output.
+
+	TSG_Program_Slot	*Slots	= (TSG_Program_Slot *)m_Program_Slots.Get_Array();
+	TSG_Program_Step	*Steps	= (TSG_Program_Step *)m_Program_Steps.Get_Array();
+
+	int	nSteps	= (int)m_Program_Steps.Get_Size();
+
+	CSG_Array_Int	Last(m_Program_Slots.Get_Size()), Free;
+
+	Last.Assign(-1);
+
+	for(int iStep=0; iStep<nSteps; iStep++)
+	{
+		for(int i=0; i<Steps[iStep].nArgs; i++)
+		{
+			Last[Steps[iStep].Args[i]]	= iStep;
+		}
+	}
+
+	Last[m_Program_Result]	= nSteps;
+
+	for(int iStep=0; iStep<nSteps; iStep++)
+	{
+		TSG_Program_Step	&Step	= Steps[iStep];
+
+		for(int i=0; i<Step.nArgs; i++)
+		{
+			TSG_Program_Slot	&Slot	= Slots[Step.Args[i]];
+
+			if( Slot.Type == PROGRAM_SLOT_TEMPORARY && Slot.Buffer >= 0 && Last[Step.Args[i]] == iStep
+			&&  (i < 1 || Step.Args[0] != Step.Args[i]) && (i < 2 || Step.Args[1] != Step.Args[i]) )
+			{
+				Free.Add(Slot.Buffer);	// all operations are element wise, so the result may overwrite its operands
+			}
+		}
+
+		if( iStep < nSteps - 1 || Step.Result != m_Program_Result )
+		{
+			if( Free.Get_Size() > 0 )
+			{
+				Slots[Step.Result].Buffer	= Free[Free.Get_Size() - 1]; Free.Dec_Array(false);
+			}
+			else
+			{
+				Slots[Step.Result].Buffer	= m_Program_Buffers++;
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Evaluates the formula for whole arrays of values. Values[i]
+  * supplies the values of the i'th variable ('a' + i) for each
+  * of the nResult results. If Values[i] is NULL or i exceeds
+  * nValues, the value set with Set_Variable() is used instead.
+  * Evaluation is thread safe, so that large arrays can be split
+  * into chunks that are processed in parallel.
+*/
+//---------------------------------------------------------
+bool CSG_Formula::Get_Values(const double **Values, int nValues, double *Result, sLong nResult) const
+{
+	if( !m_Formula.code || nResult < 1 )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( m_Program_Result < 0 )	// no program, fall back to the interpreter
+	{
+		double	Parameters[32];
+
+		memcpy(Parameters, m_Parameters, 32 * sizeof(double));
+
+		for(sLong i=0; i<nResult; i++)
+		{
+			for(int j=0; j<nValues && j<32; j++)
+			{
+				if( Values[j] )
+				{
+					Parameters[j]	= Values[j][i];
+				}
+			}
+
+			Result[i]	= _Get_Value(Parameters, m_Formula);
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	const TSG_Program_Slot	*Slots	= (const TSG_Program_Slot *)m_Program_Slots.Get_Array();
+	const TSG_Program_Step	*Steps	= (const TSG_Program_Step *)m_Program_Steps.Get_Array();
+
+	int	nSlots	= (int)m_Program_Slots.Get_Size();
+	int	nSteps	= (int)m_Program_Steps.Get_Size();
+	int	nBlock	= (int)M_GET_MIN(nResult, PROGRAM_BLOCK);
+
+	CSG_Array	Pointers(sizeof(double *), nSlots), Buffer(sizeof(double), (sLong)nBlock * (nSlots + m_Program_Buffers));
+
+	if( !Pointers.Get_Array() || !Buffer.Get_Array() )
+	{
+		return( false );
+	}
+
+	double	**p	= (double **)Pointers.Get_Array();
+	double	 *b	= (double  *)Buffer  .Get_Array();
+
+	for(int i=0; i<nSlots; i++)
+	{
+		const TSG_Program_Slot	&Slot	= Slots[i];
+
+		p[i]	= NULL;
+
+		if( Slot.Type == PROGRAM_SLOT_TEMPORARY )
+		{
+			if( Slot.Buffer >= 0 )
+			{
+				p[i]	= b + (sLong)nBlock * (nSlots + Slot.Buffer);
+			}
+		}
+		else if( Slot.Type == PROGRAM_SLOT_CONSTANT || Slot.Variable >= nValues || !Values[Slot.Variable] )
+		{
+			double	Value	= Slot.Type == PROGRAM_SLOT_CONSTANT ? Slot.Value : m_Parameters[Slot.Variable];
+
+			p[i]	= b + (sLong)nBlock * i;
+
+			for(int j=0; j<nBlock; j++)
+			{
+				p[i][j]	= Value;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(sLong Offset=0; Offset<nResult; Offset+=nBlock)
+	{
+		int	n	= (int)M_GET_MIN(nBlock, nResult - Offset);
+
+		for(int i=0; i<nSlots; i++)
+		{
+			const TSG_Program_Slot	&Slot	= Slots[i];
+
+			if( Slot.Type == PROGRAM_SLOT_VARIABLE && Slot.Variable < nValues && Values[Slot.Variable] )
+			{
+				p[i]	= (double *)Values[Slot.Variable] + Offset;
+			}
+			else if( Slot.Type == PROGRAM_SLOT_TEMPORARY && Slot.Buffer < 0 )
+			{
+				p[i]	= Result + Offset;
+			}
+		}
+
+		for(int iStep=0; iStep<nSteps; iStep++)
+		{
+			const TSG_Program_Step	&Step	= Steps[iStep];
+
+			SG_Program_Step(Step,
+				Step.nArgs > 0 ? p[Step.Args[0]] : NULL,
+				Step.nArgs > 1 ? p[Step.Args[1]] : NULL,
+				Step.nArgs > 2 ? p[Step.Args[2]] : NULL,
+				p[Step.Result], n
+			);
+		}
+
+		if( p[m_Program_Result] != Result + Offset )
+		{
+			memcpy(Result + Offset, p[m_Program_Result], n * sizeof(double));
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -711,6 +1188,8 @@ bool CSG_Formula::Add_Function(const char *Name, TSG_Formula_Function_1 Function
 		pFunction->nParameters = nParameters;
 		pFunction->bVarying    = bVarying;
 
+		_Compile();	// the program refers to the superseded function
+
 		_Set_Error();
 
 		return( true );
@@ -52,6 +52,10 @@
 //---------------------------------------------------------
 #include "mat_tools.h"
 
+#ifdef WITH_CBLAS
+#include <cblas.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -63,6 +67,104 @@
 bool		SG_Matrix_Triangular_Decomposition	(CSG_Matrix &A, CSG_Vector &d, CSG_Vector &e);
 bool		SG_Matrix_Tridiagonal_QL			(CSG_Matrix &Q, CSG_Vector &d, CSG_Vector &e);
 
+//---------------------------------------------------------
+#define MATRIX_BLOCK	64			// edge length of the blocks processed by the cache-blocked kernels
+#define MATRIX_PARALLEL	(1 << 16)	// minimum number of multiply-adds that is worth a parallel loop
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// C += A * B (bTransposed: C += A' * B), C has ny rows and
+// nx columns, nk is the shared dimension. Works on blocks
+// that fit into the cache, the innermost loop runs along
+// contiguous rows of B and C, so that it can be vectorised.
+// The rows may be stored anywhere in memory.
+
+void		SG_Matrix_Multiply_Add	(int ny, int nx, int nk, const double **A, bool bTransposed, const double **B, double **C)
+{
+	#pragma omp parallel for schedule(dynamic) if( (double)ny * nx * nk >= MATRIX_PARALLEL )
+	for(int y0=0; y0<ny; y0+=MATRIX_BLOCK)
+	{
+		int yEnd = M_GET_MIN(y0 + MATRIX_BLOCK, ny);
+
+		for(int k0=0; k0<nk; k0+=MATRIX_BLOCK)
+		{
+			int kEnd = M_GET_MIN(k0 + MATRIX_BLOCK, nk);
+
+			for(int x0=0; x0<nx; x0+=MATRIX_BLOCK)
+			{
+				int xEnd = M_GET_MIN(x0 + MATRIX_BLOCK, nx);
+
+				for(int y=y0; y<yEnd; y++)
+				{
+					double *c = C[y];
+
+					for(int k=k0; k<kEnd; k++)
+					{
+						double a = bTransposed ? A[k][y] : A[y][k];
+
+						if( a != 0. )
+						{
+							const double *b = B[k];
+
+							for(int x=x0; x<xEnd; x++)
+							{
+								c[x] += a * b[x];
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+// Same as SG_Matrix_Multiply_Add(), but expects all rows of
+// each matrix to follow each other in one memory block, as
+// CSG_Matrix keeps them, so that it can be passed to BLAS.
+
+static void	SG_Matrix_Multiply_Add_Contiguous	(int ny, int nx, int nk, const double **A, bool bTransposed, const double **B, double **C)
+{
+	#ifdef WITH_CBLAS
+	cblas_dgemm(CblasRowMajor, bTransposed ? CblasTrans : CblasNoTrans, CblasNoTrans, ny, nx, nk,
+		1., A[0], bTransposed ? ny : nk, B[0], nx, 1., C[0], nx
+	);
+	#else
+	SG_Matrix_Multiply_Add(ny, nx, nk, A, bTransposed, B, C);
+	#endif
+}
+
+//---------------------------------------------------------
+// T = A', A has ny rows and nx columns, copied block-wise.
+
+void		SG_Matrix_Transpose		(int ny, int nx, const double **A, double **T)
+{
+	#pragma omp parallel for if( (double)ny * nx >= MATRIX_PARALLEL )
+	for(int y0=0; y0<ny; y0+=MATRIX_BLOCK)
+	{
+		int yEnd = M_GET_MIN(y0 + MATRIX_BLOCK, ny);
+
+		for(int x0=0; x0<nx; x0+=MATRIX_BLOCK)
+		{
+			int xEnd = M_GET_MIN(x0 + MATRIX_BLOCK, nx);
+
+			for(int y=y0; y<yEnd; y++)
+			{
+				for(int x=x0; x<xEnd; x++)
+				{
+					T[x][y] = A[y][x];
+				}
+			}
+		}
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1526,13 +1628,16 @@ CSG_Vector CSG_Matrix::Multiply(const CSG_Vector &Vector) const
 
 	if( m_nx == Vector.Get_Size() && v.Create(m_ny) )
 	{
-		for(sLong y=0; y<m_ny; y++)
+		const double *b = Vector.Get_Data();
+
+		#pragma omp parallel for if( (double)m_nx * m_ny >= MATRIX_PARALLEL )
+		for(int y=0; y<(int)m_ny; y++)
 		{
-			double z = 0.;
+			const double *a = m_z[y]; double z = 0.;
 
 			for(sLong x=0; x<m_nx; x++)
 			{
-				z += m_z[y][x] * Vector(x);
+				z += a[x] * b[x];
 			}
 
 			v[y] = z;
@@ -1548,20 +1653,24 @@ CSG_Matrix CSG_Matrix::Multiply(const CSG_Matrix &Matrix) const
 
 	if( m_nx == Matrix.m_ny && m.Create(Matrix.m_nx, m_ny) )
 	{
-		for(int y=0; y<m.m_ny; y++)
-		{
-			for(int x=0; x<m.m_nx; x++)
-			{
-				double	z	= 0.;
+		SG_Matrix_Multiply_Add_Contiguous((int)m.m_ny, (int)m.m_nx, (int)m_nx, (const double **)m_z, false, (const double **)Matrix.m_z, m.m_z);
+	}
 
-				for(int n=0; n<m_nx; n++)
-				{
-					z	+= m_z[y][n] * Matrix.m_z[n][x];
-				}
+	return( m );
+}
 
-				m.m_z[y][x]	= z;
-			}
-		}
+//---------------------------------------------------------
+/**
+* Returns the product of this matrix' transpose with the given
+* matrix, i.e. (A' * B), without creating the transpose.
+*/
+CSG_Matrix CSG_Matrix::Multiply_Transposed(const CSG_Matrix &Matrix) const
+{
+	CSG_Matrix	m;
+
+	if( m_ny == Matrix.m_ny && m.Create(Matrix.m_nx, m_nx) )
+	{
+		SG_Matrix_Multiply_Add_Contiguous((int)m.m_ny, (int)m.m_nx, (int)m_ny, (const double **)m_z, true, (const double **)Matrix.m_z, m.m_z);
 	}
 
 	return( m );
@@ -1738,13 +1847,7 @@ bool CSG_Matrix::Set_Transpose(void)
 	
 	if( m.Create(*this) && Create(m_ny, m_nx) )
 	{
-		for(int y=0; y<m_ny; y++)
-		{
-			for(int x=0; x<m_nx; x++)
-			{
-				m_z[y][x]	= m.m_z[x][y];
-			}
-		}
+		SG_Matrix_Transpose((int)m.m_ny, (int)m.m_nx, (const double **)m.m_z, m_z);
 
 		return( true );
 	}
@@ -1776,20 +1879,21 @@ bool CSG_Matrix::Set_Inverse(bool bSilent, int nSubSquare)
 
 		if( SG_Matrix_LU_Decomposition(n, (int *)p.Get_Array(), m.Get_Data(), bSilent) )
 		{
-			CSG_Vector v(n);
+			CSG_Matrix t(n, n);	// solve the columns of the inverse as rows of its transpose
 
-			for(int j=0; j<n && (bSilent || SG_UI_Process_Set_Progress(j, n)); j++)
+			#pragma omp parallel for if( bSilent && (double)n * n * n >= MATRIX_PARALLEL )
+			for(int j=0; j<n; j++)
 			{
-				v.Set_Zero(); v[j] = 1.;
-
-				SG_Matrix_LU_Solve(n, (int *)p.Get_Array(), m, v.Get_Data(), true);
-
-				for(int i=0; i<n; i++)
+				if( bSilent || SG_UI_Process_Set_Progress(j, n) )
 				{
-					m_z[i][j] = v[i];
+					t[j][j] = 1.;
+
+					SG_Matrix_LU_Solve(n, (int *)p.Get_Array(), m, t[j], true);
 				}
 			}
 
+			SG_Matrix_Transpose(n, n, t, m_z);
+
 			return( true );
 		}
 	}
@@ -1830,13 +1934,7 @@ CSG_Matrix CSG_Matrix::Get_Transpose(void) const
 {
 	CSG_Matrix m(m_ny, m_nx);
 
-	for(sLong y=0; y<m_ny; y++)
-	{
-		for(sLong x=0; x<m_nx; x++)
-		{
-			m.m_z[x][y] = m_z[y][x];
-		}
-	}
+	SG_Matrix_Transpose((int)m_ny, (int)m_nx, (const double **)m_z, m.m_z);
 
 	return( m );
 }
@@ -1971,36 +2069,17 @@ bool		SG_Matrix_LU_Decomposition(int n, int *Permutation, double **Matrix, bool
 		Vector[i] = 1. / dMax;
 	}
 
-	int iMax = 0;
+	//-----------------------------------------------------
+	// right-looking elimination, updating the remaining rows
+	// with the pivot row, which runs along contiguous memory
 
 	for(int j=0; j<n && (bSilent || SG_UI_Process_Set_Progress(j, n)); j++)
 	{
-		for(int i=0; i<j; i++)
-		{
-			double Sum = Matrix[i][j];
-
-			for(int k=0; k<i; k++)
-			{
-				Sum -= Matrix[i][k] * Matrix[k][j];
-			}
-
-			Matrix[i][j] = Sum;
-		}
-
-		double dMax = 0.;
+		double dMax = 0.; int iMax = j;
 
 		for(int i=j; i<n; i++)
 		{
-			double Sum = Matrix[i][j];
-
-			for(int k=0; k<j; k++)
-			{
-				Sum -= Matrix[i][k] * Matrix[k][j];
-			}
-
-			Matrix[i][j] = Sum;
-
-			double d = Vector[i] * fabs(Sum);
+			double d = Vector[i] * fabs(Matrix[i][j]);
 
 			if( d >= dMax )
 			{
@@ -2030,13 +2109,19 @@ bool		SG_Matrix_LU_Decomposition(int n, int *Permutation, double **Matrix, bool
 			Matrix[j][j] = M_FLT_EPSILON;
 		}
 
-		if( j != n )
+		double d = 1. / (Matrix[j][j]); const double *Pivot = Matrix[j];
+
+		#pragma omp parallel for if( (double)(n - j) * (n - j) >= MATRIX_PARALLEL )
+		for(int i=j+1; i<n; i++)
 		{
-			double d = 1. / (Matrix[j][j]);
+			double *Row = Matrix[i], l = (Row[j] *= d);
 
-			for(int i=j+1; i<n; i++)
+			if( l != 0. )
 			{
-				Matrix[i][j] *= d;
+				for(int k=j+1; k<n; k++)
+				{
+					Row[k] -= l * Pivot[k];
+				}
 			}
 		}
 	}
@@ -2087,6 +2172,86 @@ bool		SG_Matrix_LU_Solve(int n, const int *Permutation, const double **Matrix, d
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Cholesky decomposition of a symmetric, positive definite matrix
+* into L * L'. Only the lower triangle of the matrix is read and
+* it is replaced by L, the upper triangle is set to zero. Returns
+* false if the matrix is not positive definite.
+*/
+bool		SG_Matrix_Cholesky_Decomposition(int n, double **Matrix, bool bSilent)
+{
+	for(int j=0; j<n && (bSilent || SG_UI_Process_Set_Progress(j, n)); j++)
+	{
+		double *Lj = Matrix[j], Sum = Lj[j];
+
+		for(int k=0; k<j; k++)
+		{
+			Sum -= Lj[k] * Lj[k];
+		}
+
+		if( Sum <= 0. )
+		{
+			return( false );
+		}
+
+		double d = 1. / (Lj[j] = sqrt(Sum));
+
+		#pragma omp parallel for if( (double)(n - j) * j >= MATRIX_PARALLEL )
+		for(int i=j+1; i<n; i++)
+		{
+			double *Li = Matrix[i], s = Li[j];
+
+			for(int k=0; k<j; k++)
+			{
+				s -= Li[k] * Lj[k];
+			}
+
+			Li[j] = s * d; Lj[i] = 0.;
+		}
+	}
+
+	return( bSilent || SG_UI_Process_Get_Okay(false) );
+}
+
+//---------------------------------------------------------
+/**
+* Solves L * L' * x = b with L as returned by
+* SG_Matrix_Cholesky_Decomposition(). The vector holds b on
+* input and is replaced by the solution x.
+*/
+bool		SG_Matrix_Cholesky_Solve(int n, const double **Matrix, double *Vector, bool bSilent)
+{
+	for(int i=0; i<n; i++)	// L * y = b
+	{
+		const double *Li = Matrix[i]; double Sum = Vector[i];
+
+		for(int k=0; k<i; k++)
+		{
+			Sum -= Li[k] * Vector[k];
+		}
+
+		Vector[i] = Sum / Li[i];
+	}
+
+	for(int i=n-1; i>=0 && (bSilent || SG_UI_Process_Set_Progress(n - i, n)); i--)	// L' * x = y
+	{
+		const double *Li = Matrix[i]; double x = (Vector[i] /= Li[i]);
+
+		for(int k=0; k<i; k++)
+		{
+			Vector[k] -= Li[k] * x;
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -2184,22 +2349,31 @@ bool SG_Matrix_Triangular_Decomposition(CSG_Matrix &A, CSG_Vector &d, CSG_Vector
 	d[0] = 0.;
 	e[0] = 0.;
 
+	CSG_Vector G(n);	// accumulate the transformations row-wise, so that the inner loops run along contiguous rows
+
 	for(int i=0, l=-1; i<n; i++, l++)
 	{
 		if( d[i] )
-		{	
-			for(int j=0; j<=l; j++)
+		{
+			G.Assign(0.);
+
+			for(int k=0; k<=l; k++)
 			{
-				double g = 0.;
+				double a = A[i][k]; const double *Ak = A[k];
 
-				for(int k=0; k<=l; k++)
+				for(int j=0; j<=l; j++)
 				{
-					g += A[i][k] * A[k][j];
+					G[j] += a * Ak[j];
 				}
+			}
 
-				for(int k=0; k<=l; k++)
+			for(int k=0; k<=l; k++)
+			{
+				double a = A[k][i]; double *Ak = A[k];
+
+				for(int j=0; j<=l; j++)
 				{
-					A[k][j] -= g * A[k][i];
+					Ak[j] -= G[j] * a;
 				}
 			}
 		}
@@ -2222,11 +2396,13 @@ bool SG_Matrix_Triangular_Decomposition(CSG_Matrix &A, CSG_Vector &d, CSG_Vector
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-// Tridiagonal QL algorithm -- Implicit
+// Tridiagonal QL algorithm -- Implicit. The rotations are
+// applied to the rows of the transposed eigenvector matrix,
+// which are contiguous in memory, not to its columns.
 
 bool SG_Matrix_Tridiagonal_QL(CSG_Matrix &Q, CSG_Vector &d, CSG_Vector &e)
 {
-	if( Q.Get_NX() != Q.Get_NY() || Q.Get_NX() != d.Get_N() || Q.Get_NX() != e.Get_N() )
+	if( Q.Get_NX() != Q.Get_NY() || Q.Get_NX() != d.Get_N() || Q.Get_NX() != e.Get_N() || !Q.Set_Transpose() )
 	{
 		return( false );
 	}
@@ -2298,11 +2474,13 @@ bool SG_Matrix_Tridiagonal_QL(CSG_Matrix &Q, CSG_Vector &d, CSG_Vector &e)
 					d[i+1]	= g + p;
 					g		= c * r - b;
 
+					double *Qi = Q[i], *Qj = Q[i + 1];
+
 					for(k=0; k<n; k++)
 					{
-						f			= Q[k][i+1];
-						Q[k][i+1]	= s * Q[k][i] + c * f;
-						Q[k][i]		= c * Q[k][i] - s * f;
+						f		= Qj[k];
+						Qj[k]	= s * Qi[k] + c * f;
+						Qi[k]	= c * Qi[k] - s * f;
 					}
 				}
 
@@ -2314,7 +2492,7 @@ bool SG_Matrix_Tridiagonal_QL(CSG_Matrix &Q, CSG_Vector &d, CSG_Vector &e)
 		while( m != l );
 	}
 
-	return( true );
+	return( Q.Set_Transpose() );
 }
 
 
@@ -621,7 +621,7 @@ bool CSG_Regression_Multiple::_Get_Regression(const CSG_Matrix &Samples)
 	//-----------------------------------------------------
 	Xt	= X.Get_Transpose();
 
-	C	= (Xt * X).Get_Inverse();
+	C	= X.Multiply_Transposed(X).Get_Inverse();
 
 	B	= C * (Xt * Y);
 
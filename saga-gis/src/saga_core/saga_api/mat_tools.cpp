@@ -558,6 +558,98 @@ void CSG_Simple_Statistics::Add_Value(double Value, double Weight)
 	}
 }
 
+//---------------------------------------------------------
+/**
+* Adds Count times the same value, e.g. when statistics are
+* derived from the value counts of an integer data set.
+*/
+void CSG_Simple_Statistics::Add_Values(double Value, sLong Count)
+{
+	if( Count < 1 )
+	{
+		return;
+	}
+
+	if( m_Values.Get_Value_Size() > 0 )
+	{
+		for(sLong i=0; i<Count; i++)
+		{
+			Add_Value(Value);
+		}
+
+		return;
+	}
+
+	if( m_nValues == 0 )
+	{
+		m_Minimum = m_Maximum = Value;
+	}
+	else if( m_Minimum > Value )
+	{
+		m_Minimum = Value;
+	}
+	else if( m_Maximum < Value )
+	{
+		m_Maximum = Value;
+	}
+
+	m_Weights += (double)Count;
+	m_Sum     += (double)Count * Value;
+	m_Sum2    += (double)Count * Value*Value;
+
+	m_nValues += Count;
+
+	m_bEvaluated = 0;
+}
+
+//---------------------------------------------------------
+/**
+* Removes a value that has been added before. Returns false,
+* if this is not possible without a recalculation from the
+* original data, i.e. if values are held or if the value is
+* the minimum or the maximum, which then might change.
+*/
+bool CSG_Simple_Statistics::Del_Value(double Value, double Weight)
+{
+	if( m_nValues < 1 || m_Values.Get_Value_Size() > 0 )
+	{
+		return( false );
+	}
+
+	if( m_nValues == 1 )
+	{
+		if( Value != m_Minimum )
+		{
+			return( false );
+		}
+
+		Invalidate();
+
+		return( true );
+	}
+
+	if( Value <= m_Minimum || Value >= m_Maximum )
+	{
+		return( false );
+	}
+
+	if( Weight )
+	{
+		m_Weights -= fabs(Weight);
+		m_Sum     -= Weight * Value;
+		m_Sum2    -= Weight * Value*Value;
+
+		m_Kurtosis = 0.;
+		m_Skewness = 0.;
+
+		m_bEvaluated = 0;
+
+		m_nValues--;
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 void CSG_Simple_Statistics::_Evaluate(int Level)
 {
@@ -1344,6 +1436,27 @@ void CSG_Histogram::Add_Value(double Value)
 	}
 }
 
+//---------------------------------------------------------
+/**
+* Adds Count times the same value. Call Update() when done.
+*/
+void CSG_Histogram::Add_Value(double Value, size_t Count)
+{
+	m_Statistics.Add_Values(Value, (sLong)Count);
+
+	if( m_nClasses > 0 && m_Minimum <= Value && Value <= m_Maximum )
+	{
+		size_t	Class	= (size_t)((Value - m_Minimum) / m_ClassWidth);
+
+		if( Class >= m_nClasses )
+		{
+			Class	= m_nClasses - 1;
+		}
+
+		m_Elements[Class]	+= Count;
+	}
+}
+
 //---------------------------------------------------------
 bool CSG_Histogram::Scale_Element_Count(double Scale)
 {
@@ -1636,14 +1749,44 @@ bool CSG_Histogram::Create(size_t nClasses, double Minimum, double Maximum, CSG_
 	}
 
 	//-----------------------------------------------------
-	for(sLong i=0; i<pGrid->Get_NCells(); i++)
+	// rows are distributed over threads, each counting into
+	// its own histogram, which are merged at the end
+
+	int	nThreads	= SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Histogram	*Histograms	= new CSG_Histogram[nThreads];
+
+	for(int i=0; i<nThreads; i++)
+	{
+		Histograms[i]._Create(m_nClasses, m_Minimum, m_Maximum);
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<pGrid->Get_NY(); y++)
+	{
+		CSG_Histogram	&Histogram	= Histograms[SG_OMP_Get_Thread_Num()];
+
+		for(int x=0; x<pGrid->Get_NX(); x++)
+		{
+			if( !pGrid->is_NoData(x, y) )
+			{
+				Histogram.Add_Value(pGrid->asDouble(x, y));
+			}
+		}
+	}
+
+	for(int i=0; i<nThreads; i++)
 	{
-		if( !pGrid->is_NoData(i) )
+		m_Statistics	+= Histograms[i].m_Statistics;
+
+		for(size_t j=0; j<m_nClasses; j++)
 		{
-			Add_Value(pGrid->asDouble(i));
+			m_Elements[j]	+= Histograms[i].m_Elements[j];
 		}
 	}
 
+	delete[](Histograms);
+
 	return( Update() );
 }
 
@@ -544,6 +544,7 @@ public:
 	bool						Multiply			(double Scalar);
 	CSG_Vector					Multiply			(const CSG_Vector &Vector)	const;
 	CSG_Matrix					Multiply			(const CSG_Matrix &Matrix)	const;
+	CSG_Matrix					Multiply_Transposed	(const CSG_Matrix &Matrix)	const;
 
 	bool						operator ==			(const CSG_Matrix &Matrix)	const;
 	CSG_Matrix &				operator =			(double Scalar);
@@ -594,6 +595,12 @@ SAGA_API_DLL_EXPORT CSG_Matrix	SG_Matrix_Get_Rotation		(double Rx, double Ry, do
 SAGA_API_DLL_EXPORT bool		SG_Matrix_LU_Decomposition	(int n,       int *Permutation,       double **Matrix                , bool bSilent = true, int *nRowChanges = NULL);
 SAGA_API_DLL_EXPORT bool		SG_Matrix_LU_Solve			(int n, const int *Permutation, const double **Matrix, double *Vector, bool bSilent = true);
 
+SAGA_API_DLL_EXPORT bool		SG_Matrix_Cholesky_Decomposition	(int n,                       double **Matrix                , bool bSilent = true);
+SAGA_API_DLL_EXPORT bool		SG_Matrix_Cholesky_Solve			(int n,                 const double **Matrix, double *Vector, bool bSilent = true);
+
+SAGA_API_DLL_EXPORT void		SG_Matrix_Multiply_Add		(int ny, int nx, int nk, const double **A, bool bTransposed, const double **B, double **C);
+SAGA_API_DLL_EXPORT void		SG_Matrix_Transpose			(int ny, int nx, const double **A, double **T);
+
 SAGA_API_DLL_EXPORT bool		SG_Matrix_Solve				(CSG_Matrix &Matrix, CSG_Vector &Vector, bool bSilent = true);
 SAGA_API_DLL_EXPORT bool		SG_Matrix_Eigen_Reduction	(const CSG_Matrix &Matrix, CSG_Matrix &Eigen_Vectors, CSG_Vector &Eigen_Values, bool bSilent = true);
 
@@ -770,6 +777,8 @@ public:
 	void						Add					(const CSG_Simple_Statistics &Statistics);
 
 	void						Add_Value			(double Value, double Weight = 1.);
+	void						Add_Values			(double Value, sLong Count);
+	bool						Del_Value			(double Value, double Weight = 1.);
 
 	double *					Get_Values			(void)		const	{	return( (double *)m_Values.Get_Array() );	}
 	double						Get_Value			(sLong i)	const	{	return( i >= 0 && i < (sLong)m_Values.Get_Size() ? Get_Values()[i] : m_Mean );	}
@@ -1035,6 +1044,7 @@ public:
 
 	//-----------------------------------------------------
 	void			Add_Value			(double Value);
+	void			Add_Value			(double Value, size_t Count);
 
 	bool			Scale_Element_Count	(double Scale);
 
@@ -1896,6 +1906,8 @@ public:
 	double						Get_Value			(double *Values, int nValues)	const;
 	double						Get_Value			(const char *Arguments, ... )	const;
 
+	bool						Get_Values			(const double **Values, int nValues, double *Result, sLong nResult)	const;
+
 	const char *				Get_Used_Variables	(void);
 
 
@@ -1943,9 +1955,16 @@ private:
 
 	double						m_Parameters[32], *m_ctable;
 
+	int							m_Program_Result, m_Program_Buffers;
+
+	CSG_Array					m_Program_Slots, m_Program_Steps;
+
 
 	void						_Set_Error			(const CSG_String &Error = "");
 
+	bool						_Compile			(void);
+	int							_Compile_Slot		(int Type, int Variable, double Value);
+
 	double						_Get_Value			(const double *Parameters, TSG_Formula Function)	const;
 
 	int							_is_Operand			(char c);
@@ -65,6 +65,8 @@
 
 #define PC_GET_NBYTES(type)	(type == SG_DATATYPE_String ? PC_STR_NBYTES : type == SG_DATATYPE_Date ? PC_DAT_NBYTES : (int)SG_Data_Type_Get_Size(type))
 
+#define PC_ARENA_CHUNK		16384	// number of points stored in one contiguous memory chunk
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -213,6 +215,8 @@ void CSG_PointCloud::_On_Construction(void)
 	}
 
 	m_Array_Points.Create(sizeof(char *), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_3);
+
+	m_Arena_nUsed  = 0;
 }
 
 //---------------------------------------------------------
@@ -514,14 +518,38 @@ bool CSG_PointCloud::_Load(CSG_File &Stream)
 	}
 
 	//-----------------------------------------------------
+	if( nPointBytes > m_nPointBytes - 1 )
+	{
+		return( false );
+	}
+
 	sLong fLength = Stream.Length();
 
-	while( _Inc_Array() && Stream.Read(m_Cursor + 1, nPointBytes) && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+	CSG_Array Buffer(nPointBytes, PC_ARENA_CHUNK); char *pBuffer = (char *)Buffer.Get_Array();
+
+	for(size_t nRead; (nRead = Stream.Read(pBuffer, nPointBytes, PC_ARENA_CHUNK)) > 0; )
 	{
-		// nop
+		for(size_t i=0; i<nRead; i++)
+		{
+			if( !_Inc_Array() )
+			{
+				SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s [%lld %s]", _TL("point cloud"), _TL("memory allocation failed"), (long long)m_nRecords, _TL("points")));
+
+				m_Cursor = NULL;
+
+				return( false );
+			}
+
+			memcpy(m_Cursor + 1, pBuffer + i * nPointBytes, nPointBytes);
+		}
+
+		if( nRead < PC_ARENA_CHUNK || !SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+		{
+			break;
+		}
 	}
 
-	_Dec_Array();
+	m_Cursor = NULL;
 
 	return( true );
 }
@@ -701,7 +729,14 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 		m_nPointBytes = 1;
 	}
 
-	m_nFields++; m_nPointBytes += nFieldBytes;
+	int Offset = Field < m_nFields ? m_Field_Offset[Field] : m_nPointBytes;
+
+	if( !_Arena_Set_Bytes(m_nPointBytes + nFieldBytes, Offset, nFieldBytes) )
+	{
+		return( false );
+	}
+
+	m_nFields++;
 
 	//-----------------------------------------------------
 	m_Field_Name   = (CSG_String            **)SG_Realloc(m_Field_Name  , m_nFields * sizeof(CSG_String            *));
@@ -725,22 +760,6 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 		m_Field_Offset[iField] = Offset; Offset+=m_Field_Size(iField);
 	}
 
-	//-----------------------------------------------------
-	int Offset = m_Field_Offset[Field], nMoveBytes = Field < m_nFields - 1 ? m_nPointBytes - m_Field_Offset[Field + 1] : 0;
-
-	#pragma omp parallel for
-	for(sLong i=0; i<m_nRecords; i++)
-	{
-		m_Points[i] = (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
-
-		if( nMoveBytes > 0 )
-		{
-			memmove(m_Points[i] + Offset + nFieldBytes, m_Points[i] + Offset, nMoveBytes);
-		}
-
-		memset(m_Points[i] + Offset, 0, nFieldBytes);
-	}
-
 	//-----------------------------------------------------
 	m_Shapes.Add_Field(Name, Type, Field);
 
@@ -763,22 +782,13 @@ bool CSG_PointCloud::Del_Field(int Index)
 	//-----------------------------------------------------
 	int nFieldBytes = PC_GET_NBYTES(m_Field_Type[Index]);
 
-	m_nFields--; m_nPointBytes -= nFieldBytes;
-
-	//-----------------------------------------------------
-	int Offset = m_Field_Offset[Index], nMoveBytes = Index < m_nFields ? (m_nPointBytes + nFieldBytes) - m_Field_Offset[Index + 1] : 0;
-
-	#pragma omp parallel for
-	for(sLong i=0; i<m_nRecords; i++)
+	if( !_Arena_Set_Bytes(m_nPointBytes - nFieldBytes, m_Field_Offset[Index], -nFieldBytes) )
 	{
-		if( nMoveBytes > 0 )
-		{
-			memmove(m_Points[i] + Offset, m_Points[i] + Offset + nFieldBytes, nMoveBytes);
-		}
-
-		m_Points[i] = (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
+		return( false );
 	}
 
+	m_nFields--;
+
 	//-----------------------------------------------------
 	delete(m_Field_Name [Index]);
 	delete(m_Field_Stats[Index]);
@@ -1152,10 +1162,7 @@ bool CSG_PointCloud::Del_Point(sLong Index)
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Points(void)
 {
-	for(sLong i=0; i<m_nRecords; i++)
-	{
-		SG_Free(m_Points[i]);
-	}
+	_Arena_Destroy();
 
 	m_Array_Points.Destroy();
 
@@ -1182,11 +1189,18 @@ bool CSG_PointCloud::Del_Points(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::_Inc_Array(void)
 {
-	if( m_nFields > 0 && m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
+	char *pPoint;
+
+	if( m_nFields > 0 && (pPoint = _Arena_Get_Point()) != NULL )
 	{
-		m_Points[m_nRecords++]	= m_Cursor	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
+		if( m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
+		{
+			m_Points[m_nRecords++]	= m_Cursor	= pPoint;
 
-		return( true );
+			return( true );
+		}
+
+		_Arena_Del_Point(pPoint);
 	}
 
 	return( false );
@@ -1201,7 +1215,7 @@ bool CSG_PointCloud::_Dec_Array(void)
 
 		m_Cursor	= NULL;
 
-		SG_Free(m_Points[m_nRecords]);
+		_Arena_Del_Point(m_Points[m_nRecords]);
 
 		m_Array_Points.Set_Array(m_nRecords, (void **)&m_Points);
 	}
@@ -1210,6 +1224,145 @@ bool CSG_PointCloud::_Dec_Array(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Point records are not allocated one by one but taken
+// from contiguous chunks of PC_ARENA_CHUNK records each.
+// Records of deleted points are kept for reuse.
+//---------------------------------------------------------
+char * CSG_PointCloud::_Arena_Get_Point(void)
+{
+	char *pPoint;
+
+	if( m_Arena_Free.Get_Size() > 0 )
+	{
+		pPoint = (char *)m_Arena_Free[m_Arena_Free.Get_Size() - 1]; m_Arena_Free.Dec_Array(false);
+	}
+	else
+	{
+		if( m_Arena_nUsed >= m_Arena.Get_Size() * PC_ARENA_CHUNK )
+		{
+			char *pChunk = (char *)SG_Malloc(PC_ARENA_CHUNK * (size_t)m_nPointBytes);
+
+			if( !pChunk || !m_Arena.Add(pChunk) )
+			{
+				SG_FREE_SAFE(pChunk);
+
+				return( NULL );
+			}
+		}
+
+		pPoint = (char *)m_Arena[m_Arena_nUsed / PC_ARENA_CHUNK] + (m_Arena_nUsed % PC_ARENA_CHUNK) * (size_t)m_nPointBytes;
+
+		m_Arena_nUsed++;
+	}
+
+	memset(pPoint, 0, m_nPointBytes);
+
+	return( pPoint );
+}
+
+//---------------------------------------------------------
+void CSG_PointCloud::_Arena_Del_Point(char *pPoint)
+{
+	if( pPoint )
+	{
+		m_Arena_Free.Add(pPoint);
+	}
+}
+
+//---------------------------------------------------------
+void CSG_PointCloud::_Arena_Destroy(void)
+{
+	for(sLong i=0; i<m_Arena.Get_Size(); i++)
+	{
+		SG_Free(m_Arena[i]);
+	}
+
+	m_Arena     .Destroy();
+	m_Arena_Free.Destroy();
+
+	m_Arena_nUsed = 0;
+}
+
+//---------------------------------------------------------
+// Changes the record size to nPointBytes, inserting
+// (nBytes > 0, zero initialized) or removing (nBytes < 0)
+// bytes at the given offset. All records are copied in
+// one pass to newly allocated, compacted chunks.
+//---------------------------------------------------------
+bool CSG_PointCloud::_Arena_Set_Bytes(int nPointBytes, int Offset, int nBytes)
+{
+	if( m_nRecords < 1 )
+	{
+		_Arena_Destroy(); m_nPointBytes = nPointBytes;
+
+		return( true );
+	}
+
+	sLong nChunks = (m_nRecords + PC_ARENA_CHUNK - 1) / PC_ARENA_CHUNK;
+
+	CSG_Array_Pointer Arena;
+
+	for(sLong i=0; i<nChunks; i++)
+	{
+		void *pChunk = SG_Malloc(PC_ARENA_CHUNK * (size_t)nPointBytes);
+
+		if( !pChunk || !Arena.Add(pChunk) )
+		{
+			SG_FREE_SAFE(pChunk);
+
+			for(sLong j=0; j<Arena.Get_Size(); j++)
+			{
+				SG_Free(Arena[j]);
+			}
+
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	int nTail = nBytes > 0 ? m_nPointBytes - Offset : m_nPointBytes - Offset + nBytes;
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		char *pSource = m_Points[i], *pTarget = (char *)Arena[i / PC_ARENA_CHUNK] + (i % PC_ARENA_CHUNK) * (size_t)nPointBytes;
+
+		memcpy(pTarget, pSource, Offset);
+
+		if( nBytes > 0 )
+		{
+			memset(pTarget + Offset, 0, nBytes);
+			memcpy(pTarget + Offset + nBytes, pSource + Offset, nTail);
+		}
+		else
+		{
+			memcpy(pTarget + Offset, pSource + Offset - nBytes, nTail);
+		}
+
+		m_Points[i] = pTarget;
+	}
+
+	//-----------------------------------------------------
+	_Arena_Destroy();
+
+	for(sLong i=0; i<Arena.Get_Size(); i++)
+	{
+		m_Arena.Add(Arena[i]);
+	}
+
+	m_Arena_nUsed = m_nRecords;
+	m_nPointBytes = nPointBytes;
+	m_Cursor      = NULL;
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //						Statistics						 //
@@ -1624,7 +1777,7 @@ sLong CSG_PointCloud::Del_Selection(void)
 		{
 			if( (m_Points[i][0] & SG_TABLE_REC_FLAG_Selected) != 0 )
 			{
-				SG_Free(m_Points[i]);
+				_Arena_Del_Point(m_Points[i]);
 			}
 			else
 			{
@@ -1682,11 +1835,9 @@ sLong CSG_PointCloud::Inv_Selection(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::Sort(const CSG_Index &Index)
 {
-	m_Points[m_nRecords++]	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
-
 	if( Get_Count() > 0 && Get_Count() == Index.Get_Count() )
 	{
-		char **Points = (char **)SG_Malloc(m_nBuffer * sizeof(char *)); memcpy(Points, m_Points, Get_Count());
+		char **Points = (char **)SG_Malloc(Get_Count() * sizeof(char *)); memcpy(Points, m_Points, Get_Count() * sizeof(char *));
 
 		for(sLong i=0; i<Get_Count(); i++)
 		{
@@ -251,6 +251,10 @@ private:
 	
 	CSG_Array						m_Array_Points;
 
+	sLong							m_Arena_nUsed;
+
+	CSG_Array_Pointer				m_Arena, m_Arena_Free;
+
 	CSG_Shapes						m_Shapes;
 
 
@@ -268,6 +272,11 @@ private:
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
+	char *							_Arena_Get_Point	(void);
+	void							_Arena_Del_Point	(char *pPoint);
+	void							_Arena_Destroy		(void);
+	bool							_Arena_Set_Bytes	(int nPointBytes, int Offset, int nBytes);
+
 	CSG_Shape *						_Shape_Get			(sLong Index);
 	void							_Shape_Flush		(void);
 
@@ -105,7 +105,8 @@ TSG_Vertex_Type CSG_Shape::Get_Vertex_Type(void) const
 inline void CSG_Shape::_Invalidate(void)
 {
 	((CSG_Shapes *)m_pTable)->Set_Update_Flag();
-	
+	((CSG_Shapes *)m_pTable)->_Index_Invalidate();
+
 	Set_Modified();
 }
 
@@ -198,6 +198,10 @@ void CSG_Shapes::_On_Construction(void)
 	m_Vertex_Type = SG_VERTEX_TYPE_XY;
 
 	m_Encoding    = SG_FILE_ENCODING_UTF8;
+
+	m_pIndex      = NULL;
+
+	_Index_Invalidate();
 }
 
 
@@ -325,6 +329,8 @@ bool CSG_Shapes::Create(TSG_Shape_Type Type, const SG_Char *Name, CSG_Table *pTe
 CSG_Shapes::~CSG_Shapes(void)
 {
 	Destroy();
+
+	Del_Spatial_Index();
 }
 
 //---------------------------------------------------------
@@ -379,6 +385,8 @@ bool CSG_Shapes::Assign(CSG_Data_Object *pObject)
 //---------------------------------------------------------
 CSG_Table_Record * CSG_Shapes::_Get_New_Record(sLong Index)
 {
+	_Index_Invalidate();
+
 	switch( m_Type )
 	{
 	case SHAPE_TYPE_Polygon     : return( new CSG_Shape_Polygon (this, Index) );
@@ -422,6 +430,22 @@ bool CSG_Shapes::Del_Shape(sLong Index)
 	return( Del_Record(Index) );
 }
 
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Record(sLong Index)
+{
+	_Index_Invalidate();
+
+	return( CSG_Table::Del_Record(Index) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Records(void)
+{
+	_Index_Invalidate();
+
+	return( CSG_Table::Del_Records() );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -484,29 +508,26 @@ CSG_Shape * CSG_Shapes::Get_Shape(const CSG_Point &Point, double Epsilon)
 {
 	CSG_Rect r(Point.x - Epsilon, Point.y - Epsilon, Point.x + Epsilon, Point.y + Epsilon);
 
-	CSG_Shape *pNearest = NULL;
+	CSG_Shape *pNearest = NULL; CSG_Array_sLong Shapes;
 
-	if( r.Intersects(Get_Extent()) != INTERSECTION_None )
+	if( Get_Shapes(r, Shapes) > 0 )
 	{
 		double dNearest = -1.;
 
-		for(sLong iShape=0; iShape<Get_Count(); iShape++)
+		for(sLong i=0; i<Shapes.Get_Size(); i++)
 		{
-			CSG_Shape *pShape = Get_Shape(iShape);
+			CSG_Shape *pShape = Get_Shape(Shapes[i]);
 
-			if( pShape->Intersects(r) )
-			{
-				double d = pShape->Get_Distance(Point);
+			double d = pShape->Get_Distance(Point);
 
-				if( d == 0. )
-				{
-					return( pShape );
-				}
-				else if( d > 0. && d <= Epsilon && (pNearest == NULL || d < dNearest) )
-				{
-					dNearest = d;
-					pNearest = pShape;
-				}
+			if( d == 0. )
+			{
+				return( pShape );
+			}
+			else if( d > 0. && d <= Epsilon && (pNearest == NULL || d < dNearest) )
+			{
+				dNearest = d;
+				pNearest = pShape;
 			}
 		}
 	}
@@ -823,10 +823,23 @@ public:
 	virtual bool					Del_Shape				(CSG_Shape *pShape);
 	virtual bool					Del_Shapes				(void)					{	return( Del_Records() );	}
 
+	virtual bool					Del_Record				(sLong Index);
+	virtual bool					Del_Records				(void);
+
 	virtual CSG_Shape *				Get_Shape				(const CSG_Point &Point, double Epsilon = 0.);
 	virtual CSG_Shape *				Get_Shape				(sLong Index)	const	{	return( (CSG_Shape *)Get_Record        (Index) );	}
 	virtual CSG_Shape *				Get_Shape_byIndex		(sLong Index)	const	{	return( (CSG_Shape *)Get_Record_byIndex(Index) );	}
 
+	CSG_Shape *						Get_Shape_Nearest		(const CSG_Point &Point, double maxDistance = -1., double *Distance = NULL);
+
+	sLong							Get_Shapes				(const CSG_Rect  &Extent, CSG_Array_sLong &Shapes);
+	sLong							Get_Shapes				(const CSG_Point &Point , CSG_Array_sLong &Shapes);
+
+	//-----------------------------------------------------
+	bool							Set_Spatial_Index		(void);
+	bool							Del_Spatial_Index		(void);
+	bool							has_Spatial_Index		(void)	const			{	return( m_pIndex && m_Index_bValid );	}
+
 	//-----------------------------------------------------
 	bool							Make_Clean				(void);
 
@@ -862,6 +875,17 @@ protected:
 
 private:
 
+	bool							m_Index_bValid;
+
+	int								m_Index_nRequests;
+
+	class CSG_Shapes_RTree			*m_pIndex;
+
+
+	void							_Index_Invalidate		(void)	{	m_Index_bValid = false; m_Index_nRequests = 0;	}
+	class CSG_Shapes_RTree *		_Index_Get				(void);
+	bool							_Index_Create			(void);
+
 	bool							_Load_GDAL				(const CSG_String &File);
 	bool							_Save_GDAL				(const CSG_String &File, const CSG_String &Driver);
 
@@ -1303,6 +1327,9 @@ public:
 	virtual size_t				Get_Duplicates		(double x, double y, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual size_t				Get_Duplicates		(double x, double y);
 
+	bool						Get_Nearest_Points	(const double *Coordinates, size_t nQueries, size_t Count, double Radius, sLong *Indices, double *Distances, size_t *nMatches = NULL)	const;
+	bool						Get_Nearest_Points	(const double *Coordinates, size_t nQueries, double Radius, CSG_Array_sLong &Offsets, CSG_Array_sLong &Indices, CSG_Vector &Distances, bool bSorted = false)	const;
+
 };
 
 
@@ -1354,6 +1381,9 @@ public:
 	virtual size_t				Get_Duplicates		(double x, double y, double z, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual size_t				Get_Duplicates		(double x, double y, double z);
 
+	bool						Get_Nearest_Points	(const double *Coordinates, size_t nQueries, size_t Count, double Radius, sLong *Indices, double *Distances, size_t *nMatches = NULL)	const;
+	bool						Get_Nearest_Points	(const double *Coordinates, size_t nQueries, double Radius, CSG_Array_sLong &Offsets, CSG_Array_sLong &Indices, CSG_Vector &Distances, bool bSorted = false)	const;
+
 };
 
 
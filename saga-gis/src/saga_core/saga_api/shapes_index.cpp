@@ -0,0 +1,530 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  shapes_index.cpp                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <vector>
+#include <queue>
+#include <algorithm>
+
+#include "shapes.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						R-Tree							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define RTREE_NODE_SIZE		16	// maximum number of entries per node
+
+//---------------------------------------------------------
+/**
+  * Sort-Tile-Recursive (STR) bulk loaded R-tree on the
+  * extents of a shapes layer. It only stores shape indices
+  * and has to be rebuilt whenever the layer's geometries
+  * have been changed.
+*/
+//---------------------------------------------------------
+class CSG_Shapes_RTree
+{
+public:
+
+	bool						Create			(CSG_Shapes *pShapes);
+
+	sLong						Get_Candidates	(const TSG_Rect &Extent, CSG_Array_sLong &Shapes)	const;
+
+	sLong						Get_Nearest		(CSG_Shapes *pShapes, const CSG_Point &Point, double maxDistance, double &Distance)	const;
+
+
+private:
+
+	typedef struct SNode
+	{
+		TSG_Rect				r;
+
+		sLong					First, Count;	// shape index of an item or range of child entries
+
+		bool					bLeaf;			// children are found in items array
+	}
+	TNode;
+
+	typedef struct SCandidate
+	{
+		double					d;
+
+		sLong					i;
+
+		int						Type;			// 0 = node, 1 = shape (box distance), 2 = shape (exact distance)
+
+		bool					operator <		(const SCandidate &c)	const	{	return( d > c.d || (d == c.d && i > c.i) );	}
+	}
+	TCandidate;
+
+
+	std::vector<TNode>			m_Items, m_Nodes;	// the root is the last node
+
+
+	static bool					_Compare_X		(const TNode &a, const TNode &b)	{	return( a.r.xMin + a.r.xMax < b.r.xMin + b.r.xMax );	}
+	static bool					_Compare_Y		(const TNode &a, const TNode &b)	{	return( a.r.yMin + a.r.yMax < b.r.yMin + b.r.yMax );	}
+
+	static void					_Sort			(std::vector<TNode> &Entries);
+	static void					_Pack			(const std::vector<TNode> &Entries, size_t Offset, bool bLeaf, std::vector<TNode> &Nodes);
+
+	static bool					_Intersects		(const TSG_Rect &a, const TSG_Rect &b)
+	{
+		return( a.xMin <= b.xMax && b.xMin <= a.xMax && a.yMin <= b.yMax && b.yMin <= a.yMax );
+	}
+
+	static double				_Get_Distance	(const TSG_Rect &r, const CSG_Point &p)
+	{
+		double	dx	= p.x < r.xMin ? r.xMin - p.x : p.x > r.xMax ? p.x - r.xMax : 0.;
+		double	dy	= p.y < r.yMin ? r.yMin - p.y : p.y > r.yMax ? p.y - r.yMax : 0.;
+
+		return( sqrt(dx*dx + dy*dy) );
+	}
+
+};
+
+//---------------------------------------------------------
+void CSG_Shapes_RTree::_Sort(std::vector<TNode> &Entries)
+{
+	size_t	n	= Entries.size(), nNodes = (n + RTREE_NODE_SIZE - 1) / RTREE_NODE_SIZE;
+
+	size_t	nSlice	= RTREE_NODE_SIZE * (size_t)ceil(sqrt((double)nNodes));
+
+	std::sort(Entries.begin(), Entries.end(), _Compare_X);
+
+	for(size_t i=0; i<n; i+=nSlice)
+	{
+		std::sort(Entries.begin() + i, Entries.begin() + (i + nSlice < n ? i + nSlice : n), _Compare_Y);
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Shapes_RTree::_Pack(const std::vector<TNode> &Entries, size_t Offset, bool bLeaf, std::vector<TNode> &Nodes)
+{
+	Nodes.clear();
+
+	for(size_t i=0; i<Entries.size(); i+=RTREE_NODE_SIZE)
+	{
+		TNode	Node;
+
+		Node.First	= (sLong)(Offset + i);
+		Node.Count	= (sLong)(i + RTREE_NODE_SIZE < Entries.size() ? RTREE_NODE_SIZE : Entries.size() - i);
+		Node.bLeaf	= bLeaf;
+		Node.r		= Entries[i].r;
+
+		for(sLong j=1; j<Node.Count; j++)
+		{
+			const TSG_Rect	&r	= Entries[i + j].r;
+
+			if( Node.r.xMin > r.xMin ) { Node.r.xMin = r.xMin; }	if( Node.r.xMax < r.xMax ) { Node.r.xMax = r.xMax; }
+			if( Node.r.yMin > r.yMin ) { Node.r.yMin = r.yMin; }	if( Node.r.yMax < r.yMax ) { Node.r.yMax = r.yMax; }
+		}
+
+		Nodes.push_back(Node);
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes_RTree::Create(CSG_Shapes *pShapes)
+{
+	m_Items.clear();
+	m_Nodes.clear();
+
+	m_Items.reserve((size_t)pShapes->Get_Count());
+
+	for(sLong iShape=0; iShape<pShapes->Get_Count(); iShape++)
+	{
+		CSG_Shape	*pShape	= pShapes->Get_Shape(iShape);
+
+		if( pShape->Get_Point_Count() > 0 )
+		{
+			TNode	Item;
+
+			Item.r		= pShape->Get_Extent();
+			Item.First	= iShape;
+			Item.Count	= 0;
+			Item.bLeaf	= false;
+
+			m_Items.push_back(Item);
+		}
+	}
+
+	if( m_Items.size() > 0 )
+	{
+		std::vector<TNode>	Level;
+
+		_Sort(m_Items); _Pack(m_Items, 0, true, Level);
+
+		while( Level.size() > 1 )
+		{
+			std::vector<TNode>	Parents;
+
+			_Sort(Level); _Pack(Level, m_Nodes.size(), false, Parents);
+
+			m_Nodes.insert(m_Nodes.end(), Level.begin(), Level.end());
+
+			Level	= Parents;
+		}
+
+		m_Nodes.push_back(Level[0]);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+sLong CSG_Shapes_RTree::Get_Candidates(const TSG_Rect &Extent, CSG_Array_sLong &Shapes)	const
+{
+	Shapes.Destroy();
+
+	if( m_Nodes.size() > 0 )
+	{
+		std::vector<sLong>	Stack(1, (sLong)m_Nodes.size() - 1);
+
+		while( Stack.size() > 0 )
+		{
+			const TNode	&Node	= m_Nodes[Stack.back()]; Stack.pop_back();
+
+			if( _Intersects(Node.r, Extent) )
+			{
+				for(sLong i=Node.First; i<Node.First+Node.Count; i++)
+				{
+					if( Node.bLeaf )
+					{
+						if( _Intersects(m_Items[i].r, Extent) )
+						{
+							Shapes.Add(m_Items[i].First);
+						}
+					}
+					else
+					{
+						Stack.push_back(i);
+					}
+				}
+			}
+		}
+
+		std::sort(Shapes.Get_Array(), Shapes.Get_Array() + Shapes.Get_Size());	// keep the layer's order
+	}
+
+	return( Shapes.Get_Size() );
+}
+
+//---------------------------------------------------------
+sLong CSG_Shapes_RTree::Get_Nearest(CSG_Shapes *pShapes, const CSG_Point &Point, double maxDistance, double &Distance)	const
+{
+	if( m_Nodes.size() < 1 )
+	{
+		return( -1 );
+	}
+
+	std::priority_queue<TCandidate>	Queue;
+
+	TCandidate	c; c.d = 0.; c.i = (sLong)m_Nodes.size() - 1; c.Type = 0; Queue.push(c);
+
+	while( !Queue.empty() )
+	{
+		c	= Queue.top(); Queue.pop();
+
+		if( c.Type == 2 )	// nearest exact distance, no other entry can be closer
+		{
+			Distance	= c.d;
+
+			return( c.i );
+		}
+
+		if( c.Type == 1 )
+		{
+			c.d	= pShapes->Get_Shape(c.i)->Get_Distance(Point);
+
+			if( c.d >= 0. && (maxDistance < 0. || c.d <= maxDistance) )
+			{
+				c.Type	= 2; Queue.push(c);
+			}
+
+			continue;
+		}
+
+		const TNode	&Node	= m_Nodes[c.i];
+
+		for(sLong i=Node.First; i<Node.First+Node.Count; i++)
+		{
+			TCandidate	Child;
+
+			Child.d	= _Get_Distance(Node.bLeaf ? m_Items[i].r : m_Nodes[i].r, Point);
+
+			if( maxDistance < 0. || Child.d <= maxDistance )
+			{
+				Child.i		= Node.bLeaf ? m_Items[i].First : i;
+				Child.Type	= Node.bLeaf ? 1 : 0;
+
+				Queue.push(Child);
+			}
+		}
+	}
+
+	return( -1 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Spatial Index						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define INDEX_MIN_COUNT		64	// smaller layers are always searched sequentially
+
+//---------------------------------------------------------
+/**
+  * Builds the spatial index immediately. Otherwise it is
+  * created on demand by the second spatial query following
+  * a modification, so that alternating edits and queries
+  * do not cause a rebuild each time. Point clouds are not
+  * indexed.
+*/
+bool CSG_Shapes::Set_Spatial_Index(void)
+{
+	if( Get_ObjectType() != SG_DATAOBJECT_TYPE_Shapes )
+	{
+		return( false );
+	}
+
+	bool	bValid;
+
+	#pragma omp critical(CSG_Shapes_Index)	// the index state is only accessed under this lock
+	{
+		bValid	= _Index_Create();
+	}
+
+	return( bValid );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Index_Create(void)	// to be called under the lock only
+{
+	if( !m_Index_bValid )
+	{
+		if( !m_pIndex )
+		{
+			m_pIndex	= new CSG_Shapes_RTree;
+		}
+
+		m_Index_bValid	= m_pIndex->Create(this);
+	}
+
+	return( m_Index_bValid );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Spatial_Index(void)
+{
+	#pragma omp critical(CSG_Shapes_Index)
+	{
+		_Index_Invalidate();
+
+		if( m_pIndex )
+		{
+			delete(m_pIndex);
+
+			m_pIndex	= NULL;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+CSG_Shapes_RTree * CSG_Shapes::_Index_Get(void)
+{
+	if( Get_Count() < INDEX_MIN_COUNT )
+	{
+		return( NULL );
+	}
+
+	CSG_Shapes_RTree	*pIndex	= NULL;
+
+	#pragma omp critical(CSG_Shapes_Index)
+	{
+		if( m_Index_bValid || (m_Index_nRequests++ >= 1 && _Index_Create()) )
+		{
+			pIndex	= m_pIndex;
+		}
+	}
+
+	return( pIndex );
+}
+
+//---------------------------------------------------------
+static sLong SG_Shapes_Get_Candidates(CSG_Shapes *pShapes, CSG_Shapes_RTree *pIndex, const CSG_Rect &Extent, CSG_Array_sLong &Shapes)
+{
+	if( pIndex )
+	{
+		return( pIndex->Get_Candidates(Extent, Shapes) );
+	}
+
+	Shapes.Destroy();
+
+	for(sLong iShape=0; iShape<pShapes->Get_Count(); iShape++)
+	{
+		Shapes.Add(iShape);
+	}
+
+	return( Shapes.Get_Size() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Collects the indices of all shapes intersecting the
+  * given extent in ascending order. Returns their number.
+*/
+sLong CSG_Shapes::Get_Shapes(const CSG_Rect &Extent, CSG_Array_sLong &Shapes)
+{
+	sLong	n	= 0;
+
+	if( Extent.Intersects(Get_Extent()) != INTERSECTION_None )
+	{
+		SG_Shapes_Get_Candidates(this, _Index_Get(), Extent, Shapes);
+
+		for(sLong i=0; i<Shapes.Get_Size(); i++)
+		{
+			if( Get_Shape(Shapes[i])->Intersects(Extent) )
+			{
+				Shapes[n++]	= Shapes[i];
+			}
+		}
+	}
+
+	Shapes.Set_Array(n);
+
+	return( n );
+}
+
+//---------------------------------------------------------
+/**
+  * Collects the indices of all shapes covering the given
+  * point, i.e. polygons containing it and other shapes
+  * whose geometry touches it, in ascending order.
+*/
+sLong CSG_Shapes::Get_Shapes(const CSG_Point &Point, CSG_Array_sLong &Shapes)
+{
+	if( Get_Type() != SHAPE_TYPE_Polygon )
+	{
+		return( Get_Shapes(CSG_Rect(Point, Point), Shapes) );
+	}
+
+	sLong	n	= 0;
+
+	if( Get_Extent().Contains(Point) )
+	{
+		SG_Shapes_Get_Candidates(this, _Index_Get(), CSG_Rect(Point, Point), Shapes);
+
+		for(sLong i=0; i<Shapes.Get_Size(); i++)
+		{
+			if( Get_Shape(Shapes[i])->asPolygon()->Contains(Point) )
+			{
+				Shapes[n++]	= Shapes[i];
+			}
+		}
+	}
+
+	Shapes.Set_Array(n);
+
+	return( n );
+}
+
+//---------------------------------------------------------
+/**
+  * Returns the shape nearest to the given point or NULL if
+  * the layer is empty or no shape is found within the
+  * maximum distance. A negative maximum distance means no
+  * limit. Polygons containing the point have zero distance.
+*/
+CSG_Shape * CSG_Shapes::Get_Shape_Nearest(const CSG_Point &Point, double maxDistance, double *Distance)
+{
+	CSG_Shapes_RTree	*pIndex	= _Index_Get();
+
+	sLong	iNearest	= -1;	double	dNearest	= -1.;
+
+	if( pIndex )
+	{
+		iNearest	= pIndex->Get_Nearest(this, Point, maxDistance, dNearest);
+	}
+	else for(sLong iShape=0; iShape<Get_Count(); iShape++)
+	{
+		double	d	= Get_Shape(iShape)->Get_Distance(Point);
+
+		if( d >= 0. && (maxDistance < 0. || d <= maxDistance) && (iNearest < 0 || d < dNearest) )
+		{
+			iNearest	= iShape;
+			dNearest	= d;
+		}
+	}
+
+	if( Distance )
+	{
+		*Distance	= dNearest;
+	}
+
+	return( iNearest >= 0 ? Get_Shape(iNearest) : NULL );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
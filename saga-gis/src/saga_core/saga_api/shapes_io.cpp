@@ -55,6 +55,15 @@
 #include "tool_library.h"
 #include "data_manager.h"
 
+#if defined(_SAGA_MSW)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -260,13 +269,268 @@ bool CSG_Shapes::_Save_GDAL(const CSG_String &File_Name, const CSG_String &Drive
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+/**
+* Read-only view of a file's content. The file is memory mapped
+* if possible, otherwise it is read into memory at once.
+*/
+//---------------------------------------------------------
+class CSG_Shapes_File_View
+{
+public:
+	CSG_Shapes_File_View(void)	{	m_pData = NULL; m_Size = 0; m_bMapped = false;	}
+	~CSG_Shapes_File_View(void)	{	Close();	}
+
+	//-----------------------------------------------------
+	bool				Open		(const CSG_String &File)
+	{
+		Close();
+
+		if( !SG_File_Exists(File) )
+		{
+			return( false );
+		}
+
+	#if defined(_SAGA_MSW)
+		HANDLE	hFile	= CreateFileW(File.w_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+		if( hFile != INVALID_HANDLE_VALUE )
+		{
+			LARGE_INTEGER	Size;
+
+			if( GetFileSizeEx(hFile, &Size) && Size.QuadPart > 0 )
+			{
+				HANDLE	hMap	= CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+				if( hMap != NULL )
+				{
+					if( (m_pData = (char *)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0)) != NULL )
+					{
+						m_Size	= (size_t)Size.QuadPart;	m_bMapped	= true;
+					}
+
+					CloseHandle(hMap);	// the view keeps a reference to the mapping object
+				}
+			}
+
+			CloseHandle(hFile);
+		}
+	#else
+		int		hFile	= open(File.b_str(), O_RDONLY);
+
+		if( hFile >= 0 )
+		{
+			struct stat	FileStat;
+
+			if( !fstat(hFile, &FileStat) && FileStat.st_size > 0 )
+			{
+				void	*pData	= mmap(NULL, (size_t)FileStat.st_size, PROT_READ, MAP_SHARED, hFile, 0);
+
+				if( pData != MAP_FAILED )
+				{
+					madvise(pData, (size_t)FileStat.st_size, MADV_SEQUENTIAL);
+
+					m_pData	= (char *)pData;	m_Size	= (size_t)FileStat.st_size;	m_bMapped	= true;
+				}
+			}
+
+			close(hFile);	// the mapping keeps a reference to the file
+		}
+	#endif
+
+		//-------------------------------------------------
+		if( !m_bMapped )
+		{
+			CSG_File	Stream;
+
+			if( Stream.Open(File, SG_FILE_R, true) && Stream.Length() > 0
+			&&  (m_pData = (char *)SG_Malloc((size_t)Stream.Length())) != NULL )
+			{
+				m_Size	= Stream.Read(m_pData, sizeof(char), (size_t)Stream.Length());
+			}
+		}
+
+		return( m_pData != NULL );
+	}
+
+	//-----------------------------------------------------
+	void				Close		(void)
+	{
+		if( m_pData )
+		{
+			if( m_bMapped )
+			{
+			#if defined(_SAGA_MSW)
+				UnmapViewOfFile(m_pData);
+			#else
+				munmap(m_pData, m_Size);
+			#endif
+			}
+			else
+			{
+				SG_Free(m_pData);
+			}
+		}
+
+		m_pData = NULL; m_Size = 0; m_bMapped = false;
+	}
+
+	//-----------------------------------------------------
+	const char *		Get_Data	(size_t Offset = 0)	const	{	return( m_pData + Offset );	}
+	size_t				Get_Size	(void)				const	{	return( m_Size );	}
+
+	int					asInt		(size_t Offset, bool bBigEndian = false)	const
+	{
+		int	Value;	memcpy(&Value, m_pData + Offset, sizeof(int));
+
+		if( bBigEndian )
+		{
+			SG_Swap_Bytes(&Value, sizeof(int));
+		}
+
+		return( Value );
+	}
+
+
+private:
+
+	bool				m_bMapped;
+
+	char				*m_pData;
+
+	size_t				m_Size;
+
+};
+
+//---------------------------------------------------------
+#define SHP_CHUNK	4096	// number of records decoded in parallel between two progress updates
+
+//---------------------------------------------------------
+/**
+* Decodes the content of a shapefile record. Coordinates are
+* copied, because record contents are not necessarily aligned.
+*/
+//---------------------------------------------------------
+static bool SG_Shapes_ESRI_Decode(CSG_Shape *pShape, const char *Content, size_t Length, TSG_Shape_Type Type, TSG_Vertex_Type Vertex_Type)
+{
+	#define SHP_INT(offset)		(memcpy(&i, Content + (offset), sizeof(int   )), i)
+	#define SHP_DBL(offset)		(memcpy(&d, Content + (offset), sizeof(double)), d)
+
+	int	i;	double	d;
+
+	switch( Type )
+	{
+	default:
+		return( false );
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Point:
+		if( Length < 20 || (Vertex_Type != SG_VERTEX_TYPE_XY && Length < 28) )
+		{
+			return( false );
+		}
+
+		pShape->Add_Point(SHP_DBL(4), SHP_DBL(12));
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		default:	break;
+		case SG_VERTEX_TYPE_XYZM: if( Length >= 36 ) pShape->Set_M(SHP_DBL(28), 0);
+		case SG_VERTEX_TYPE_XYZ : pShape->Set_Z(SHP_DBL(20), 0);
+		}
+
+		return( true );
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Points:
+	{
+		int	nPoints	= Length >= 40 ? SHP_INT(36) : -1;
+
+		if( nPoints < 0 || 40 + (size_t)nPoints * 16 > Length )
+		{
+			return( false );
+		}
+
+		size_t	oZ	= 0, oM	= 0;
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		default:
+			break;
+
+		case SG_VERTEX_TYPE_XYZM:
+			oM	= 72 + (size_t)nPoints * 32 <= Length ? 72 + (size_t)nPoints * 24 : 0;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] + [nPoints * 8]
+		case SG_VERTEX_TYPE_XYZ:
+			oZ	= 56 + (size_t)nPoints * 24 <= Length ? 56 + (size_t)nPoints * 16 : 0;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			break;
+		}
+
+		for(int iPoint=0; iPoint<nPoints; iPoint++)
+		{
+			pShape->Add_Point(SHP_DBL(40 + iPoint * 16), SHP_DBL(48 + iPoint * 16));
+
+			if( oZ )	{	pShape->Set_Z(SHP_DBL(oZ + iPoint * 8), iPoint);	}
+			if( oM )	{	pShape->Set_M(SHP_DBL(oM + iPoint * 8), iPoint);	}
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Line   :
+	case SHAPE_TYPE_Polygon:
+	{
+		int	nParts	= Length >= 44 ? SHP_INT(36) : -1;
+		int	nPoints	= Length >= 44 ? SHP_INT(40) : -1;
+
+		if( nParts < 0 || nPoints < 0 || 44 + (size_t)nParts * 4 + (size_t)nPoints * 16 > Length )
+		{
+			return( false );
+		}
+
+		size_t	oParts	= 44, oPoints = 44 + (size_t)nParts * 4, oZ = 0, oM = 0;
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		default:
+			break;
+
+		case SG_VERTEX_TYPE_XYZM:
+			oM	= oPoints + 32 + (size_t)nPoints * 32 <= Length ? oPoints + 32 + (size_t)nPoints * 24 : 0;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] +  [nPoints * 8]
+		case SG_VERTEX_TYPE_XYZ:
+			oZ	= oPoints + 16 + (size_t)nPoints * 24 <= Length ? oPoints + 16 + (size_t)nPoints * 16 : 0;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			break;
+		}
+
+		int	iPart	= 0, iOffset = 0, Next = nParts > 1 ? SHP_INT(oParts + 4) : nPoints;
+
+		for(int iPoint=0; iPoint<nPoints; iPoint++)
+		{
+			if( iPart < nParts - 1 && iPoint >= Next )
+			{
+				iPart++; iOffset = 0; Next = iPart < nParts - 1 ? SHP_INT(oParts + 4 * (iPart + 1)) : nPoints;
+			}
+
+			pShape->Add_Point(SHP_DBL(oPoints + iPoint * 16), SHP_DBL(oPoints + iPoint * 16 + 8), iPart);
+
+			if( oZ )	{	pShape->Set_Z(SHP_DBL(oZ + iPoint * 8), iOffset, iPart);	}
+			if( oM )	{	pShape->Set_M(SHP_DBL(oM + iPoint * 8), iOffset, iPart);	}
+
+			iOffset++;
+		}
+
+		return( true );
+	}
+	}
+
+	#undef SHP_INT
+	#undef SHP_DBL
+}
+
 //---------------------------------------------------------
 bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 {
-	int				Type, iField, iPart, nParts, *Parts, iPoint, nPoints, iOffset;
-	double			*pZ	= NULL, *pM	= NULL;
-	TSG_Point		*pPoint;
-	CSG_Buffer		File_Header(100), Record_Header(8), Content;
+	int				Type;
 	CSG_File		fSHP;
 
 	//-----------------------------------------------------
@@ -307,38 +571,47 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 	//-----------------------------------------------------
 	// Open Shapes File...
 
-	if( !fSHP.Open(SG_File_Make_Path("", File_Name, "shp"), SG_FILE_R, true) )
+	CSG_Shapes_File_View	SHP, SHX, DBF;
+
+	if( !SHP.Open(SG_File_Make_Path("", File_Name, "shp")) )
 	{
 		SG_UI_Msg_Add_Error(_TL("Shape file could not be opened."));
 
 		return( false );
 	}
 
+	if( !DBF.Open(SG_File_Make_Path("", File_Name, "dbf")) )
+	{
+		SG_UI_Msg_Add_Error(_TL("DBase file could not be opened."));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	// Read File Header (100 Bytes)...
 
-	if( fSHP.Read(File_Header.Get_Data(), sizeof(char), 100) != 100 )
+	if( SHP.Get_Size() < 100 )
 	{
 		SG_UI_Msg_Add_Error(_TL("corrupted file header"));
 
 		return( false );
 	}
 
-	if( File_Header.asInt( 0,  true) != 9994 )	// Byte 00 -> File Code 9994 (Integer Big)...
+	if( SHP.asInt( 0,  true) != 9994 )	// Byte 00 -> File Code 9994 (Integer Big)...
 	{
 		SG_UI_Msg_Add_Error(_TL("invalid file code"));
 
 		return( false );
 	}
 
-	if( File_Header.asInt(28, false) != 1000 )	// Byte 28 -> Version 1000 (Integer Little)...
+	if( SHP.asInt(28, false) != 1000 )	// Byte 28 -> Version 1000 (Integer Little)...
 	{
 		SG_UI_Msg_Add_Error(_TL("unsupported file version"));
 
 		return( false );
 	}
 
-	switch( Type = File_Header.asInt(32) )	// Byte 32 -> Shape Type (Integer Little)...
+	switch( Type = SHP.asInt(32) )	// Byte 32 -> Shape Type (Integer Little)...
 	{
 	case 1:		m_Type	= SHAPE_TYPE_Point;		m_Vertex_Type	= SG_VERTEX_TYPE_XY;	break;	// Point
 	case 8:		m_Type	= SHAPE_TYPE_Points;	m_Vertex_Type	= SG_VERTEX_TYPE_XY;	break;	// MultiPoint
@@ -363,169 +636,136 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 	}
 
 	//-----------------------------------------------------
-	// Load Shapes...
+	// Record Offsets, preferably from the index file...
+
+	int	nRecords	= fDBF.Get_Count();
 
-	for(int iShape=0; iShape<fDBF.Get_Count() && SG_UI_Process_Set_Progress(iShape, fDBF.Get_Count()); iShape++)
+	if( (size_t)fDBF.Get_Header_Bytes() + (size_t)nRecords * fDBF.Get_Record_Bytes() > DBF.Get_Size() )
 	{
-		if( fSHP.Read(Record_Header.Get_Data(0), sizeof(int), 2) != 2 )		// read record header
+		nRecords	= (int)((DBF.Get_Size() - M_GET_MIN(DBF.Get_Size(), (size_t)fDBF.Get_Header_Bytes())) / M_GET_MAX(1, fDBF.Get_Record_Bytes()));
+	}
+
+	CSG_Array_sLong	Offset(nRecords);
+
+	bool	bIndex	= SHX.Open(SG_File_Make_Path("", File_Name, "shx")) && SHX.Get_Size() >= 100 + 8 * (size_t)nRecords;
+
+	sLong	Position	= 100;
+
+	for(int iShape=0; iShape<nRecords; iShape++)	// record header offsets
+	{
+		if( bIndex )
 		{
-			SG_UI_Msg_Add_Error(_TL("corrupted record header"));
+			Offset[iShape]	= 2 * (sLong)SHX.asInt(100 + 8 * (size_t)iShape, true);	// offset as 16-bit words !!!
+		}
+		else
+		{
+			Offset[iShape]	= Position;
 
-			return( false );
+			if( (size_t)Position + 8 <= SHP.Get_Size() )
+			{
+				int	Length	= SHP.asInt((size_t)Position + 4, true);	// content length as 16-bit words !!!
+
+				if( Length < 0 || (size_t)Length > (SHP.Get_Size() - (size_t)Position - 8) / 2 )
+				{
+					SG_UI_Msg_Add_Error(_TL("corrupted record header"));
+
+					return( false );
+				}
+
+				Position	+= 8 + 2 * (sLong)Length;
+			}
 		}
+	}
+
+	SHX.Close();
 
-		if( Record_Header.asInt(0, true) != iShape + 1 )					// record number
+	//-----------------------------------------------------
+	// Check Records, skip deleted and null shapes...
+
+	CSG_Array_sLong	Records(nRecords);	sLong	nShapes	= 0;
+
+	for(int iShape=0; iShape<nRecords; iShape++)
+	{
+		size_t	Position	= (size_t)Offset[iShape];
+
+		if( Offset[iShape] < 100 || Position + 12 > SHP.Get_Size() )
 		{
-			SG_UI_Msg_Add_Error(CSG_String::Format("%s (%d != %d)", _TL("corrupted shapefile."), Record_Header.asInt(0, true), iShape + 1));
+			SG_UI_Msg_Add_Error(_TL("corrupted record header"));
 
 			return( false );
 		}
 
-		size_t	Length	= 2 * Record_Header.asInt(4, true);	// content length as 16-bit words !!!
-
-		if( !Content.Set_Size(Length, false) )
+		if( SHP.asInt(Position, true) != iShape + 1 )	// record number
 		{
-			SG_UI_Msg_Add_Error(_TL("memory allocation error."));
+			SG_UI_Msg_Add_Error(CSG_String::Format("%s (%d != %d)", _TL("corrupted shapefile."), SHP.asInt(Position, true), iShape + 1));
 
 			return( false );
 		}
 
-		if( fSHP.Read(Content.Get_Data(), sizeof(char), Length) != Length )
+		int	Length	= SHP.asInt(Position + 4, true);	// content length as 16-bit words !!!
+
+		if( Length < 0 || (size_t)Length > (SHP.Get_Size() - Position - 8) / 2 )
 		{
 			SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
 
 			return( false );
 		}
 
-		if( fDBF.isDeleted() )
+		if( fDBF.isDeleted(DBF.Get_Data(fDBF.Get_Header_Bytes() + (size_t)iShape * fDBF.Get_Record_Bytes())) )
 		{
 			continue;	// nop
 		}
 
-		if( Content.asInt(0) != Type )
+		if( SHP.asInt(Position + 8) != Type )
 		{
-			if( Content.asInt(0) == 0 )
+			if( SHP.asInt(Position + 8) == 0 )
 			{
-				// null shape is allowed !!!
+				continue;	// null shape is allowed !!!
 			}
-			else
-			{
-				SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
-
-				return( false );
-			}
-		}
-
-		//-------------------------------------------------
-		else
-		{
-			CSG_Shape	*pShape	= Add_Shape();
-
-			switch( m_Type )
-			{
-			default:	break;
-
-			//---------------------------------------------
-			case SHAPE_TYPE_Point: ////////////////////////
-
-				pPoint	= (TSG_Point *)Content.Get_Data(4);
-
-				pShape->Add_Point(pPoint->x, pPoint->y);
-
-				switch( m_Vertex_Type )	// read Z + M
-				{
-				default:	break;
-				case SG_VERTEX_TYPE_XYZM: pShape->Set_M(Content.asDouble(28), 0);
-				case SG_VERTEX_TYPE_XYZ : pShape->Set_Z(Content.asDouble(20), 0);
-				}
-
-				break;
-
-			//---------------------------------------------
-			case SHAPE_TYPE_Points: ///////////////////////
-
-				nPoints	= Content.asInt(36);
-				pPoint	= (TSG_Point *)Content.Get_Data(40);
 
-				switch( m_Vertex_Type )	// read Z + M
-				{
-				default:
-					break;
-
-				case SG_VERTEX_TYPE_XYZ:
-					pZ	= 56 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					break;
-
-				case SG_VERTEX_TYPE_XYZM:
-					pZ	= 56 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					pM	= 72 + nPoints * 32 <= (int)Length ? (double *)Content.Get_Data(72 + nPoints * 24) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] + [nPoints * 8]
-					break;
-				}
-
-				//-----------------------------------------
-				for(iPoint=0; iPoint<nPoints; iPoint++, pPoint++)
-				{
-					pShape->Add_Point(pPoint->x, pPoint->y);
-
-					if( pZ )	{	pShape->Set_Z(*(pZ++), iPoint);	}
-					if( pM )	{	pShape->Set_M(*(pM++), iPoint);	}
-				}
-
-				break;
-
-			//---------------------------------------------
-			case SHAPE_TYPE_Line   : //////////////////////
-			case SHAPE_TYPE_Polygon: //////////////////////
-
-				nParts	= Content.asInt(36);
-				nPoints	= Content.asInt(40);
-				Parts	= (int       *)Content.Get_Data(44);
-				pPoint	= (TSG_Point *)Content.Get_Data(44 + 4 * nParts);
-
-				switch( m_Vertex_Type )	// read Z + M
-				{
-				default:
-					break;
+			SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
 
-				case SG_VERTEX_TYPE_XYZ:
-					pZ	= 60 + nParts * 4 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					break;
+			return( false );
+		}
 
-				case SG_VERTEX_TYPE_XYZM:
-					pZ	= 60 + nParts * 4 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					pM	= 76 + nParts * 4 + nPoints * 32 <= (int)Length ? (double *)Content.Get_Data(76 + nParts * 4 + nPoints * 24) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] +  [nPoints * 8]
-					break;
-				}
+		Records[nShapes++]	= iShape;
+	}
 
-				//-----------------------------------------
-				iOffset = 0;
+	//-----------------------------------------------------
+	// Load Shapes...
 
-				for(iPoint=0, iPart=0; iPoint<nPoints; iPoint++, pPoint++)
-				{
-					if( iPart < nParts - 1 && iPoint >= Parts[iPart + 1] )
-					{
-						iPart++;
-						iOffset = 0;
-					}
+	for(sLong iShape=0; iShape<nShapes; iShape++)
+	{
+		Add_Shape();
+	}
 
-					pShape->Add_Point(pPoint->x, pPoint->y, iPart);
+	bool	bCorrupted	= false;
 
-					if( pZ )	{	pShape->Set_Z(*(pZ++), iOffset, iPart);	}
-					if( pM )	{	pShape->Set_M(*(pM++), iOffset, iPart);	}
+	for(sLong iChunk=0; iChunk<nShapes && !bCorrupted && SG_UI_Process_Set_Progress(iChunk, nShapes); iChunk+=SHP_CHUNK)
+	{
+		int	nChunk	= (int)M_GET_MIN(SHP_CHUNK, nShapes - iChunk);
 
-					iOffset++;
-				}
+		#pragma omp parallel for schedule(dynamic, 64)
+		for(int i=0; i<nChunk; i++)
+		{
+			sLong		iShape	= iChunk + i;
+			CSG_Shape	*pShape	= Get_Shape(iShape);
+			size_t		Position	= (size_t)Offset[Records[iShape]];
 
-				break;
+			if( !SG_Shapes_ESRI_Decode(pShape, SHP.Get_Data(Position + 8), 2 * (size_t)SHP.asInt(Position + 4, true), m_Type, m_Vertex_Type) )
+			{
+				bCorrupted	= true;
 			}
 
 			//---------------------------------------------
-			for(iField=0; iField<Get_Field_Count(); iField++)
+			const char	*Record	= DBF.Get_Data(fDBF.Get_Header_Bytes() + (size_t)Records[iShape] * fDBF.Get_Record_Bytes());
+
+			for(int iField=0; iField<Get_Field_Count(); iField++)
 			{
 				switch( fDBF.Get_Field_Type(iField) )
 				{
 				default:
-					pShape->Set_Value(iField, fDBF.asString(iField));
+					pShape->Set_Value(iField, fDBF.asString(Record, iField));
 					break;
 
 				case DBF_FT_FLOAT:
@@ -533,7 +773,7 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 					{
 						double	Value;
 
-						if( fDBF.asDouble(iField, Value) )
+						if( fDBF.asDouble(Record, iField, Value) )
 						{
 							pShape->Set_Value(iField, Value);
 						}
@@ -546,10 +786,18 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 				}
 			}
 		}
+	}
+
+	if( bCorrupted )
+	{
+		SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
 
-		fDBF.Move_Next();
+		return( false );
 	}
 
+	SHP.Close();
+	DBF.Close();
+
 	//-----------------------------------------------------
 	Get_Projection().Load(SG_File_Make_Path("", File_Name, "prj"));
 
@@ -560,7 +808,7 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 
 	if( pFields && pFields->Get_Children_Count() == Get_Field_Count() )
 	{
-		for(iField=0; iField<Get_Field_Count(); iField++)
+		for(int iField=0; iField<Get_Field_Count(); iField++)
 		{
 			Set_Field_Name(iField, pFields->Get_Content(iField));
 		}
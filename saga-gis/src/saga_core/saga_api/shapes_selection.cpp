@@ -79,12 +79,11 @@ bool CSG_Shapes::Select(const TSG_Rect &Extent, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Shapes; Get_Shapes(Extent, Shapes);
+
+	for(sLong i=0; i<Shapes.Get_Size(); i++)
 	{
-		if( Get_Shape(i)->Intersects(Extent) )
-		{
-			CSG_Table::Select(i, true);
-		}
+		CSG_Table::Select(Shapes[i], true);
 	}
 
 	return( Get_Selection_Count() > 0 );
@@ -103,12 +102,11 @@ bool CSG_Shapes::Select(const TSG_Point &Point, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Shapes; Get_Shapes(Point, Shapes);
+
+	for(sLong i=0; i<Shapes.Get_Size(); i++)
 	{
-		if( ((CSG_Shape_Polygon *)Get_Shape(i))->Contains(Point) )
-		{
-			CSG_Table::Select(i, true);
-		}
+		CSG_Table::Select(Shapes[i], true);
 	}
 
 	return( Get_Selection_Count() > 0 );
@@ -303,10 +303,16 @@ void CSG_Table::_On_Construction(void)
 	m_nRecords    = 0;
 	m_nBuffer     = 0;
 
+	m_bColumnar   = false;
+	m_Columns     = NULL;
+	m_nSlots      = 0;
+
 	m_Encoding    = SG_FILE_ENCODING_UTF8;
 
 	m_Selection.Create(sizeof(sLong), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_3);
 
+	m_Slots_Free.Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_3);
+
 	Set_Update_Flag();
 }
 
@@ -334,12 +340,19 @@ bool CSG_Table::Destroy(void)
 		{
 			delete(m_Field_Name [i]);
 			delete(m_Field_Stats[i]);
+
+			if( m_Columns )
+			{
+				delete(m_Columns[i]);
+			}
 		}
 
 		SG_Free(m_Field_Name );
 		SG_Free(m_Field_Stats);
 		SG_Free(m_Field_Type );
 
+		SG_FREE_SAFE(m_Columns);
+
 		m_nFields     = 0;
 		m_Field_Name  = NULL;
 		m_Field_Type  = NULL;
@@ -498,6 +511,20 @@ bool CSG_Table::Add_Field(const CSG_String &Name, TSG_Data_Type Type, int Positi
 	m_Field_Type [Position]	= Type;
 	m_Field_Stats[Position]	= new CSG_Simple_Statistics();
 
+	//-----------------------------------------------------
+	if( m_bColumnar )
+	{
+		m_Columns = (CSG_Table_Column **)SG_Realloc(m_Columns, m_nFields * sizeof(CSG_Table_Column *));
+
+		for(int i=m_nFields-1; i>Position; i--)
+		{
+			m_Columns[i] = m_Columns[i - 1];
+		}
+
+		m_Columns[Position] = new CSG_Table_Column(Type, this);
+		m_Columns[Position]->Set_Size(m_nSlots);
+	}
+
 	//-----------------------------------------------------
 	for(sLong i=0; i<m_nRecords; i++)
 	{
@@ -521,6 +548,11 @@ bool CSG_Table::Del_Field(int del_Field)
 	delete(m_Field_Name [del_Field]);
 	delete(m_Field_Stats[del_Field]);
 
+	if( m_bColumnar )
+	{
+		delete(m_Columns[del_Field]);
+	}
+
 	//-------------------------------------------------
 	m_nFields--;
 
@@ -529,6 +561,16 @@ bool CSG_Table::Del_Field(int del_Field)
 		m_Field_Name [i]	= m_Field_Name [i + 1];
 		m_Field_Type [i]	= m_Field_Type [i + 1];
 		m_Field_Stats[i]	= m_Field_Stats[i + 1];
+
+		if( m_bColumnar )
+		{
+			m_Columns[i] = m_Columns[i + 1];
+		}
+	}
+
+	if( m_bColumnar && m_nFields == 0 )
+	{
+		SG_FREE_SAFE(m_Columns);
 	}
 
 	//-------------------------------------------------
@@ -580,10 +622,17 @@ bool CSG_Table::Mov_Field(int iField, int Position)
 		iField++;
 	}
 
-	#pragma omp parallel for
-	for(sLong i=0; i<m_nRecords; i++)
+	if( m_bColumnar )	// just exchange the columns, the empty one will be deleted
+	{
+		CSG_Table_Column *pColumn = m_Columns[Position]; m_Columns[Position] = m_Columns[iField]; m_Columns[iField] = pColumn;
+	}
+	else
 	{
-		*m_Records[i]->Get_Value(Position) = *m_Records[i]->Get_Value(iField);
+		#pragma omp parallel for
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			*m_Records[i]->Get_Value(Position) = *m_Records[i]->Get_Value(iField);
+		}
 	}
 
 	if( !Del_Field(iField) )
@@ -630,6 +679,31 @@ bool CSG_Table::Set_Field_Type(int iField, TSG_Data_Type Type)
 
 	m_Field_Type[iField] = Type;
 
+	if( m_bColumnar )
+	{
+		CSG_Table_Column *pColumn = new CSG_Table_Column(Type, this);
+
+		pColumn->Set_Size(m_nSlots);
+
+		for(sLong i=0; i<m_nSlots; i++)
+		{
+			pColumn->Set_Value(i, CSG_Table_Value_Column(m_Columns[iField], i));
+		}
+
+		delete(m_Columns[iField]); m_Columns[iField] = pColumn;
+
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			m_Records[i]->_Del_Proxies();	// are referring to the deleted column
+
+			m_Records[i]->Set_Modified();
+		}
+
+		_Stats_Invalidate(iField);
+
+		return( true );
+	}
+
 	for(sLong i=0; i<m_nRecords; i++)
 	{
 		CSG_Table_Record *pRecord = m_Records[i];
@@ -902,6 +976,8 @@ bool CSG_Table::Del_Records(void)
 {
 	Del_Index();
 
+	m_nSlots = 0;	// columnar storage, no need to release single slots
+
 	for(sLong iRecord=0; iRecord<m_nRecords; iRecord++)
 	{
 		delete(m_Records[iRecord]);
@@ -912,6 +988,16 @@ bool CSG_Table::Del_Records(void)
 	m_nRecords = 0;
 	m_nBuffer  = 0;
 
+	if( m_bColumnar )
+	{
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			m_Columns[iField]->Set_Size(0);
+		}
+
+		m_Slots_Free.Destroy();
+	}
+
 	return( true );
 }
 
@@ -1183,6 +1269,242 @@ bool CSG_Table::Get_Value(sLong iRecord, int iField, double      &Value) const
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//						Columnar Storage				 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Switches between the default record based storage, with each
+* record holding its own value objects, and a columnar storage,
+* which keeps each field's values in one typed, contiguous array
+* (see CSG_Table_Column). Columnar storage needs much less memory
+* for large tables and speeds up field wise processing, while all
+* record based access functions continue to work. Existing data
+* are converted. Only supported for plain tables, not for derived
+* data objects like shapes or point clouds.
+*/
+//---------------------------------------------------------
+bool CSG_Table::Set_Columnar(bool bOn)
+{
+	if( bOn == m_bColumnar )
+	{
+		return( true );
+	}
+
+	if( Get_ObjectType() != SG_DATAOBJECT_TYPE_Table )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( bOn )
+	{
+		m_Columns = m_nFields > 0 ? (CSG_Table_Column **)SG_Malloc(m_nFields * sizeof(CSG_Table_Column *)) : NULL;
+
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			m_Columns[iField] = new CSG_Table_Column(m_Field_Type[iField], this);
+			m_Columns[iField]->Set_Size(m_nRecords);
+		}
+
+		m_nSlots = m_nRecords; m_Slots_Free.Destroy();
+
+		#pragma omp parallel for
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Record *pRecord = m_Records[i];
+
+			for(int iField=0; iField<m_nFields; iField++)
+			{
+				m_Columns[iField]->Set_Value(i, *pRecord->m_Values[iField]);
+
+				delete(pRecord->m_Values[iField]);
+			}
+
+			SG_FREE_SAFE(pRecord->m_Values);
+
+			pRecord->m_Slot = i;
+		}
+	}
+
+	//-----------------------------------------------------
+	else
+	{
+		#pragma omp parallel for
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Record *pRecord = m_Records[i];
+
+			pRecord->_Del_Proxies();
+
+			if( m_nFields > 0 )
+			{
+				pRecord->m_Values = (CSG_Table_Value **)SG_Malloc(m_nFields * sizeof(CSG_Table_Value *));
+
+				for(int iField=0; iField<m_nFields; iField++)
+				{
+					pRecord->m_Values[iField] = CSG_Table_Record::_Create_Value(m_Field_Type[iField]);
+
+					*pRecord->m_Values[iField] = CSG_Table_Value_Column(m_Columns[iField], pRecord->m_Slot);
+				}
+			}
+
+			pRecord->m_Slot = -1;
+		}
+
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			delete(m_Columns[iField]);
+		}
+
+		SG_FREE_SAFE(m_Columns);
+
+		m_nSlots = 0; m_Slots_Free.Destroy();
+	}
+
+	//-----------------------------------------------------
+	m_bColumnar = bOn;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+sLong CSG_Table::_Add_Slot(void)
+{
+	if( m_Slots_Free.Get_Size() > 0 )	// re-use the storage of deleted records
+	{
+		sLong Slot = m_Slots_Free[m_Slots_Free.Get_Size() - 1];
+
+		m_Slots_Free.Set_Array(m_Slots_Free.Get_Size() - 1, false);
+
+		return( Slot );
+	}
+
+	for(int iField=0; iField<m_nFields; iField++)
+	{
+		m_Columns[iField]->Set_Size(m_nSlots + 1);
+	}
+
+	return( m_nSlots++ );
+}
+
+//---------------------------------------------------------
+void CSG_Table::_Del_Slot(sLong Slot)
+{
+	if( m_nSlots > 0 )	// is zero, if invoked by Del_Records()
+	{
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			m_Columns[iField]->Reset(Slot);
+		}
+
+		m_Slots_Free.Add(Slot);
+	}
+}
+
+//---------------------------------------------------------
+/**
+* Bulk access to a field's values in record order, e.g. for
+* aggregation. Values are returned as numbers, no-data flags,
+* if requested, are set to 1 for no-data and 0 for valid values.
+*/
+//---------------------------------------------------------
+bool CSG_Table::Get_Column(int iField, CSG_Vector &Values, CSG_Array_Int *pNoData) const
+{
+	if( iField < 0 || iField >= m_nFields )
+	{
+		return( false );
+	}
+
+	if( m_nRecords < 1 )
+	{
+		Values.Destroy(); if( pNoData ) { pNoData->Destroy(); }
+
+		return( true );
+	}
+
+	if( !Values.Create(m_nRecords) || (pNoData && !pNoData->Create(m_nRecords)) )
+	{
+		return( false );
+	}
+
+	double *pValues = Values.Get_Data(); int *pFlags = pNoData ? pNoData->Get_Array() : NULL;
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		CSG_Table_Record *pRecord = m_Records[i];
+
+		if( m_bColumnar )
+		{
+			pValues[i] = m_Columns[iField]->asDouble(pRecord->m_Slot);
+
+			if( pFlags )
+			{
+				pFlags[i] = m_Columns[iField]->is_NoData(pRecord->m_Slot) ? 1 : 0;
+			}
+		}
+		else
+		{
+			pValues[i] = pRecord->asDouble(iField);
+
+			if( pFlags )
+			{
+				pFlags[i] = pRecord->is_NoData(iField) ? 1 : 0;
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Bulk assignment of a field's values in record order. The
+* number of values has to match the number of records.
+*/
+//---------------------------------------------------------
+bool CSG_Table::Set_Column(int iField, const CSG_Vector &Values)
+{
+	if( iField < 0 || iField >= m_nFields || m_nRecords < 1 || Values.Get_Size() != m_nRecords )
+	{
+		return( false );
+	}
+
+	if( m_bColumnar )
+	{
+		#pragma omp parallel for
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Record *pRecord = m_Records[i];
+
+			if( m_Columns[iField]->Set_Value(pRecord->m_Slot, Values(i)) )
+			{
+				pRecord->m_Flags |= SG_TABLE_REC_FLAG_Modified;
+			}
+		}
+	}
+	else
+	{
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			m_Records[i]->Set_Value(iField, Values(i));
+		}
+	}
+
+	Set_Modified();
+
+	Set_Update_Flag();
+
+	_Stats_Invalidate(iField);
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //						Statistics						 //
@@ -1246,6 +1568,20 @@ bool CSG_Table::_Stats_Update(int iField) const
 			: (sLong)(Get_Count() * (double)Statistics.Get_Count() / (double)Get_Max_Samples())
 		);
 	}
+	else if( m_bColumnar )
+	{
+		const CSG_Table_Column &Column = *m_Columns[iField];
+
+		for(sLong i=0; i<Get_Count(); i++)
+		{
+			sLong Slot = m_Records[i]->m_Slot;
+
+			if( !Column.is_NoData(Slot) )
+			{
+				Statistics += Column.asDouble(Slot);
+			}
+		}
+	}
 	else
 	{
 		for(sLong i=0; i<Get_Count(); i++)
@@ -1274,6 +1610,11 @@ bool CSG_Table::On_NoData_Changed(void)
 {
 	_Stats_Invalidate();
 
+	for(int iField=0; m_bColumnar && iField<m_nFields; iField++)
+	{
+		m_Columns[iField]->Update_NoData();
+	}
+
 	return( CSG_Data_Object::On_NoData_Changed() );
 }
 
@@ -1414,6 +1755,10 @@ public:
 		{
 			m_pTable	= NULL;
 		}
+		else if( m_pTable->Get_Field_Type(m_Field) != SG_DATATYPE_String )
+		{
+			m_pTable->Get_Column(m_Field, m_Values);	// numeric values (and dates as Julian Day Numbers) are compared a lot, so fetch them only once
+		}
 	}
 
 	bool				is_Okay		(void)	const	{	return( m_pTable != NULL );	}
@@ -1426,15 +1771,12 @@ public:
 		switch( m_pTable->Get_Field_Type(m_Field) )
 		{
 		default: {
-			double d =
-				m_pTable->Get_Record(a)->asDouble(m_Field) -
-				m_pTable->Get_Record(b)->asDouble(m_Field);
+			double d = m_Values[a] - m_Values[b];
 
 			return( d < 0. ? -1 : d > 0. ? 1 : 0 );
 		}
 
 		case SG_DATATYPE_String:
-		case SG_DATATYPE_Date  :
 			return( SG_STR_CMP(
 				m_pTable->Get_Record(a)->asString(m_Field),
 				m_pTable->Get_Record(b)->asString(m_Field))
@@ -1449,6 +1791,8 @@ private:
 
 	int					m_Field;
 
+	CSG_Vector			m_Values;
+
 	const CSG_Table		*m_pTable;
 
 };
@@ -1484,6 +1828,8 @@ public:
 
 			m_Ascending[i] = Ascending ? 1 : 0;
 		}
+
+		_Get_Values();
 	}
 
 	CSG_Table_Record_Compare_Fields(const CSG_Table *pTable, int Fields[], int nFields, int Ascending[])
@@ -1500,6 +1846,13 @@ public:
 
 			m_Ascending[i] = Ascending[i] > 0 ? 1 : 0;
 		}
+
+		_Get_Values();
+	}
+
+	virtual ~CSG_Table_Record_Compare_Fields(void)
+	{
+		delete[](m_Values);
 	}
 
 	bool				is_Okay		(void)	const	{	return( m_pTable != NULL );	}
@@ -1518,13 +1871,12 @@ public:
 			switch( m_pTable->Get_Field_Type(Field) )
 			{
 			default: {
-				double d = m_pTable->Get_Record(a)->asDouble(Field);
-				d       -= m_pTable->Get_Record(b)->asDouble(Field);
+				double d = m_Values[i].Get_Size() > 0 ? m_Values[i][a] - m_Values[i][b]
+					: m_pTable->Get_Record(a)->asDouble(Field) - m_pTable->Get_Record(b)->asDouble(Field);
 				Difference = d < 0. ? -1 : d > 0. ? 1 : 0;
 			}	break;
 
 			case SG_DATATYPE_String:
-			case SG_DATATYPE_Date  :
 				CSG_String   s    (m_pTable->Get_Record(a)->asString(Field));
 				Difference = s.Cmp(m_pTable->Get_Record(b)->asString(Field));
 				break;
@@ -1541,8 +1893,25 @@ private:
 
 	CSG_Array_Int		m_Ascending;
 
+	CSG_Vector			*m_Values;
+
 	const CSG_Table		*m_pTable;
 
+
+	//-----------------------------------------------------
+	void				_Get_Values	(void)	// numeric values are compared a lot, so fetch them only once
+	{
+		m_Values = new CSG_Vector[m_nFields > 0 ? m_nFields : 1];
+
+		for(int i=0; m_pTable && i<m_nFields; i++)
+		{
+			if( m_pTable->Get_Field_Type(m_Fields[i]) != SG_DATATYPE_String )
+			{
+				m_pTable->Get_Column(m_Fields[i], m_Values[i]);
+			}
+		}
+	}
+
 };
 
 //---------------------------------------------------------
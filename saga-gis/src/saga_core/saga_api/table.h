@@ -234,8 +234,8 @@ public:
 	double						asDouble		(const char       *Field) const { return( asDouble(CSG_String(Field)) ); }
 	double						asDouble		(const wchar_t    *Field) const { return( asDouble(CSG_String(Field)) ); }
 
-	CSG_Table_Value *			Get_Value		(int               Field)       { return(  m_Values[Field] ); }
-	CSG_Table_Value &			operator []		(int               Field) const { return( *m_Values[Field] ); }
+	CSG_Table_Value *			Get_Value		(int               Field)       { return(  m_Slot < 0 ? m_Values[Field] : _Get_Proxy(Field) ); }
+	CSG_Table_Value &			operator []		(int               Field) const { return( *(m_Slot < 0 ? m_Values[Field] : _Get_Proxy(Field)) ); }
 
 	virtual bool				Assign			(CSG_Table_Record *pRecord);
 
@@ -251,7 +251,7 @@ protected:
 
 	char						m_Flags;
 
-	sLong						m_Index;
+	sLong						m_Index, m_Slot;
 
 	class CSG_Table_Value		**m_Values;
 
@@ -269,6 +269,9 @@ protected:
 
 	int							_Get_Field	 	(const CSG_String &Field)	const;
 
+	CSG_Table_Value *			_Get_Proxy		(int Field)	const;
+	bool						_Del_Proxies	(void);
+
 };
 
 
@@ -416,6 +419,13 @@ public:
 
 	virtual void					Set_Modified		(bool bModified = true);
 
+	//-----------------------------------------------------
+	bool							Set_Columnar		(bool bOn = true);
+	bool							is_Columnar			(void)	const	{	return( m_bColumnar );	}
+
+	bool							Get_Column			(int iField, CSG_Vector &Values, CSG_Array_Int *pNoData = NULL)	const;
+	bool							Set_Column			(int iField, const CSG_Vector &Values);
+
 	//-----------------------------------------------------
 	sLong							Get_Selection_Count	(void)				const	{	return( m_Selection.Get_Size() );	}
 	sLong							Get_Selection_Index	(sLong Index = 0)	const	{	return( Index >= 0 && Index < m_Selection.Get_Size() ? *((sLong *)m_Selection.Get_Entry(Index)) : Get_Count() );	}
@@ -497,9 +507,20 @@ private:
 
 	CSG_Table_Record				**m_Records;
 
+	bool							m_bColumnar;
+
+	sLong							m_nSlots;
+
+	CSG_Array_sLong					m_Slots_Free;
+
+	CSG_Table_Column				**m_Columns;
+
 
 	bool							_Destroy_Selection	(void);
 
+	sLong							_Add_Slot			(void);
+	void							_Del_Slot			(sLong Slot);
+
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
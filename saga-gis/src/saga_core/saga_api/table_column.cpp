@@ -0,0 +1,607 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   table_column.cpp                    //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <string>
+#include <unordered_map>
+
+#include "dataobject.h"
+#include "table_value.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The string pool owns one CSG_String per distinct value.
+// Rows store a pointer to their pooled string (NULL for an
+// empty string), so that reading never touches the pool and
+// remains safe while other threads add new strings.
+//---------------------------------------------------------
+typedef std::unordered_map<std::wstring, CSG_String *>	CSG_Table_Column_Dictionary;
+
+#define DICTIONARY	((CSG_Table_Column_Dictionary *)m_Dictionary)
+
+//---------------------------------------------------------
+#define VALUES_INT		((int                **)&m_Values)[0]
+#define VALUES_LONG		((sLong              **)&m_Values)[0]
+#define VALUES_DOUBLE	((double             **)&m_Values)[0]
+#define VALUES_STRING	((const CSG_String ***)&m_Values)[0]
+#define VALUES_BINARY	((CSG_Bytes         ***)&m_Values)[0]
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Table_Column::CSG_Table_Column(TSG_Data_Type Type, const CSG_Data_Object *pOwner)
+{
+	m_Data_Type  = Type;
+	m_pOwner     = pOwner;
+
+	m_nRows      = 0;
+	m_nBuffer    = 0;
+	m_Valid      = NULL;
+	m_Values     = NULL;
+	m_Dictionary = NULL;
+
+	switch( Type )
+	{
+	default:
+	case SG_DATATYPE_String: m_Type = SG_TABLE_VALUE_TYPE_String; m_Dictionary = new CSG_Table_Column_Dictionary; break;
+	case SG_DATATYPE_Date  : m_Type = SG_TABLE_VALUE_TYPE_Date  ; break;
+	case SG_DATATYPE_Color :
+	case SG_DATATYPE_Byte  :
+	case SG_DATATYPE_Char  :
+	case SG_DATATYPE_Word  :
+	case SG_DATATYPE_Short :
+	case SG_DATATYPE_DWord :
+	case SG_DATATYPE_Int   : m_Type = SG_TABLE_VALUE_TYPE_Int   ; break;
+	case SG_DATATYPE_ULong :
+	case SG_DATATYPE_Long  : m_Type = SG_TABLE_VALUE_TYPE_Long  ; break;
+	case SG_DATATYPE_Float :
+	case SG_DATATYPE_Double: m_Type = SG_TABLE_VALUE_TYPE_Double; break;
+	case SG_DATATYPE_Binary: m_Type = SG_TABLE_VALUE_TYPE_Binary; break;
+	}
+}
+
+//---------------------------------------------------------
+CSG_Table_Column::~CSG_Table_Column(void)
+{
+	Set_Size(0);
+
+	SG_FREE_SAFE(m_Values);
+	SG_FREE_SAFE(m_Valid );
+
+	if( m_Dictionary )
+	{
+		for(CSG_Table_Column_Dictionary::iterator i=DICTIONARY->begin(); i!=DICTIONARY->end(); i++)
+		{
+			delete(i->second);
+		}
+
+		delete(DICTIONARY);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Size(sLong nRows)
+{
+	if( nRows < 0 )
+	{
+		return( false );
+	}
+
+	if( m_Type == SG_TABLE_VALUE_TYPE_Binary )
+	{
+		for(sLong i=nRows; i<m_nRows; i++)
+		{
+			if( VALUES_BINARY[i] )
+			{
+				delete(VALUES_BINARY[i]); VALUES_BINARY[i] = NULL;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	if( nRows > m_nBuffer )
+	{
+		sLong nBuffer = nRows < 1024 ? 1024 : nRows + nRows / 2;	// amortized growth when records are added one by one
+
+		size_t Size;
+
+		switch( m_Type )
+		{
+		default                        : Size = sizeof(int         ); break;
+		case SG_TABLE_VALUE_TYPE_Long  : Size = sizeof(sLong       ); break;
+		case SG_TABLE_VALUE_TYPE_Date  :
+		case SG_TABLE_VALUE_TYPE_Double: Size = sizeof(double      ); break;
+		case SG_TABLE_VALUE_TYPE_String: Size = sizeof(CSG_String *); break;
+		case SG_TABLE_VALUE_TYPE_Binary: Size = sizeof(CSG_Bytes  *); break;
+		}
+
+		void *Values = SG_Realloc(m_Values, nBuffer * Size);
+		BYTE *Valid  = (BYTE *)SG_Realloc(m_Valid, (nBuffer + 7) / 8);
+
+		if( !Values || !Valid )
+		{
+			if( Values ) { m_Values = Values; }
+			if( Valid  ) { m_Valid  = Valid ; }
+
+			return( false );
+		}
+
+		m_Values  = Values;
+		m_Valid   = Valid;
+		m_nBuffer = nBuffer;
+	}
+
+	//-----------------------------------------------------
+	sLong nAdded = nRows - m_nRows;
+
+	m_nRows = nRows;
+
+	for(sLong i=nRows-nAdded; i<nRows; i++)	// initialize added rows
+	{
+		switch( m_Type )
+		{
+		default                        : VALUES_INT   [i] =    0; break;
+		case SG_TABLE_VALUE_TYPE_Long  : VALUES_LONG  [i] =    0; break;
+		case SG_TABLE_VALUE_TYPE_Date  :
+		case SG_TABLE_VALUE_TYPE_Double: VALUES_DOUBLE[i] =   0.; break;
+		case SG_TABLE_VALUE_TYPE_String: VALUES_STRING[i] = NULL; break;
+		case SG_TABLE_VALUE_TYPE_Binary: VALUES_BINARY[i] = NULL; break;
+		}
+
+		_Set_Valid(i);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Sets the row's value back to its type's default, which is
+* zero, an empty string or an empty byte array.
+*/
+bool CSG_Table_Column::Reset(sLong Row)
+{
+	if( Row < 0 || Row >= m_nRows )
+	{
+		return( false );
+	}
+
+	switch( m_Type )
+	{
+	default                        : VALUES_INT   [Row] =    0; break;
+	case SG_TABLE_VALUE_TYPE_Long  : VALUES_LONG  [Row] =    0; break;
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: VALUES_DOUBLE[Row] =   0.; break;
+	case SG_TABLE_VALUE_TYPE_String: VALUES_STRING[Row] = NULL; break;
+	case SG_TABLE_VALUE_TYPE_Binary: if( VALUES_BINARY[Row] ) { delete(VALUES_BINARY[Row]); VALUES_BINARY[Row] = NULL; } break;
+	}
+
+	_Set_Valid(Row);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+inline bool CSG_Table_Column::_is_Valid(sLong Row) const
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( VALUES_STRING[Row] != NULL );
+	case SG_TABLE_VALUE_TYPE_Binary: return( VALUES_BINARY[Row] != NULL && VALUES_BINARY[Row]->Get_Count() > 0 );
+	default: break;
+	}
+
+	if( !m_pOwner )
+	{
+		return( true );
+	}
+
+	switch( m_Type )
+	{
+	default                        : return( !m_pOwner->is_NoData_Value(VALUES_DOUBLE[Row]) );
+	case SG_TABLE_VALUE_TYPE_Int   : return( !m_pOwner->is_NoData_Value(VALUES_INT   [Row]) );
+	case SG_TABLE_VALUE_TYPE_Long  : return( !m_pOwner->is_NoData_Value((double)VALUES_LONG[Row]) );
+	case SG_TABLE_VALUE_TYPE_Date  : return( !m_pOwner->is_NoData_Value(VALUES_DOUBLE      [Row]) );
+	}
+}
+
+//---------------------------------------------------------
+inline void CSG_Table_Column::_Set_Valid(sLong Row)
+{
+	BYTE Mask = (BYTE)(1 << (Row & 7)), &Bits = m_Valid[Row >> 3];	// atomic, neighbouring rows share a byte
+
+	if( _is_Valid(Row) )
+	{
+		#pragma omp atomic
+		Bits |= Mask;
+	}
+	else
+	{
+		Mask = (BYTE)~Mask;
+
+		#pragma omp atomic
+		Bits &= Mask;
+	}
+}
+
+//---------------------------------------------------------
+/**
+* Rebuilds the validity bitmap, e.g. after the owner's no-data
+* value range has been changed.
+*/
+void CSG_Table_Column::Update_NoData(void)
+{
+	#pragma omp parallel for
+	for(sLong i=0; i<m_nRows; i++)
+	{
+		_Set_Valid(i);
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_NoData(sLong Row)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( _Set_String(Row, NULL) );
+
+	case SG_TABLE_VALUE_TYPE_Binary:
+		if( VALUES_BINARY[Row] )
+		{
+			delete(VALUES_BINARY[Row]); VALUES_BINARY[Row] = NULL; _Set_Valid(Row);
+
+			return( true );
+		}
+		return( false );
+
+	default:
+		return( Set_Value(Row, m_pOwner ? m_pOwner->Get_NoData_Value() : -99999.) );
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table_Column::_Set_String(sLong Row, const SG_Char *Value)
+{
+	const CSG_String *pString = NULL;
+
+	if( Value && *Value )
+	{
+		if( VALUES_STRING[Row] && !VALUES_STRING[Row]->Cmp(Value) )
+		{
+			return( false );
+		}
+
+		std::wstring Key(Value);
+
+		#pragma omp critical(SG_Table_Column_Dictionary)
+		{
+			CSG_Table_Column_Dictionary::iterator i = DICTIONARY->find(Key);
+
+			if( i != DICTIONARY->end() )
+			{
+				pString = i->second;
+			}
+			else
+			{
+				(*DICTIONARY)[Key] = (CSG_String *)(pString = new CSG_String(Value));
+			}
+		}
+	}
+	else if( !VALUES_STRING[Row] )
+	{
+		return( false );
+	}
+
+	VALUES_STRING[Row] = pString; _Set_Valid(Row);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Returns the number of distinct strings stored in the
+* dictionary of a string column. Strings are not removed from
+* the dictionary when rows change or are deleted.
+*/
+size_t CSG_Table_Column::Get_Dictionary_Size(void) const
+{
+	return( m_Dictionary ? DICTIONARY->size() : 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Row, const CSG_Bytes &Value)
+{
+	if( m_Type != SG_TABLE_VALUE_TYPE_Binary )
+	{
+		return( Set_Value(Row, (const SG_Char *)Value.Get_Bytes()) );
+	}
+
+	if( !VALUES_BINARY[Row] )
+	{
+		VALUES_BINARY[Row] = new CSG_Bytes;
+	}
+
+	bool bResult = VALUES_BINARY[Row]->Create(Value); _Set_Valid(Row);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Row, const SG_Char *Value)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String:
+		return( Value ? _Set_String(Row, Value) : false );
+
+	case SG_TABLE_VALUE_TYPE_Binary:
+		return( Set_Value(Row, CSG_Bytes((BYTE *)Value, (int)(Value && *Value ? SG_STR_LEN(Value) : 0))) );
+
+	case SG_TABLE_VALUE_TYPE_Date:
+		return( Set_Value(Row, SG_Date_To_JulianDayNumber(Value)) );
+
+	case SG_TABLE_VALUE_TYPE_Double: {
+		double d; CSG_String s(Value);
+
+		return( s.asDouble(d) ? Set_Value(Row, d) : false ); }
+
+	default: {
+		int i; CSG_String s(Value);
+
+		return( s.asInt(i) ? Set_Value(Row, i) : false ); }
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Row, int Value)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Int:
+		if( VALUES_INT[Row] != Value )
+		{
+			VALUES_INT[Row] = Value; _Set_Valid(Row);
+
+			return( true );
+		}
+		return( false );
+
+	case SG_TABLE_VALUE_TYPE_String: return( Set_Value(Row, CSG_String::Format("%d", Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Row, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_Long  : return( Set_Value(Row, (sLong )Value) );
+	default                        : return( Set_Value(Row, (double)Value) );
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Row, sLong Value)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Long:
+		if( VALUES_LONG[Row] != Value )
+		{
+			VALUES_LONG[Row] = Value; _Set_Valid(Row);
+
+			return( true );
+		}
+		return( false );
+
+	case SG_TABLE_VALUE_TYPE_String: return( Set_Value(Row, CSG_String::Format("%lld", Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Row, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_Int   : return( Set_Value(Row, (int   )Value) );
+	default                        : return( Set_Value(Row, (double)Value) );
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Row, double Value)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double:
+		if( VALUES_DOUBLE[Row] != Value )
+		{
+			VALUES_DOUBLE[Row] = Value; _Set_Valid(Row);
+
+			return( true );
+		}
+		return( false );
+
+	case SG_TABLE_VALUE_TYPE_String: return( Set_Value(Row, CSG_String::Format("%f", Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Row, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_Long  : return( Set_Value(Row, (sLong)Value) );
+	default                        : return( Set_Value(Row, (int  )Value) );
+	}
+}
+
+//---------------------------------------------------------
+/**
+* Assigns the value the same way the assignment operators of
+* the CSG_Table_Value classes do for the column's value type.
+*/
+bool CSG_Table_Column::Set_Value(sLong Row, const CSG_Table_Value &Value)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Row, Value.asBinary()) );
+	case SG_TABLE_VALUE_TYPE_String: return( Set_Value(Row, Value.asString()) );
+	case SG_TABLE_VALUE_TYPE_Int   : return( Set_Value(Row, Value.asInt   ()) );
+	case SG_TABLE_VALUE_TYPE_Long  : return( Set_Value(Row, Value.asLong  ()) );
+	case SG_TABLE_VALUE_TYPE_Double: return( Set_Value(Row, Value.asDouble()) );
+
+	case SG_TABLE_VALUE_TYPE_Date  :
+		if( Value.Get_Type() == SG_TABLE_VALUE_TYPE_Binary || Value.Get_Type() == SG_TABLE_VALUE_TYPE_String )
+		{
+			return( Set_Value(Row, Value.asString()) );
+		}
+
+		return( Set_Value(Row, Value.asDouble()) );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Bytes CSG_Table_Column::asBinary(sLong Row) const
+{
+	if( m_Type == SG_TABLE_VALUE_TYPE_Binary )
+	{
+		return( VALUES_BINARY[Row] ? *VALUES_BINARY[Row] : CSG_Bytes() );
+	}
+
+	CSG_String Buffer; const SG_Char *s = asString(Row, Buffer);
+
+	return( CSG_Bytes((BYTE *)s, (int)(s && *s ? SG_STR_LEN(s) : 0) * sizeof(SG_Char)) );
+}
+
+//---------------------------------------------------------
+/**
+* Strings are returned directly from the dictionary. Numbers and
+* dates are formatted into the caller's Buffer, which then owns
+* the returned text.
+*/
+const SG_Char * CSG_Table_Column::asString(sLong Row, CSG_String &Buffer, int Decimals) const
+{
+	CSG_String &s = Buffer;
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( VALUES_STRING[Row] ? VALUES_STRING[Row]->c_str() : SG_T("") );
+	case SG_TABLE_VALUE_TYPE_Binary: return( VALUES_BINARY[Row] ? (const SG_Char *)VALUES_BINARY[Row]->Get_Bytes() : NULL );
+
+	case SG_TABLE_VALUE_TYPE_Int   : s.Printf("%d"  , VALUES_INT [Row]); break;
+	case SG_TABLE_VALUE_TYPE_Long  : s.Printf("%lld", VALUES_LONG[Row]); break;
+	case SG_TABLE_VALUE_TYPE_Double: s = SG_Get_String(VALUES_DOUBLE[Row], Decimals); break;
+
+	case SG_TABLE_VALUE_TYPE_Date  :	// an unset date is an empty string, just like with CSG_Table_Value_Date
+		if( VALUES_DOUBLE[Row] == 0. ) { s.Clear(); } else { s = SG_JulianDayNumber_To_Date(VALUES_DOUBLE[Row]); } break;
+	}
+
+	return( s.c_str() );
+}
+
+//---------------------------------------------------------
+int CSG_Table_Column::asInt(sLong Row) const
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( VALUES_STRING[Row] ? VALUES_STRING[Row]->asInt() : 0 );
+	case SG_TABLE_VALUE_TYPE_Binary: return( VALUES_BINARY[Row] ? VALUES_BINARY[Row]->Get_Count() : 0 );
+	case SG_TABLE_VALUE_TYPE_Int   : return(      VALUES_INT   [Row] );
+	case SG_TABLE_VALUE_TYPE_Long  : return( (int)VALUES_LONG  [Row] );
+	default                        : return( (int)VALUES_DOUBLE[Row] );
+	}
+}
+
+//---------------------------------------------------------
+sLong CSG_Table_Column::asLong(sLong Row) const
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( VALUES_STRING[Row] ? VALUES_STRING[Row]->asInt() : 0 );
+	case SG_TABLE_VALUE_TYPE_Binary: return( VALUES_BINARY[Row] ? VALUES_BINARY[Row]->Get_Count() : 0 );
+	case SG_TABLE_VALUE_TYPE_Int   : return(        VALUES_INT   [Row] );
+	case SG_TABLE_VALUE_TYPE_Long  : return(        VALUES_LONG  [Row] );
+	default                        : return( (sLong)VALUES_DOUBLE[Row] );
+	}
+}
+
+//---------------------------------------------------------
+double CSG_Table_Column::asDouble(sLong Row) const
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_String: return( VALUES_STRING[Row] ? VALUES_STRING[Row]->asDouble() : 0. );
+	case SG_TABLE_VALUE_TYPE_Binary: return( 0. );
+	case SG_TABLE_VALUE_TYPE_Int   : return( VALUES_INT   [Row] );
+	case SG_TABLE_VALUE_TYPE_Long  : return( (double)VALUES_LONG[Row] );
+	default                        : return( VALUES_DOUBLE[Row] );
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -645,7 +645,7 @@ void CSG_Table_DBase::Flush_Record(void)
 //---------------------------------------------------------
 bool CSG_Table_DBase::isDeleted(void)
 {
-	return( m_hFile && *m_Record == '*' );
+	return( m_hFile && isDeleted(m_Record) );
 }
 
 //---------------------------------------------------------
@@ -666,41 +666,75 @@ bool CSG_Table_DBase::asInt(int iField, int &Value)
 //---------------------------------------------------------
 bool CSG_Table_DBase::asDouble(int iField, double &Value)
 {
-	if( !m_hFile || iField < 0 || iField >= m_nFields )
+	return( m_hFile && asDouble(m_Record, iField, Value) );
+}
+
+//---------------------------------------------------------
+CSG_String CSG_Table_DBase::asString(int iField)
+{
+	return( m_hFile ? asString(m_Record, iField) : CSG_String() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table_DBase::isDeleted(const char *Record) const
+{
+	return( Record && *Record == '*' );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_DBase::asDouble(const char *Record, int iField, double &Value) const
+{
+	if( !Record || iField < 0 || iField >= m_nFields )
 	{
 		return( false );
 	}
 
 	//-----------------------------------------------------
-	CSG_String	s;
+	char	s[256];	int	n	= 0;
 
-	char *c	= m_Record + m_Fields[iField].Offset;
+	const char *c	= Record + m_Fields[iField].Offset;
 
-	for(int i=0; i<m_Fields[iField].Width && *c; i++, c++)
+	for(n=0; n<m_Fields[iField].Width && c[n]; n++)
 	{
-		s	+= *c;
+		s[n]	= c[n] == ',' ? '.' : c[n];
 	}
 
+	s[n]	= '\0';
+
 	//-----------------------------------------------------
 	if( m_Fields[iField].Type == DBF_FT_FLOAT
 	||  m_Fields[iField].Type == DBF_FT_NUMERIC )
 	{
-		s.Replace(",", ".");
+		char	*end;	double	d	= strtod(s, &end);
+
+		if( end > s )
+		{
+			Value	= d;
 
-		return( s.asDouble(Value) );
+			return( true );
+		}
+
+		return( false );
 	}
 
 	//-----------------------------------------------------
 	if( m_Fields[iField].Type == DBF_FT_DATE )
 	{
-		if( s.Length() < 8 )
+		if( n < 8 )
 		{
 			return( false );
 		}
 
-		int	d	= s.Mid(6, 2).asInt(); if( d < 1 ) d = 1; else if( d > 31 ) d = 31;
-		int	m	= s.Mid(4, 2).asInt(); if( m < 1 ) m = 1; else if( m > 12 ) m = 12;
-		int	y	= s.Mid(0, 4).asInt();
+		char	t[8];
+
+		memcpy(t, s + 6, 2); t[2] = '\0'; int d = atoi(t); if( d < 1 ) d = 1; else if( d > 31 ) d = 31;
+		memcpy(t, s + 4, 2); t[2] = '\0'; int m = atoi(t); if( m < 1 ) m = 1; else if( m > 12 ) m = 12;
+		memcpy(t, s + 0, 4); t[4] = '\0'; int y = atoi(t);
 
 		Value	= 10000 * y + 100 * m + d;
 	}
@@ -710,11 +744,11 @@ bool CSG_Table_DBase::asDouble(int iField, double &Value)
 }
 
 //---------------------------------------------------------
-CSG_String CSG_Table_DBase::asString(int iField)
+CSG_String CSG_Table_DBase::asString(const char *Record, int iField) const
 {
 	CSG_String	Value;
 
-	if( !m_hFile || iField < 0 || iField >= m_nFields )
+	if( !Record || iField < 0 || iField >= m_nFields )
 	{
 		return( Value );
 	}
@@ -725,7 +759,7 @@ CSG_String CSG_Table_DBase::asString(int iField)
 		switch( m_Encoding )
 		{
 		case SG_FILE_ENCODING_ANSI: default:
-		{	char *s	= m_Record + m_Fields[iField].Offset;
+		{	const char *s	= Record + m_Fields[iField].Offset;
 
 			for(int i=0; i<m_Fields[iField].Width && *s; i++, s++)
 			{
@@ -734,7 +768,7 @@ CSG_String CSG_Table_DBase::asString(int iField)
 		}	break;
 
 		case SG_FILE_ENCODING_UTF8:
-			Value	= CSG_String::from_UTF8(m_Record + m_Fields[iField].Offset, m_Fields[iField].Width);
+			Value	= CSG_String::from_UTF8(Record + m_Fields[iField].Offset, m_Fields[iField].Width);
 			break;
 		}
 
@@ -744,7 +778,7 @@ CSG_String CSG_Table_DBase::asString(int iField)
 	//-----------------------------------------------------
 	if( m_Fields[iField].Type == DBF_FT_DATE )	// SAGA(DD.MM.YYYY) from DBASE(YYYYMMDD)
 	{
-		char *s	= m_Record + m_Fields[iField].Offset;
+		const char *s	= Record + m_Fields[iField].Offset;
 
 		Value	+= s[0];	// Y1
 		Value	+= s[1];	// Y2
@@ -120,6 +120,8 @@ public:
 	int							Get_File_Position	(void);
 	int							Get_File_Length		(void)	{	return( m_nFileBytes );	}
 	int							Get_Count	(void)	{	return( m_nRecords   );	}
+	int							Get_Header_Bytes	(void)	{	return( m_nHeaderBytes );	}
+	int							Get_Record_Bytes	(void)	{	return( m_nRecordBytes );	}
 
 	//-----------------------------------------------------
 	bool						Move_First			(void);
@@ -136,6 +138,12 @@ public:
 	bool						asDouble			(int iField, double &Value);
 	CSG_String					asString			(int iField);
 
+	//-----------------------------------------------------
+	// decoding of raw records, e.g. from a memory mapped file
+	bool						isDeleted			(const char *Record)								const;
+	bool						asDouble			(const char *Record, int iField, double &Value)	const;
+	CSG_String					asString			(const char *Record, int iField)					const;
+
 	//-----------------------------------------------------
 	bool						Set_Value			(int iField, double            Value);
 	bool						Set_Value			(int iField, const CSG_String &Value);
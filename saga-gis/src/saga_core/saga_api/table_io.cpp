@@ -312,7 +312,7 @@ bool CSG_Table::_Load_Text(const CSG_String &FileName, bool bHeadline, const SG_
 	}
 
 	//-----------------------------------------------------
-	CSG_Table	Table;
+	CSG_Table	Table;	Table.Set_Columnar();	// all values are read as strings first, which are stored only once per distinct value in columnar mode
 
 	_Load_Text_Trim(sLine, Separator);
 
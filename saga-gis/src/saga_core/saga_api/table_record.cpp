@@ -65,9 +65,15 @@ CSG_Table_Record::CSG_Table_Record(CSG_Table *pTable, sLong Index)
 {
 	m_pTable = pTable;
 	m_Index  = Index;
+	m_Slot   = -1;
 	m_Flags  = 0;
 
-	if( m_pTable && m_pTable->Get_Field_Count() > 0 )
+	if( m_pTable && m_pTable->is_Columnar() )	// values are stored in the table's columns
+	{
+		m_Values = NULL;
+		m_Slot   = m_pTable->_Add_Slot();
+	}
+	else if( m_pTable && m_pTable->Get_Field_Count() > 0 )
 	{
 		m_Values = (CSG_Table_Value **)SG_Malloc(m_pTable->Get_Field_Count() * sizeof(CSG_Table_Value *));
 
@@ -90,7 +96,13 @@ CSG_Table_Record::~CSG_Table_Record(void)
 		m_pTable->Select(m_Index, true);
 	}
 
-	if( m_pTable->Get_Field_Count() > 0 )
+	if( m_Slot >= 0 )
+	{
+		_Del_Proxies();
+
+		m_pTable->_Del_Slot(m_Slot);
+	}
+	else if( m_pTable->Get_Field_Count() > 0 )
 	{
 		for(int iField=0; iField<m_pTable->Get_Field_Count(); iField++)
 		{
@@ -135,6 +147,62 @@ CSG_Table_Value * CSG_Table_Record::_Create_Value(TSG_Data_Type Type)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Records of columnar tables create their value objects only on
+* demand, i.e. when requested with Get_Value() or the [] operator.
+* These are light-weight references to the table's columns and
+* are dropped again whenever the table's fields change.
+*/
+CSG_Table_Value * CSG_Table_Record::_Get_Proxy(int Field) const
+{
+	CSG_Table_Record *pRecord = (CSG_Table_Record *)this; CSG_Table_Value *pValue = NULL;
+
+	#pragma omp critical(CSG_Table_Record_Proxy)	// created on first access, the same record might be read by several threads
+	{
+		if( !pRecord->m_Values && m_Slot >= 0 )
+		{
+			int nFields = m_pTable->Get_Field_Count();
+
+			CSG_Table_Value **Values = (CSG_Table_Value **)SG_Malloc((nFields + 1) * sizeof(CSG_Table_Value *));
+
+			for(int iField=0; iField<nFields; iField++)
+			{
+				Values[iField] = new CSG_Table_Value_Column(m_pTable->m_Columns[iField], m_Slot);
+			}
+
+			Values[nFields] = NULL;	// terminates the array, so that proxies can be deleted without knowing the previous field count
+
+			pRecord->m_Values = Values;
+		}
+
+		pValue = m_Values ? m_Values[Field] : NULL;
+	}
+
+	return( pValue );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Record::_Del_Proxies(void)
+{
+	if( m_Slot >= 0 && m_Values )
+	{
+		for(int iField=0; m_Values[iField]; iField++)
+		{
+			delete(m_Values[iField]);
+		}
+
+		SG_FREE_SAFE(m_Values);
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -142,6 +210,11 @@ CSG_Table_Value * CSG_Table_Record::_Create_Value(TSG_Data_Type Type)
 //---------------------------------------------------------
 bool CSG_Table_Record::_Add_Field(int add_Field)
 {
+	if( m_Slot >= 0 )
+	{
+		return( _Del_Proxies() );
+	}
+
 	if( add_Field < 0 )
 	{
 		add_Field	= 0;
@@ -166,6 +239,11 @@ bool CSG_Table_Record::_Add_Field(int add_Field)
 //---------------------------------------------------------
 bool CSG_Table_Record::_Del_Field(int del_Field)
 {
+	if( m_Slot >= 0 )
+	{
+		return( _Del_Proxies() );
+	}
+
 	delete(m_Values[del_Field]);
 
 	for(int iField=del_Field; iField<m_pTable->Get_Field_Count(); iField++)
@@ -247,7 +325,7 @@ bool CSG_Table_Record::Set_Value(int Field, const CSG_Bytes &Value)
 {
 	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[Field]->Set_Value(Value) )
+		if( m_Slot >= 0 ? m_pTable->m_Columns[Field]->Set_Value(m_Slot, Value) : m_Values[Field]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -271,7 +349,7 @@ bool CSG_Table_Record::Set_Value(int Field, const CSG_String &Value)
 {
 	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[Field]->Set_Value(Value) )
+		if( m_Slot >= 0 ? m_pTable->m_Columns[Field]->Set_Value(m_Slot, Value.c_str()) : m_Values[Field]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -306,7 +384,7 @@ bool CSG_Table_Record::Set_Value(int Field, double Value)
 {
 	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[Field]->Set_Value(Value) )
+		if( m_Slot >= 0 ? m_pTable->m_Columns[Field]->Set_Value(m_Slot, Value) : m_Values[Field]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -367,7 +445,12 @@ bool CSG_Table_Record::Set_NoData(int Field)
 {
 	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
 	{
-		switch( m_pTable->Get_Field_Type(Field) )
+		if( m_Slot >= 0 )
+		{
+			if( !m_pTable->m_Columns[Field]->Set_NoData(m_Slot) )
+				return( false );
+		}
+		else switch( m_pTable->Get_Field_Type(Field) )
 		{
 		default:
 		case SG_DATATYPE_String:
@@ -417,6 +500,11 @@ bool CSG_Table_Record::is_NoData(int Field) const
 {
 	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
 	{
+		if( m_Slot >= 0 )
+		{
+			return( m_pTable->m_Columns[Field]->is_NoData(m_Slot) );
+		}
+
 		switch( m_pTable->Get_Field_Type(Field) )
 		{
 		default:
@@ -460,7 +548,19 @@ bool CSG_Table_Record::is_NoData(const CSG_String &Field) const
 //---------------------------------------------------------
 const SG_Char * CSG_Table_Record::asString(int Field, int Decimals) const
 {
-	return( Field >= 0 && Field < m_pTable->Get_Field_Count() ? m_Values[Field]->asString(Decimals) : NULL );
+	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
+	{
+		if( m_Slot >= 0 && m_pTable->m_Columns[Field]->Get_Type() == SG_TABLE_VALUE_TYPE_String )
+		{
+			CSG_String Unused;	// strings are returned from the column's dictionary
+
+			return( m_pTable->m_Columns[Field]->asString(m_Slot, Unused) );
+		}
+
+		return( m_Slot >= 0 ? _Get_Proxy(Field)->asString(Decimals) : m_Values[Field]->asString(Decimals) );	// the proxy holds the text of numbers and dates
+	}
+
+	return( NULL );
 }
 
 const SG_Char * CSG_Table_Record::asString(const CSG_String &Field, int Decimals) const
@@ -493,7 +593,12 @@ short CSG_Table_Record::asShort(const CSG_String &Field) const
 //---------------------------------------------------------
 int CSG_Table_Record::asInt(int Field) const
 {
-	return( Field >= 0 && Field < m_pTable->Get_Field_Count() ? m_Values[Field]->asInt() : 0 );
+	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
+	{
+		return( m_Slot >= 0 ? m_pTable->m_Columns[Field]->asInt(m_Slot) : m_Values[Field]->asInt() );
+	}
+
+	return( 0 );
 }
 
 int CSG_Table_Record::asInt(const CSG_String &Field) const
@@ -504,7 +609,12 @@ int CSG_Table_Record::asInt(const CSG_String &Field) const
 //---------------------------------------------------------
 sLong CSG_Table_Record::asLong(int Field) const
 {
-	return( Field >= 0 && Field < m_pTable->Get_Field_Count() ? m_Values[Field]->asLong() : 0 );
+	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
+	{
+		return( m_Slot >= 0 ? m_pTable->m_Columns[Field]->asLong(m_Slot) : m_Values[Field]->asLong() );
+	}
+
+	return( 0 );
 }
 
 sLong CSG_Table_Record::asLong(const CSG_String &Field) const
@@ -526,7 +636,12 @@ float CSG_Table_Record::asFloat(const CSG_String &Field) const
 //---------------------------------------------------------
 double CSG_Table_Record::asDouble(int Field) const
 {
-	return( Field >= 0 && Field < m_pTable->Get_Field_Count() ? m_Values[Field]->asDouble() : 0. );
+	if( Field >= 0 && Field < m_pTable->Get_Field_Count() )
+	{
+		return( m_Slot >= 0 ? m_pTable->m_Columns[Field]->asDouble(m_Slot) : m_Values[Field]->asDouble() );
+	}
+
+	return( 0. );
 }
 
 double CSG_Table_Record::asDouble(const CSG_String &Field) const
@@ -549,7 +664,16 @@ bool CSG_Table_Record::Assign(CSG_Table_Record *pRecord)
 
 		for(int iField=0; iField<nFields; iField++)
 		{
-			*(m_Values[iField])	= *(pRecord->m_Values[iField]);
+			if( pRecord->m_Slot >= 0 )	// source is a columnar table
+			{
+				CSG_Table_Value_Column Value(pRecord->m_pTable->m_Columns[iField], pRecord->m_Slot);
+
+				if( m_Slot >= 0 ) { m_pTable->m_Columns[iField]->Set_Value(m_Slot, Value); } else { *(m_Values[iField]) = Value; }
+			}
+			else
+			{
+				if( m_Slot >= 0 ) { m_pTable->m_Columns[iField]->Set_Value(m_Slot, *(pRecord->m_Values[iField])); } else { *(m_Values[iField]) = *(pRecord->m_Values[iField]); }
+			}
 		}
 
 		Set_Modified();
@@ -627,6 +627,147 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Columnar Storage					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Typed, contiguous storage of one field's values as used by
+* tables in columnar mode (see CSG_Table::Set_Columnar()).
+* Numbers are kept in plain int, sLong or double arrays (dates
+* as Julian Day Numbers), strings are dictionary encoded with
+* each distinct string being stored only once, and a validity
+* bitmap tracks no-data rows. Value conversions follow those of
+* the corresponding CSG_Table_Value classes.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Table_Column
+{
+public:
+	CSG_Table_Column(TSG_Data_Type Type, const class CSG_Data_Object *pOwner = NULL);
+	virtual ~CSG_Table_Column(void);
+
+	TSG_Data_Type					Get_Data_Type	(void)				const	{	return( m_Data_Type );	}
+	TSG_Table_Value_Type			Get_Type		(void)				const	{	return( m_Type      );	}
+
+	sLong							Get_Size		(void)				const	{	return( m_nRows     );	}
+	bool							Set_Size		(sLong nRows);
+
+	bool							Reset			(sLong Row);
+
+	//-----------------------------------------------------
+	bool							Set_Value		(sLong Row, const CSG_Bytes       &Value);
+	bool							Set_Value		(sLong Row, const SG_Char         *Value);
+	bool							Set_Value		(sLong Row, int                    Value);
+	bool							Set_Value		(sLong Row, sLong                  Value);
+	bool							Set_Value		(sLong Row, double                 Value);
+	bool							Set_Value		(sLong Row, const CSG_Table_Value &Value);
+
+	bool							Set_NoData		(sLong Row);
+	bool							is_NoData		(sLong Row)			const	{	return( (m_Valid[Row >> 3] & (1 << (Row & 7))) == 0 );	}
+
+	void							Update_NoData	(void);
+
+	//-----------------------------------------------------
+	CSG_Bytes						asBinary		(sLong Row)			const;
+	const SG_Char *					asString		(sLong Row, CSG_String &Buffer, int Decimals = -99)	const;
+	int								asInt			(sLong Row)			const;
+	sLong							asLong			(sLong Row)			const;
+	double							asDouble		(sLong Row)			const;
+
+	//-----------------------------------------------------
+	size_t							Get_Dictionary_Size	(void)			const;
+
+
+private:
+
+	TSG_Data_Type					m_Data_Type;
+
+	TSG_Table_Value_Type			m_Type;
+
+	sLong							m_nRows, m_nBuffer;
+
+	BYTE							*m_Valid;
+
+	void							*m_Values, *m_Dictionary;
+
+	const class CSG_Data_Object		*m_pOwner;
+
+
+	bool							_is_Valid		(sLong Row)			const;
+	void							_Set_Valid		(sLong Row);
+
+	bool							_Set_String		(sLong Row, const SG_Char *Value);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* A light-weight CSG_Table_Value referring to a row of a
+* CSG_Table_Column, so that columnar tables can still hand out
+* value references through CSG_Table_Record::Get_Value().
+*/
+//---------------------------------------------------------
+class CSG_Table_Value_Column : public CSG_Table_Value
+{
+public:
+	CSG_Table_Value_Column(CSG_Table_Column *pColumn, sLong Row) : m_Row(Row), m_pColumn(pColumn)	{}
+	virtual ~CSG_Table_Value_Column(void) {}
+
+	virtual TSG_Table_Value_Type	Get_Type		(void)				const	{	return( m_pColumn->Get_Type() );	}
+
+	//-----------------------------------------------------
+	virtual bool					Set_Value		(const CSG_Bytes &Value)	{	return( m_pColumn->Set_Value(m_Row, Value) );	}
+	virtual bool					Set_Value		(const SG_Char   *Value)	{	return( m_pColumn->Set_Value(m_Row, Value) );	}
+	virtual bool					Set_Value		(int              Value)	{	return( m_pColumn->Set_Value(m_Row, Value) );	}
+	virtual bool					Set_Value		(sLong            Value)	{	return( m_pColumn->Set_Value(m_Row, Value) );	}
+	virtual bool					Set_Value		(double           Value)	{	return( m_pColumn->Set_Value(m_Row, Value) );	}
+
+	//-----------------------------------------------------
+	virtual CSG_Bytes				asBinary		(void)				const	{	return( m_pColumn->asBinary(m_Row          ) );	}
+	virtual const SG_Char *			asString		(int Decimals =-99)	const	{	return( m_pColumn->asString(m_Row, m_String, Decimals) );	}
+	virtual int						asInt			(void)				const	{	return( m_pColumn->asInt   (m_Row          ) );	}
+	virtual sLong					asLong			(void)				const	{	return( m_pColumn->asLong  (m_Row          ) );	}
+	virtual double					asDouble		(void)				const	{	return( m_pColumn->asDouble(m_Row          ) );	}
+
+	//-----------------------------------------------------
+	virtual bool					is_Equal		(const CSG_Table_Value &Value)	const
+	{
+		switch( Get_Type() )
+		{
+		case SG_TABLE_VALUE_TYPE_Binary:
+		case SG_TABLE_VALUE_TYPE_String: return( !SG_STR_CMP(asString(), Value.asString()) );
+		case SG_TABLE_VALUE_TYPE_Int   : return( asInt () == Value.asInt () );
+		case SG_TABLE_VALUE_TYPE_Long  : return( asLong() == Value.asLong() );
+		default                        : return( asDouble() == Value.asDouble() );
+		}
+	}
+
+	//-----------------------------------------------------
+	virtual CSG_Table_Value &		operator = (const SG_Char         *Value)	{	Set_Value(Value); return( *this );	}
+	virtual CSG_Table_Value &		operator = (double                 Value)	{	Set_Value(Value); return( *this );	}
+	virtual CSG_Table_Value &		operator = (const CSG_Table_Value &Value)	{	m_pColumn->Set_Value(m_Row, Value); return( *this );	}
+
+
+private:
+
+	sLong							m_Row;
+
+	CSG_Table_Column				*m_pColumn;
+
+	mutable CSG_String				m_String;	// holds formatted numbers and dates
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
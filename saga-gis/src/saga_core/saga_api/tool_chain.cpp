@@ -52,6 +52,12 @@
 
 #include "tool_chain.h"
 
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -245,6 +251,7 @@ bool CSG_Tool_Chain::Create(const CSG_MetaData &Chain)
 	}
 
 	m_bAddHistory	= IS_TRUE_PROPERTY(m_Chain["tools"], "history");
+	m_bParallel		= IS_TRUE_PROPERTY(m_Chain["tools"], "parallel");	// opt-in, independent tools are allowed to run concurrently
 
 	//-----------------------------------------------------
 	for(int i=0; i<m_Chain["parameters"].Get_Children_Count(); i++)
@@ -473,9 +480,22 @@ bool CSG_Tool_Chain::On_Execute(void)
 		Error_Set(_TL("no data objects"));
 	}
 
-	for(int i=0; bResult && i<m_Chain["tools"].Get_Children_Count(); i++)
+	const CSG_MetaData &Tools = m_Chain["tools"];
+
+	bool bParallel = m_bParallel && !has_GUI() && SG_OMP_Get_Max_Num_Threads() > 1;
+
+	for(int i=0; bResult && i<Tools.Get_Children_Count(); )
 	{
-		bResult = Tool_Run(m_Chain["tools"][i]);
+		int n = 1;	// consecutive tools (and comments) build a segment, any other element is a sequential barrier
+
+		while( bParallel && i + n < Tools.Get_Children_Count() && (Tools[i + n].Cmp_Name("tool") || Tools[i + n].Cmp_Name("comment")) )
+		{
+			n++;
+		}
+
+		bResult = n > 1 && Tools[i].Cmp_Name("tool") ? Tool_Run_Parallel(Tools, i, n) : Tool_Run(Tools[i]);
+
+		i += n > 1 && Tools[i].Cmp_Name("tool") ? n : 1;
 	}
 
 	Data_Finalize();
@@ -1299,51 +1319,396 @@ bool CSG_Tool_Chain::Tool_Run(const CSG_MetaData &Tool, bool bShowError)
 	}
 
 	//-----------------------------------------------------
+	// tool creation, initialization and finalization access the
+	// chain's data and are serialized, only the execution itself
+	// might run concurrently (see Tool_Run_Parallel())
+
 	const SG_Char *Name = Tool.Get_Property("tool") ? Tool.Get_Property("tool") : Tool.Get_Property("module");
 
-	CSG_Tool *pTool = SG_Get_Tool_Library_Manager().Create_Tool(Tool.Get_Property("library"), Name,
-		IS_TRUE_PROPERTY(Tool, "with_gui")	// this option allows to run a tool in 'gui-mode', e.g. to popup variogram dialogs for kriging interpolation
-	);
+	CSG_Tool *pTool = NULL; bool bInitialized = false, bResult = false;
 
-	if(	!pTool )
+	#pragma omp critical(SG_Tool_Chain)
 	{
-		if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("could not find tool"), Tool.Get_Property("library"), Name);
+		pTool = SG_Get_Tool_Library_Manager().Create_Tool(Tool.Get_Property("library"), Name,
+			IS_TRUE_PROPERTY(Tool, "with_gui")	// this option allows to run a tool in 'gui-mode', e.g. to popup variogram dialogs for kriging interpolation
+		);
+
+		if(	!pTool )
+		{
+			if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("could not find tool"), Tool.Get_Property("library"), Name);
+		}
+		else
+		{
+			Process_Set_Text(pTool->Get_Name());
+
+			pTool->Settings_Push(&m_Data_Manager);
+
+			if( !pTool->On_Before_Execution() )
+			{
+				if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("before tool execution check failed"), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+			}
+			else if( !Tool_Initialize(Tool, pTool) )
+			{
+				if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("tool initialization failed"        ), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+			}
+			else
+			{
+				bInitialized = true;
+			}
+		}
+	}
 
+	if( !pTool )
+	{
 		return( false );
 	}
 
 	//-----------------------------------------------------
-	Process_Set_Text(pTool->Get_Name());
+	if( bInitialized )
+	{
+		bResult = pTool->Execute(m_bAddHistory);
+	}
 
-	pTool->Settings_Push(&m_Data_Manager);
+	//-----------------------------------------------------
+	#pragma omp critical(SG_Tool_Chain)
+	{
+		if( bInitialized && !bResult )
+		{
+			Message_Fmt("%s [%s].[%s]", _TL("tool execution failed"), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+		}
 
-	bool bResult = false;
+		if( bResult )
+		{
+			pTool->On_After_Execution();
+		}
+
+		Tool_Finalize(Tool, pTool);
+
+		pTool->Settings_Pop();
+
+		SG_Get_Tool_Library_Manager().Delete_Tool(pTool);
+	}
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+struct CSG_Tool_Chain::SSchedule
+{
+	bool								bResult;
+
+	int									nRunning, nThreads;
+
+	CSG_Array_Int						nPending;
+
+	std::vector<const CSG_MetaData *>	Tools;
+
+	std::vector<CSG_Array_Int>			Successors;
+};
+
+//---------------------------------------------------------
+static bool Has_ID(const CSG_Strings &IDs, const CSG_String &ID)
+{
+	for(int i=0; i<IDs.Get_Count(); i++)
+	{
+		if( !ID.is_Empty() && !IDs[i].Cmp(ID) )
+		{
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+/**
+  * Returns the inputs a tool element might change in place.
+  * These are inputs of tool elements with the attribute
+  * 'inplace', inputs with this attribute themselves and inputs
+  * whose tool parameter is declared as input and output.
+*/
+static CSG_Strings Get_Inplace_Inputs(const CSG_MetaData &Tool)
+{
+	const SG_Char *Name = Tool.Get_Property("tool") ? Tool.Get_Property("tool") : Tool.Get_Property("module");
+
+	CSG_Tool *pTool = SG_Get_Tool_Library_Manager().Create_Tool(Tool.Get_Property("library"), Name);
+
+	CSG_Strings Inputs;
+
+	for(int i=0; i<Tool.Get_Children_Count(); i++)
+	{
+		if( Tool[i].Cmp_Name("input") )
+		{
+			CSG_Parameter *pParameter = pTool ? (*pTool->Get_Parameters())(Tool[i].Get_Property("id")) : NULL;
+
+			if( IS_TRUE_PROPERTY(Tool, "inplace") || IS_TRUE_PROPERTY(Tool[i], "inplace") || (pParameter && pParameter->is_Input() && pParameter->is_Output()) )
+			{
+				Inputs += Tool[i].Get_Content().BeforeFirst('[');
+			}
+		}
+	}
+
+	if( pTool )
+	{
+		SG_Get_Tool_Library_Manager().Delete_Tool(pTool);
+	}
+
+	return( Inputs );
+}
+
+//---------------------------------------------------------
+// UI callbacks of concurrently running tools are serialized.
+
+static int					gSG_Tool_Chain_Callback_nUsers	= 0;
+
+static TSG_PFNC_UI_Callback	gSG_Tool_Chain_Callback			= NULL;
+
+#ifdef _OPENMP
+static omp_nest_lock_t		gSG_Tool_Chain_Callback_Lock;	// re-entrant, a callback might trigger further callbacks
+#endif
+
+//---------------------------------------------------------
+static int Tool_Chain_Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter &Param_2)
+{
+	#ifdef _OPENMP
+	omp_set_nest_lock(&gSG_Tool_Chain_Callback_Lock);
+	#endif
+
+	int Result = gSG_Tool_Chain_Callback ? gSG_Tool_Chain_Callback(ID, Param_1, Param_2) : 0;
+
+	#ifdef _OPENMP
+	omp_unset_nest_lock(&gSG_Tool_Chain_Callback_Lock);
+	#endif
+
+	return( Result );
+}
+
+//---------------------------------------------------------
+static void Tool_Chain_Callback_Serialize(bool bOn)
+{
+	#pragma omp critical(SG_Tool_Chain_Callback)
+	{
+		if( bOn && gSG_Tool_Chain_Callback_nUsers++ == 0 )
+		{
+			#ifdef _OPENMP
+			static bool bLock = false;	// never destroyed, other threads might just be calling
 
-	if( !pTool->On_Before_Execution() )
+			if( !bLock )
+			{
+				omp_init_nest_lock(&gSG_Tool_Chain_Callback_Lock); bLock = true;
+			}
+			#endif
+
+			gSG_Tool_Chain_Callback = SG_Get_UI_Callback();
+
+			SG_Set_UI_Callback(Tool_Chain_Callback);
+		}
+		else if( !bOn && --gSG_Tool_Chain_Callback_nUsers == 0 )
+		{
+			SG_Set_UI_Callback(gSG_Tool_Chain_Callback);
+		}
+	}
+}
+
+//---------------------------------------------------------
+/**
+  * Runs a segment of consecutive tool elements. Dependencies
+  * are inferred from the data variable names used as input
+  * and output (read after write, write after read and write
+  * after write, all in the order given by the tool chain).
+  * Inputs that might be changed in place count as written, too
+  * (see Get_Inplace_Inputs()). Independent tools are executed
+  * concurrently, each getting its share of the threads budget
+  * for its own parallel loops. Their UI callbacks, i.e. messages
+  * and progress, are serialized.
+*/
+//---------------------------------------------------------
+bool CSG_Tool_Chain::Tool_Run_Parallel(const CSG_MetaData &Tools, int First, int Count)
+{
+	SSchedule Schedule; std::vector<CSG_Strings> Reads, Writes;
+
+	for(int i=First; i<First+Count && i<Tools.Get_Children_Count(); i++)
+	{
+		if( Tools[i].Cmp_Name("tool") )
+		{
+			const CSG_MetaData &Tool = Tools[i]; CSG_Strings In, Out(Get_Inplace_Inputs(Tool));
+
+			for(int j=0; j<Tool.Get_Children_Count(); j++)
+			{
+				if( Tool[j].Cmp_Name("output") )
+				{
+					Out += Tool[j].Get_Content();
+				}
+				else if( Tool[j].Cmp_Name("input") || Tool[j].Cmp_Name("option") )	// options might refer to data too (e.g. grid systems or fixed tables)
+				{
+					In  += Tool[j].Get_Content().BeforeFirst('[');
+				}
+			}
+
+			Schedule.Tools.push_back(&Tool); Reads.push_back(In); Writes.push_back(Out);
+		}
+	}
+
+	int n = (int)Schedule.Tools.size();
+
+	//-----------------------------------------------------
+	Schedule.Successors.resize(n); Schedule.nPending.Create(n); CSG_Array_Int Level(n), Width(n);
+
+	for(int j=0; j<n; j++)
+	{
+		Schedule.nPending[j] = 0; Level[j] = 0; Width[j] = 0;
+
+		for(int i=0; i<j; i++)
+		{
+			bool bDepends = false;
+
+			for(int k=0; !bDepends && k<Writes[i].Get_Count(); k++)
+			{
+				bDepends = Has_ID(Reads[j], Writes[i][k]) || Has_ID(Writes[j], Writes[i][k]);	// read after write, write after write
+			}
+
+			for(int k=0; !bDepends && k<Reads[i].Get_Count(); k++)
+			{
+				bDepends = Has_ID(Writes[j], Reads[i][k]);	// write after read
+			}
+
+			if( bDepends )
+			{
+				Schedule.Successors[i] += j; Schedule.nPending[j]++;
+
+				if( Level[j] < Level[i] + 1 )
+				{
+					Level[j] = Level[i] + 1;
+				}
+			}
+		}
+
+		Width[Level[j]]++;
+	}
+
+	//-----------------------------------------------------
+	int nWorkers = 1;
+
+	for(int i=0; i<n; i++)
+	{
+		if( nWorkers < Width[i] )
+		{
+			nWorkers = Width[i];
+		}
+	}
+
+	if( nWorkers > SG_OMP_Get_Max_Num_Threads() )
+	{
+		nWorkers = SG_OMP_Get_Max_Num_Threads();
+	}
+
+	if( nWorkers < 2 )	// no independent tools, just run them sequentially
 	{
-		if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("before tool execution check failed"), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+		for(int i=0; i<n; i++)
+		{
+			if( !Tool_Run(*Schedule.Tools[i]) )
+			{
+				return( false );
+			}
+		}
+
+		return( true );
 	}
-	else if( !Tool_Initialize(Tool, pTool) )
+
+	//-----------------------------------------------------
+	Schedule.bResult  = true;
+	Schedule.nRunning = 0;
+	Schedule.nThreads = SG_OMP_Get_Max_Num_Threads();
+
+	#ifdef _OPENMP
+	int Max_Levels = omp_get_max_active_levels(); omp_set_max_active_levels(Max_Levels < 2 ? 2 : Max_Levels);	// tools shall still run their own parallel loops
+	#endif
+
+	Tool_Chain_Callback_Serialize(true);
+
+	#pragma omp parallel num_threads(nWorkers)
+	#pragma omp single
 	{
-		if( bShowError ) Error_Fmt("%s [%s].[%s]", _TL("tool initialization failed"        ), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+		for(int i=0; i<n; i++)
+		{
+			if( Schedule.nPending[i] == 0 )
+			{
+				#pragma omp task firstprivate(i)
+				Tool_Run_Task(&Schedule, i);
+			}
+		}
 	}
-	else if( !(bResult = pTool->Execute(m_bAddHistory)) )
+
+	Tool_Chain_Callback_Serialize(false);
+
+	#ifdef _OPENMP
+	omp_set_max_active_levels(Max_Levels);
+	#endif
+
+	return( Schedule.bResult );
+}
+
+//---------------------------------------------------------
+void CSG_Tool_Chain::Tool_Run_Task(SSchedule *pSchedule, int iTool)
+{
+	bool bRun = false; int nThreads = 1;
+
+	#pragma omp critical(SG_Tool_Chain_Schedule)
 	{
-		Message_Fmt               ("%s [%s].[%s]", _TL("tool execution failed"             ), pTool->Get_Library().c_str(), pTool->Get_Name().c_str());
+		if( (bRun = pSchedule->bResult) == true )	// don't start any further tool after a failure
+		{
+			nThreads = pSchedule->nThreads / ++pSchedule->nRunning;
+		}
 	}
 
-	if( bResult )
+	bool bResult = false;
+
+	if( bRun )
 	{
-		pTool->On_After_Execution();
+		#ifdef _OPENMP
+		omp_set_num_threads(nThreads > 1 ? nThreads : 1);	// share the threads budget with the currently running tools
+		#endif
+
+		bResult = Tool_Run(*pSchedule->Tools[iTool]);
 	}
 
-	Tool_Finalize(Tool, pTool);
+	//-----------------------------------------------------
+	CSG_Array_Int Ready;
+
+	#pragma omp critical(SG_Tool_Chain_Schedule)
+	{
+		if( bRun )
+		{
+			pSchedule->nRunning--;
+		}
+
+		if( !bResult )
+		{
+			pSchedule->bResult = false;
+		}
+		else for(sLong i=0; i<pSchedule->Successors[iTool].Get_Size(); i++)
+		{
+			int j = pSchedule->Successors[iTool][i];
 
-	pTool->Settings_Pop();
+			if( --pSchedule->nPending[j] == 0 )
+			{
+				Ready += j;
+			}
+		}
+	}
 
-	SG_Get_Tool_Library_Manager().Delete_Tool(pTool);
+	for(sLong i=0; i<Ready.Get_Size(); i++)
+	{
+		int j = Ready[i];
 
-	return( bResult );
+		#pragma omp task firstprivate(j)
+		Tool_Run_Task(pSchedule, j);
+	}
 }
 
 
@@ -113,7 +113,9 @@ protected:
 
 private:
 
-	bool						m_bAddHistory;
+	struct SSchedule;
+
+	bool						m_bAddHistory, m_bParallel;
 
 	CSG_String					m_Library_Name, m_Menu;
 
@@ -147,6 +149,8 @@ private:
 	bool						ForEach_File			(const CSG_MetaData &Commands, const CSG_String &ListVarName, bool bIgnoreErrors);
 
 	bool						Tool_Run				(const CSG_MetaData &Tool, bool bShowError = true);
+	bool						Tool_Run_Parallel		(const CSG_MetaData &Tools, int First, int Count);
+	void						Tool_Run_Task			(SSchedule *pSchedule, int iTool);
 	bool						Tool_Check_Condition	(const CSG_MetaData &Tool);
 	bool						Tool_Get_Parameter		(const CSG_String ID, CSG_Parameters *pParameters, CSG_Parameter **ppParameter, CSG_Parameter **ppOwner = NULL);
 	bool						Tool_Get_Parameter		(const CSG_MetaData &Parameter, CSG_Tool *pTool  , CSG_Parameter **ppParameter, CSG_Parameter **ppOwner = NULL);
@@ -55,8 +55,41 @@
 #include <wx/filename.h>
 #include <wx/utils.h>
 
+#include "saga_api.h"
 #include "tool_chain.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Tools might be requested from concurrently running threads
+// (e.g. by tool chains or by a saga_cmd server). Loading
+// libraries and creating or deleting tool instances is
+// guarded by a reentrant lock, because library loading may
+// itself request further tools (e.g. data import tools).
+//---------------------------------------------------------
+class CSG_Tool_Library_Lock
+{
+#ifdef _OPENMP
+public:
+	CSG_Tool_Library_Lock(void)		{	omp_set_nest_lock  (&_Get_Lock());	}
+	~CSG_Tool_Library_Lock(void)	{	omp_unset_nest_lock(&_Get_Lock());	}
+
+private:
+	struct SLock { omp_nest_lock_t Lock; SLock(void) { omp_init_nest_lock(&Lock); } ~SLock(void) { omp_destroy_nest_lock(&Lock); } };
+
+	static omp_nest_lock_t &		_Get_Lock		(void)	{	static SLock Lock; return( Lock.Lock );	}
+#endif
+};
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -111,7 +144,10 @@ bool CSG_Tool_Library::_Destroy(void)
 		{
 			TSG_PFNC_TLB_Finalize TLB_Finalize = (TSG_PFNC_TLB_Finalize)m_pLibrary->GetSymbol(SYMBOL_TLB_Finalize);
 
-			TLB_Finalize();
+			if( !TLB_Finalize() )	// the library's code is still in use, e.g. by grid sources, so keep it loaded
+			{
+				m_pLibrary->Detach();
+			}
 		}
 
 		delete(m_pLibrary);
@@ -299,6 +335,8 @@ CSG_Tool_Library_Manager::CSG_Tool_Library_Manager(void)
 	m_pLibraries = NULL;
 	m_nLibraries = 0;
 
+	m_Index_bModified = false;
+
 	if( this == &g_Tool_Library_Manager )
 	{
 		CSG_Random::Initialize(); // initialize with current time on startup
@@ -395,6 +433,8 @@ bool CSG_Tool_Library_Manager::Add_Default_Libraries(bool bVerbose)
 		SG_UI_Msg_Lock(false);
 	}
 
+	Save_Index();
+
 	return( Get_Count() > 0 );
 }
 
@@ -408,6 +448,8 @@ CSG_Tool_Library * CSG_Tool_Library_Manager::Add_Library(const char       *File)
 CSG_Tool_Library * CSG_Tool_Library_Manager::Add_Library(const wchar_t    *File) { return( Add_Library(CSG_String(File)) ); }
 CSG_Tool_Library * CSG_Tool_Library_Manager::Add_Library(const CSG_String &File)
 {
+	CSG_Tool_Library_Lock Lock;
+
 	if( SG_File_Exists(File) == false )
 	{
 		return( NULL );
@@ -691,6 +733,8 @@ CSG_Tool_Library * CSG_Tool_Library_Manager::Get_Library(const char       *Name,
 CSG_Tool_Library * CSG_Tool_Library_Manager::Get_Library(const wchar_t    *Name, bool bLibrary, ESG_Library_Type Type) const { return( Get_Library(CSG_String(Name), bLibrary, Type) ); }
 CSG_Tool_Library * CSG_Tool_Library_Manager::Get_Library(const CSG_String &Name, bool bLibrary, ESG_Library_Type Type) const
 {
+	CSG_Tool_Library_Lock Lock;
+
 	if( bLibrary )
 	{
 		SG_Get_Tool_Library_Manager()._Add_Library(Name);
@@ -715,6 +759,17 @@ CSG_Tool_Library * CSG_Tool_Library_Manager::Get_Library(const CSG_String &Name,
 //---------------------------------------------------------
 bool CSG_Tool_Library_Manager::_Add_Library(const CSG_String &Library)
 {
+	if( !m_Index_File.is_Empty() )	// with an index the search has to be done only once per successfully loaded library
+	{
+		for(int i=0; i<m_Index_Resolved.Get_Count(); i++)
+		{
+			if( !m_Index_Resolved[i].Cmp(Library) )
+			{
+				return( true );
+			}
+		}
+	}
+
 	int bOkay = false;
 
 	SG_UI_ProgressAndMsg_Lock(true);
@@ -764,6 +819,13 @@ bool CSG_Tool_Library_Manager::_Add_Library(const CSG_String &Library)
 	//-----------------------------------------------------
 	SG_UI_ProgressAndMsg_Lock(false);
 
+	if( bOkay && !m_Index_File.is_Empty() )	// a failed search will be repeated, e.g. after a library has been installed
+	{
+		m_Index_Resolved += Library;
+	}
+
+	Save_Index();
+
 	return( bOkay );
 }
 
@@ -776,11 +838,25 @@ bool CSG_Tool_Library_Manager::_Add_Library_Chains(const CSG_String &Library, co
 	{
 		do
 		{
-			CSG_String path(SG_File_Make_Path(Directory, &file)); CSG_Tool_Chain Tool(path);
+			CSG_String path(SG_File_Make_Path(Directory, &file));
 
-			if( Tool.is_Okay() && Tool.Get_Library().Cmp(Library) == 0 && _Add_Tool_Chain(path, false) )
+			if( !m_Index_File.is_Empty() )	// don't parse each tool chain, just look up its library in the index
 			{
-				bOkay = true;
+				CSG_String Name;
+
+				if( _Index_Get_Library(path, Name) && Name.Cmp(Library) == 0 && _Add_Tool_Chain(path, false) )
+				{
+					bOkay = true;
+				}
+			}
+			else
+			{
+				CSG_Tool_Chain Tool(path);
+
+				if( Tool.is_Okay() && Tool.Get_Library().Cmp(Library) == 0 && _Add_Tool_Chain(path, false) )
+				{
+					bOkay = true;
+				}
 			}
 		}
 		while( dir.GetNext(&file) );
@@ -790,6 +866,162 @@ bool CSG_Tool_Library_Manager::_Add_Library_Chains(const CSG_String &Library, co
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Activates a persistent index of tool chain files, which keeps
+  * each file's library name together with its modification time.
+  * When requesting a tool by library name, tool chain files are
+  * then only parsed, if they are not yet indexed or have been
+  * modified since. Entries of files that do not exist anymore are
+  * removed when the index is loaded. The file is only written if
+  * the index has changed. An empty file name deactivates the
+  * index.
+*/
+//---------------------------------------------------------
+bool CSG_Tool_Library_Manager::Set_Index(const CSG_String &File)
+{
+	if( !File.Cmp(m_Index_File) )
+	{
+		return( true );
+	}
+
+	Save_Index();
+
+	m_Index_File.Clear(); m_Index_Resolved.Clear(); m_Index.Destroy(); m_Index_bModified = false;
+
+	if( File.is_Empty() )
+	{
+		return( true );
+	}
+
+	if( !SG_Dir_Exists(SG_File_Get_Path(File)) && !SG_Dir_Create(SG_File_Get_Path(File), true) )
+	{
+		return( false );
+	}
+
+	m_Index_File = File;
+
+	if( !SG_File_Exists(File) || !m_Index.Load(File) || !m_Index.Cmp_Name("tool_index") || !m_Index.Cmp_Property("saga-version", SAGA_VERSION) )
+	{
+		m_Index.Destroy();	// (re-)build from scratch
+		m_Index.Set_Name("tool_index");
+		m_Index.Add_Property("saga-version", SAGA_VERSION);
+	}
+
+	for(int i=m_Index.Get_Children_Count()-1; i>=0; i--)	// prune entries of removed (or non tool chain) files
+	{
+		CSG_String Path;
+
+		if( !m_Index[i].Get_Property("path", Path) || !SG_File_Cmp_Extension(Path, "xml") || !SG_File_Exists(Path) )
+		{
+			m_Index.Del_Child(i); m_Index_bModified = true;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Tool_Library_Manager::Save_Index(void)
+{
+	if( m_Index_File.is_Empty() || !m_Index_bModified )
+	{
+		return( true );
+	}
+
+	CSG_String Temp(m_Index_File + CSG_String::Format(".%d", (int)wxGetProcessId()));	// concurrently running processes might update the index too
+
+	if( m_Index.Save(Temp) && wxRenameFile(Temp.c_str(), m_Index_File.c_str(), true) )
+	{
+		m_Index_bModified = false;
+
+		return( true );
+	}
+
+	SG_File_Delete(Temp);
+
+	return( false );
+}
+
+//---------------------------------------------------------
+CSG_MetaData * CSG_Tool_Library_Manager::_Index_Get_Entry(const CSG_String &File, bool bAdd)
+{
+	wxFileName FileName(File.c_str());
+
+	if( m_Index_File.is_Empty() || !FileName.FileExists() )
+	{
+		return( NULL );
+	}
+
+	CSG_String Path(FileName.GetFullPath().wc_str()), Time(CSG_String::Format("%lld", (long long)FileName.GetModificationTime().GetTicks()));
+
+	for(int i=0; i<m_Index.Get_Children_Count(); i++)
+	{
+		CSG_MetaData &Entry = m_Index[i];
+
+		if( Entry.Cmp_Property("path", Path) )
+		{
+			if( Entry.Cmp_Property("time", Time) )
+			{
+				return( &Entry );
+			}
+
+			if( !bAdd )
+			{
+				return( NULL );	// outdated
+			}
+
+			Entry.Set_Property("time", Time); Entry.Set_Property("library", "");
+
+			return( &Entry );
+		}
+	}
+
+	if( !bAdd )
+	{
+		return( NULL );
+	}
+
+	CSG_MetaData &Entry = *m_Index.Add_Child("file");
+
+	Entry.Add_Property("path"   , Path);
+	Entry.Add_Property("time"   , Time);
+	Entry.Add_Property("library", ""  );
+
+	return( &Entry );
+}
+
+//---------------------------------------------------------
+bool CSG_Tool_Library_Manager::_Index_Get_Library(const CSG_String &File, CSG_String &Library)
+{
+	CSG_MetaData *pEntry = _Index_Get_Entry(File, false);
+
+	if( !pEntry )
+	{
+		if( !SG_File_Cmp_Extension(File, "xml") || (pEntry = _Index_Get_Entry(File, true)) == NULL )
+		{
+			return( false );
+		}
+
+		CSG_Tool_Chain Tool(File);	// not indexed yet or modified, parse it once
+
+		if( Tool.is_Okay() )
+		{
+			pEntry->Set_Property("library", Tool.Get_Library());
+		}
+
+		m_Index_bModified = true;	// files that are not valid tool chains are indexed too, so these will not be parsed again
+	}
+
+	Library = pEntry->Get_Property("library");
+
+	return( !Library.is_Empty() );
+}
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -807,6 +1039,8 @@ CSG_Tool * CSG_Tool_Library_Manager::Get_Tool(const char       *Library, const c
 CSG_Tool * CSG_Tool_Library_Manager::Get_Tool(const wchar_t    *Library, const wchar_t    *Name) const	{	return( Get_Tool(CSG_String(Library), CSG_String(Name)) );	}
 CSG_Tool * CSG_Tool_Library_Manager::Get_Tool(const CSG_String &Library, const CSG_String &Name) const
 {
+	CSG_Tool_Library_Lock Lock;
+
 	SG_Get_Tool_Library_Manager()._Add_Library(Library);
 
 	for(int i=0; i<Get_Count(); i++)
@@ -843,6 +1077,8 @@ CSG_Tool * CSG_Tool_Library_Manager::Create_Tool(const char       *Library, cons
 CSG_Tool * CSG_Tool_Library_Manager::Create_Tool(const wchar_t    *Library, const wchar_t    *Name, bool bWithGUI, bool bWithCMD)	const	{	return( Create_Tool(CSG_String(Library), CSG_String(Name), bWithGUI, bWithCMD) );	}
 CSG_Tool * CSG_Tool_Library_Manager::Create_Tool(const CSG_String &Library, const CSG_String &Name, bool bWithGUI, bool bWithCMD)	const
 {
+	CSG_Tool_Library_Lock Lock;
+
 	SG_Get_Tool_Library_Manager()._Add_Library(Library);
 
 	for(int i=0; i<Get_Count(); i++)
@@ -864,6 +1100,8 @@ CSG_Tool * CSG_Tool_Library_Manager::Create_Tool(const CSG_String &Library, cons
 //---------------------------------------------------------
 bool CSG_Tool_Library_Manager::Delete_Tool(CSG_Tool *pTool) const
 {
+	CSG_Tool_Library_Lock Lock;
+
 	for(int i=0; i<Get_Count(); i++)
 	{
 		if( Get_Library(i)->Delete_Tool(pTool) )
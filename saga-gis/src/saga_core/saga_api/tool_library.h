@@ -231,11 +231,23 @@ public:
 
 	bool						Create_Python_ToolBox	(const CSG_String &Destination, bool bClean = true, bool bName = true, bool bSingleFile = false) const;
 
+	bool						Set_Index				(const CSG_String &File);
+	const CSG_String &			Get_Index				(void)	const	{	return( m_Index_File );	}
+	bool						Save_Index				(void);
+
 
 private:
 
+	bool						m_Index_bModified;
+
 	int							m_nLibraries;
 
+	CSG_String					m_Index_File;
+
+	CSG_Strings					m_Index_Resolved;
+
+	CSG_MetaData				m_Index;
+
 	CSG_Tool_Library			**m_pLibraries;
 
 
@@ -244,6 +256,9 @@ private:
 
 	CSG_Tool_Library *			_Add_Tool_Chain			(const CSG_String &File, bool bReload = true);
 
+	CSG_MetaData *				_Index_Get_Entry		(const CSG_String &File, bool bAdd);
+	bool						_Index_Get_Library		(const CSG_String &File, CSG_String &Library);
+
 };
 
 //---------------------------------------------------------
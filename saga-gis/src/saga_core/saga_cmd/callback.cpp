@@ -61,6 +61,10 @@
 #include <iostream>
 #include <stdio.h>
 
+#ifndef _SAGA_MSW
+#include <unistd.h>
+#endif
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -82,13 +86,43 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// In server mode each request is processed by its own thread,
+// which then uses its own settings and output stream instead
+// of the global ones. Threads without such a request context
+// (e.g. the worker threads of a tool's parallel loops) fall
+// back to the global settings.
+//---------------------------------------------------------
+struct SCMD_Thread
+{
+	bool		bShow_Messages, bShow_Progress, bInteractive, bXML;
+
+	int			Output, Progress;
+
+	CCMD_Tool	*pCMD_Tool;
+};
+
+static SCMD_Thread *g_pThread = NULL;
+#pragma omp threadprivate(g_pThread)
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
 static CCMD_Tool *g_pCMD_Tool = NULL;
 
 //---------------------------------------------------------
 void        CMD_Set_Tool          (CCMD_Tool *pCMD_Tool)
 {
-	g_pCMD_Tool = pCMD_Tool;
+	if( g_pThread ) { g_pThread->pCMD_Tool = pCMD_Tool; } else { g_pCMD_Tool = pCMD_Tool; }
+}
+
+//---------------------------------------------------------
+CCMD_Tool * CMD_Get_Tool          (void)
+{
+	return( g_pThread ? g_pThread->pCMD_Tool : g_pCMD_Tool );
 }
 
 
@@ -96,33 +130,98 @@ void        CMD_Set_Tool          (CCMD_Tool *pCMD_Tool)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define CMD_SETTING(Name)	(g_pThread ? g_pThread->Name : g_##Name)
+
 //---------------------------------------------------------
 static bool g_bShow_Messages      = true;
 
-bool        CMD_Get_Show_Messages (void)     { return( g_bShow_Messages ); }
+bool        CMD_Get_Show_Messages (void)     { return( CMD_SETTING(bShow_Messages) ); }
 
-bool        CMD_Set_Show_Messages (bool bOn) { bool bLast = g_bShow_Messages; g_bShow_Messages = bOn; return( bLast ); }
+bool        CMD_Set_Show_Messages (bool bOn) { bool bLast = CMD_SETTING(bShow_Messages); CMD_SETTING(bShow_Messages) = bOn; return( bLast ); }
 
 //---------------------------------------------------------
 static bool g_bShow_Progress      = true;
 
-bool        CMD_Get_Show_Progress (void)     { return( g_bShow_Progress ); }
+bool        CMD_Get_Show_Progress (void)     { return( CMD_SETTING(bShow_Progress) ); }
 
-bool        CMD_Set_Show_Progress (bool bOn) { bool bLast = g_bShow_Progress; g_bShow_Progress = bOn; return( bLast ); }
+bool        CMD_Set_Show_Progress (bool bOn) { bool bLast = CMD_SETTING(bShow_Progress); CMD_SETTING(bShow_Progress) = bOn; return( bLast ); }
 
 //---------------------------------------------------------
 static bool g_bInteractive        = false;
 
-bool        CMD_Get_Interactive   (void)     { return( g_bInteractive ); }
+bool        CMD_Get_Interactive   (void)     { return( CMD_SETTING(bInteractive) ); }
 
-bool        CMD_Set_Interactive   (bool bOn) { bool bLast = g_bInteractive  ; g_bInteractive   = bOn; return( bLast ); }
+bool        CMD_Set_Interactive   (bool bOn) { bool bLast = CMD_SETTING(bInteractive  ); CMD_SETTING(bInteractive  ) = bOn; return( bLast ); }
 
 //---------------------------------------------------------
 static bool g_bXML                = false;
 
-bool        CMD_Get_XML           (void)     { return( g_bXML ); }
+bool        CMD_Get_XML           (void)     { return( CMD_SETTING(bXML) ); }
+
+bool        CMD_Set_XML           (bool bOn) { bool bLast = CMD_SETTING(bXML          ); CMD_SETTING(bXML          ) = bOn; return( bLast ); }
+
+//---------------------------------------------------------
+static int  g_Progress            = -1;
+
+//---------------------------------------------------------
+/**
+  * Redirects all output of the calling thread to the given
+  * file descriptor (e.g. a client's socket in server mode),
+  * starting with a copy of the global settings. A negative
+  * descriptor restores the global settings and output.
+*/
+bool        CMD_Set_Thread_Output (int Output)
+{
+	if( g_pThread )
+	{
+		delete(g_pThread);
+
+		g_pThread = NULL;
+	}
+
+	if( Output >= 0 )
+	{
+		g_pThread = new SCMD_Thread;
+
+		g_pThread->bShow_Messages = g_bShow_Messages;
+		g_pThread->bShow_Progress = g_bShow_Progress;
+		g_pThread->bInteractive   = false;	// there is no console to interact with
+		g_pThread->bXML           = g_bXML;
+		g_pThread->Output         = Output;
+		g_pThread->Progress       = -1;
+		g_pThread->pCMD_Tool      = NULL;
+	}
+
+	return( true );
+}
 
-bool        CMD_Set_XML           (bool bOn) { bool bLast = g_bXML          ; g_bXML           = bOn; return( bLast ); }
+//---------------------------------------------------------
+static void CMD_Write(const CSG_String &Text, SG_Char End, bool bError)
+{
+	#ifndef _SAGA_MSW
+	if( g_pThread && g_pThread->Output >= 0 )
+	{
+		CSG_Buffer Buffer((End ? Text + End : Text).to_UTF8());
+
+		if( Buffer.Get_Size() > 1 && write(g_pThread->Output, Buffer.Get_Data(), Buffer.Get_Size() - 1) < 0 )	// skip terminating null character
+		{
+			g_pThread->Output = -1;	// client has gone, don't try again
+		}
+
+		return;
+	}
+	#endif
+
+	if( bError )
+	{
+		SG_UI_Console_Print_StdErr(Text, End, true);
+	}
+	else
+	{
+		SG_UI_Console_Print_StdOut(Text, End, true);
+	}
+}
 
 
 ///////////////////////////////////////////////////////////
@@ -134,26 +233,26 @@ bool        CMD_Set_XML           (bool bOn) { bool bLast = g_bXML          ; g_
 //---------------------------------------------------------
 void			CMD_Print			(const CSG_String &Text, const CSG_String &XML_Tag)
 {
-	if( !g_bXML )
+	if( !CMD_Get_XML() )
 	{
-		SG_UI_Console_Print_StdOut(Text.c_str(), '\n', true);
+		CMD_Write(Text, '\n', false);
 	}
 	else if( !XML_Tag.is_Empty() )
 	{
-		SG_UI_Console_Print_StdOut(CSG_String::Format("<%s>%s</%s>", XML_Tag.c_str(), Text.c_str(), XML_Tag.c_str()), '\n', true);
+		CMD_Write(CSG_String::Format("<%s>%s</%s>", XML_Tag.c_str(), Text.c_str(), XML_Tag.c_str()), '\n', false);
 	}
 }
 
 //---------------------------------------------------------
 void			CMD_Print_Error		(const CSG_String &Text)
 {
-	if( !g_bXML )
+	if( !CMD_Get_XML() )
 	{
-		SG_UI_Console_Print_StdErr(CSG_String::Format("[%s] %s", _TL("Error"), Text.c_str()), '\n', true);
+		CMD_Write(CSG_String::Format("[%s] %s", _TL("Error"), Text.c_str()), '\n', true);
 	}
 	else
 	{
-		SG_UI_Console_Print_StdErr(CSG_String::Format("<%s>%s</%s>", SG_XML_ERROR, Text.c_str(), SG_XML_ERROR), '\n', true);
+		CMD_Write(CSG_String::Format("<%s>%s</%s>", SG_XML_ERROR, Text.c_str(), SG_XML_ERROR), '\n', true);
 	}
 }
 
@@ -173,7 +272,7 @@ void			CMD_Print_Error		(const CSG_String &Text, const CSG_String &Info)
 //---------------------------------------------------------
 void			CMD_Get_Pause		(void)
 {
-	if( g_bInteractive )
+	if( CMD_Get_Interactive() )
 	{
 		CMD_Print(CSG_String::Format("%s...", _TL("press any key")));
 
@@ -186,7 +285,7 @@ void			CMD_Get_Pause		(void)
 //---------------------------------------------------------
 bool			CMD_Get_YesNo		(const CSG_String &Caption, const CSG_String &Message)
 {
-	if( g_bInteractive )
+	if( CMD_Get_Interactive() )
 	{
 #ifdef _SAGA_MSW
 		CSG_String sKey, sYes("y"), sNo("n");
@@ -216,7 +315,7 @@ bool			CMD_Get_YesNo		(const CSG_String &Caption, const CSG_String &Message)
 //---------------------------------------------------------
 int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter &Param_2)
 {
-	static int Progress = -1;
+	int &Progress = CMD_SETTING(Progress);
 
 	int Result = 1;
 
@@ -237,11 +336,11 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_PROCESS_GET_OKAY:
 
-		if( g_bShow_Progress && Param_1.Boolean )
+		if( CMD_Get_Show_Progress() && Param_1.Boolean )
 		{
 			static int iBuisy = 0; static const SG_Char Buisy[4] = { '|', '/', '-', '\\' };
 
-			SG_UI_Console_Print_StdOut(CSG_String::Format("\r%c", Buisy[iBuisy++]), '\0', true);
+			CMD_Write(CSG_String::Format("\r%c", Buisy[iBuisy++]), '\0', false);
 
 			iBuisy %= 4;
 		}
@@ -258,7 +357,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_PROCESS_SET_PROGRESS:
 
-		if( g_bShow_Progress && !g_bXML )
+		if( CMD_Get_Show_Progress() && !CMD_Get_XML() )
 		{
 			int i = Param_2.Number != 0. ? 1 + (int)(100. * Param_1.Number / Param_2.Number) : 100;
 
@@ -266,14 +365,14 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 			{
 				if( Progress < 0 || i < Progress )
 				{
-					SG_UI_Console_Print_StdOut("", '\n', true);
+					CMD_Write("", '\n', false);
 				}
 
 				Progress = i;
 
 				if( Progress >= 0 )
 				{
-					SG_UI_Console_Print_StdOut(CSG_String::Format("\r%3d%%", Progress > 100 ? 100 : Progress), '\0', true);
+					CMD_Write(CSG_String::Format("\r%3d%%", Progress > 100 ? 100 : Progress), '\0', false);
 				}
 			}
 		}
@@ -285,7 +384,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 
 		if( Progress >= 0 )
 		{
-			SG_UI_Console_Print_StdOut("", '\n', true);
+			CMD_Write("", '\n', false);
 		}
 
 		Progress = -1;
@@ -296,7 +395,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_PROCESS_SET_TEXT:
 
-		if( g_bShow_Messages )
+		if( CMD_Get_Show_Messages() )
 		{
 			CMD_Print(Param_1.String, SG_XML_MESSAGE_PROC);
 		}
@@ -311,7 +410,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_MESSAGE_ADD:
 
-		if( g_bShow_Messages )
+		if( CMD_Get_Show_Messages() )
 		{
 			CMD_Print(Param_1.String, SG_XML_MESSAGE);
 		}
@@ -330,7 +429,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_MESSAGE_ADD_EXECUTION:
 
-		if( g_bShow_Messages )
+		if( CMD_Get_Show_Messages() )
 		{
 			CMD_Print(Param_1.String, SG_XML_MESSAGE_EXEC);
 		}
@@ -345,7 +444,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_DLG_MESSAGE:
 
-		if( g_bShow_Messages )
+		if( CMD_Get_Show_Messages() )
 		{
 			CMD_Print(Param_2.String + ": " + Param_1.String);
 		}
@@ -376,7 +475,14 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_DATAOBJECT_ADD:
 
-		Result = SG_Get_Data_Manager().Add((CSG_Data_Object *)Param_1.Pointer) ? 1 : 0;
+		if( g_pThread && g_pThread->pCMD_Tool )	// server mode, keep it with the request's own data
+		{
+			Result = g_pThread->pCMD_Tool->Add_Data((CSG_Data_Object *)Param_1.Pointer) ? 1 : 0;
+		}
+		else
+		{
+			Result = SG_Get_Data_Manager().Add((CSG_Data_Object *)Param_1.Pointer) ? 1 : 0;
+		}
 
 		break;
 
@@ -419,7 +525,7 @@ int		Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter
 	//-----------------------------------------------------
 	case CALLBACK_DLG_PARAMETERS:
 
-		Result = g_pCMD_Tool && g_pCMD_Tool->Get_Parameters((CSG_Parameters *)Param_1.Pointer) ? 1 : 0;
+		Result = CMD_Get_Tool() && CMD_Get_Tool()->Get_Parameters((CSG_Parameters *)Param_1.Pointer) ? 1 : 0;
 
 		break;
 
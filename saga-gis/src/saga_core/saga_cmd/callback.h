@@ -70,6 +70,9 @@
 
 //---------------------------------------------------------
 void					CMD_Set_Tool			(class CCMD_Tool *pCMD_Tool);
+class CCMD_Tool *		CMD_Get_Tool			(void);
+
+bool					CMD_Set_Thread_Output	(int Output);
 
 //---------------------------------------------------------
 bool					CMD_Get_Show_Messages	(void);
@@ -127,10 +127,14 @@ bool	Config_Create	(wxConfigBase *pConfig)
 	Config_Write(pConfig, "TOOLS", "LNG_FILE_DIC"        , SG_T(""));	// translation dictionary
 	Config_Write(pConfig, "TOOLS", "OMP_THREADS_MAX"     , SG_OMP_Get_Max_Num_Procs());
 	Config_Write(pConfig, "TOOLS", "ADD_LIB_PATHS"       , SG_T(""));	// additional tool library paths (aka SAGA_TLB)
+	Config_Write(pConfig, "TOOLS", "TOOL_INDEX"          , true    );	// cache library names of tool chain files
 
 	Config_Write(pConfig,  "DATA", "GRID_CACHE_TMPDIR"   , SG_Grid_Cache_Get_Directory   ());
 	Config_Write(pConfig,  "DATA", "GRID_CACHE_MODE"     , SG_Grid_Cache_Get_Mode        ());
 	Config_Write(pConfig,  "DATA", "GRID_CACHE_THRESHLOD", SG_Grid_Cache_Get_Threshold_MB());
+	Config_Write(pConfig,  "DATA", "GRID_CACHE_BUFFER"   , SG_Grid_Cache_Get_Buffer_MB   ());
+	Config_Write(pConfig,  "DATA", "GRID_MEMORY_MAP"     , SG_Grid_Get_Memory_Mapping    ());
+	Config_Write(pConfig,  "DATA", "GRID_COMPRESSION"    , SG_Grid_Compression_Get_Threshold_MB());
 	Config_Write(pConfig,  "DATA", "GRID_COORD_PRECISION", CSG_Grid_System::Get_Precision());
 	Config_Write(pConfig,  "DATA", "HISTORY_DEPTH"       , SG_Get_History_Depth());
 	Config_Write(pConfig,  "DATA", "HISTORY_LISTS"       , SG_Get_History_Ignore_Lists() != 0);
@@ -180,10 +184,15 @@ bool	Config_Load		(wxConfigBase *pConfig)
 		wxSetEnv("SAGA_TLB", sValue);
 	}
 
+	if( Config_Read(pConfig, "TOOLS", "TOOL_INDEX"          , bValue) )	{	SG_Get_Tool_Library_Manager().Set_Index(bValue ? Config_Tool_Index() : CSG_String(""));	}
+
 	//-----------------------------------------------------
 	if( Config_Read(pConfig,  "DATA", "GRID_CACHE_TMPDIR"   , sValue) )	{	SG_Grid_Cache_Set_Directory   (sValue);	}
 	if( Config_Read(pConfig,  "DATA", "GRID_CACHE_MODE"     , iValue) )	{	SG_Grid_Cache_Set_Mode        (iValue);	}
 	if( Config_Read(pConfig,  "DATA", "GRID_CACHE_THRESHLOD", dValue) )	{	SG_Grid_Cache_Set_Threshold_MB(dValue);	}
+	if( Config_Read(pConfig,  "DATA", "GRID_CACHE_BUFFER"   , dValue) )	{	SG_Grid_Cache_Set_Buffer_MB   (dValue);	}
+	if( Config_Read(pConfig,  "DATA", "GRID_MEMORY_MAP"     , bValue) )	{	SG_Grid_Set_Memory_Mapping    (bValue);	}
+	if( Config_Read(pConfig,  "DATA", "GRID_COMPRESSION"    , dValue) )	{	SG_Grid_Compression_Set_Threshold_MB(dValue);	}
 
 	if( Config_Read(pConfig,  "DATA", "GRID_COORD_PRECISION", iValue) )	{	CSG_Grid_System::Set_Precision(iValue);	}
 
@@ -294,6 +303,19 @@ bool	Config_Load		(const CSG_String &File)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_String	Config_Tool_Index	(void)
+{
+	wxString File = wxFileName(wxStandardPaths::Get().GetUserDir(wxStandardPaths::Dir_Cache), "saga_cmd_tools", "xml").GetFullPath();
+
+	return( CSG_String(&File) );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 ///////////////////////////////////////////////////////////
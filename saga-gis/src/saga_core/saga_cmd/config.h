@@ -73,6 +73,8 @@ bool Config_Load      (const CSG_String &File = "");
 
 bool Config_Libraries (CSG_Strings &Libraries, const CSG_String &File = "");
 
+CSG_String Config_Tool_Index (void);
+
 
 ///////////////////////////////////////////////////////////
 //														 //
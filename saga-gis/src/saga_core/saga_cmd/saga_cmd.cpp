@@ -54,6 +54,7 @@
 
 #include "config.h"
 #include "callback.h"
+#include "server.h"
 #include "tool.h"
 
 
@@ -67,7 +68,9 @@
 bool		Run				(int argc, char *argv[]);
 
 bool		Execute			(int argc, char *argv[]);
+bool		Execute_Tool	(CSG_Tool *pTool, int argc, char *argv[]);
 bool		Execute_Script	(const CSG_String &Script);
+bool		Execute_Script_Command	(CSG_String Command, CSG_Tool *pTool = NULL);
 
 bool		Load_Libraries	(bool bDefaults);
 
@@ -169,10 +172,50 @@ bool		Run(int argc, char *argv[])
 
 	SG_Set_UI_Callback(CMD_Get_Callback());
 
+	if( argc > 1 && !CSG_String(argv[1]).Find("--client") )	// pass the command to a running server, no need to initialize anything
+	{
+		return( Client_Run(CSG_String(argv[1]).AfterFirst('='), argc - 2, argv + 2) );
+	}
+
 	SG_Initialize_Environment(false, true, NULL, false); // initialize environment, but skip wx-initialization (already done in main())
 
+	SG_Get_Tool_Library_Manager().Set_Index(Config_Tool_Index()); // only open the library that is requested, can be switched off in the configuration
+
 	Config_Load(); // first load default configuration (if available). can be modified subsequently by flags
 
+	//-----------------------------------------------------
+	if( argc > 1 && !CSG_String(argv[1]).Find("--server") )
+	{
+		double Memory = 1024.;	// default memory budget for resident data [MB]
+
+		int nWorkers = M_GET_MIN(2, SG_OMP_Get_Max_Num_Threads());	// default number of concurrent requests
+
+		for(int i=2; i<argc; i++)
+		{
+			CSG_String Argument(argv[i]);
+
+			if( !Argument.Find("--workers=") )
+			{
+				if( !Argument.AfterFirst('=').asInt(nWorkers) || nWorkers < 1 )
+				{
+					CMD_Print_Error(_TL("invalid number of workers"), argv[i]);
+
+					return( false );
+				}
+			}
+			else if( !Argument.asDouble(Memory) || Memory < 0. )
+			{
+				CMD_Print_Error(_TL("invalid memory size"), argv[i]);
+
+				return( false );
+			}
+		}
+
+		Load_Libraries(false);
+
+		return( Server_Run(CSG_String(argv[1]).AfterFirst('='), Memory, nWorkers) );
+	}
+
 	//-----------------------------------------------------
 	if( Check_First(argv[1], argc - 2, argv + 2) )
 	{
@@ -228,6 +271,28 @@ bool		Execute(int argc, char *argv[])
 	}
 
 	//-----------------------------------------------------
+	if( Server_Get_Cache() )	// server mode, concurrent requests must not share the same tool instance
+	{
+		if( (pTool = SG_Get_Tool_Library_Manager().Create_Tool(pTool->Get_Library(), pTool->Get_ID())) == NULL )
+		{
+			CMD_Print_Error(_TL("could not create tool"), argv[2]);
+
+			return( false );
+		}
+
+		bool bResult = Execute_Tool(pTool, argc - 3, argv + 3);
+
+		SG_Get_Tool_Library_Manager().Delete_Tool(pTool);
+
+		return( bResult );
+	}
+
+	return( Execute_Tool(pTool, argc - 3, argv + 3) );
+}
+
+//---------------------------------------------------------
+bool		Execute_Tool(CSG_Tool *pTool, int argc, char *argv[])
+{
 	if( pTool->needs_GUI() )
 	{
 		CMD_Print_Error(_TL("tool needs graphical user interface"), pTool->Get_Name());
@@ -240,7 +305,10 @@ bool		Execute(int argc, char *argv[])
 
 	CCMD_Tool CMD_Tool(pTool);
 
-	return( CMD_Tool.Execute(argc - 3, argv + 3) );
+	CMD_Tool.Set_Cache    (Server_Get_Cache    ());
+	CMD_Tool.Set_Directory(Server_Get_Directory());
+
+	return( CMD_Tool.Execute(argc, argv) );
 }
 
 
@@ -269,25 +337,28 @@ bool		Set_Environment(CSG_String &Command)
 }
 
 //---------------------------------------------------------
-bool		Execute_Script_Command(CSG_String Command)
+bool		Execute_Script_Command(CSG_String Command, CSG_Tool *pTool)
 {
 	Command.Trim();
 
-	if( Command.is_Empty() )
+	if( pTool == NULL )	// otherwise command provides the options for the given tool
 	{
-		return( true );
-	}
+		if( Command.is_Empty() )
+		{
+			return( true );
+		}
 
-	if( !Command.Left(3).CmpNoCase("REM") || Command[0] == '#' )
-	{
-		return( true );
-	}
+		if( !Command.Left(3).CmpNoCase("REM") || Command[0] == '#' )
+		{
+			return( true );
+		}
 
-	if( !Command.Left(4).CmpNoCase("ECHO") )
-	{
-		CMD_Print(Command.AfterFirst(' '));
+		if( !Command.Left(4).CmpNoCase("ECHO") )
+		{
+			CMD_Print(Command.AfterFirst(' '));
 
-		return( true );
+			return( true );
+		}
 	}
 
 	//-----------------------------------------------------
@@ -330,7 +401,7 @@ bool		Execute_Script_Command(CSG_String Command)
 	ADD_ARGUMENT(Argument);
 
 	//-----------------------------------------------------
-	bool bResult = Execute(argc, argv);
+	bool bResult = pTool ? Execute_Tool(pTool, argc - 1, argv + 1) : Execute(argc, argv);
 
 	for(int i=1; i<argc; i++)
 	{
@@ -784,6 +855,18 @@ void		Print_Help		(void)
 		"   creates tool documentation in current working directory, if no other\n"
 		"   directory is given.\n"
 		"\n"
+		"saga_cmd --server[=socket] [memory] [--workers=n]\n"
+		"   runs saga_cmd as a server listening on a local socket. Libraries and\n"
+		"   data sets stay resident in between requests, data sets up to the\n"
+		"   given memory size in MB (default is 1024). Up to n requests (default\n"
+		"   is 2) are processed concurrently, sharing the available processors.\n"
+		"   The default socket is located in $XDG_RUNTIME_DIR. Send 'STOP' to\n"
+		"   shut the server down.\n"
+		"\n"
+		"saga_cmd --client[=socket] <LIBRARY> <TOOL> <OPTIONS>\n"
+		"   lets a running server execute the tool. Relative file names refer to\n"
+		"   the client's working directory.\n"
+		"\n"
 		"_____________________________________________________________________________\n"
 		"\n"
 		"Example:\n"
@@ -803,6 +886,11 @@ void		Print_Help		(void)
 		"file with the \'-C\' or \'--config\' option. Use \'--create-config\' to\n"
 		"generate such a file with default options and edit it to fit your purposes.\n"
 		"\n"
+		"The library names of tool chain files are cached in an index file in the\n"
+		"user's cache directory, which is only updated when a tool chain file has\n"
+		"been added, modified or removed. Set 'TOOL_INDEX' to false in the\n"
+		"configuration file to switch this off.\n"
+		"\n"
 		"The SAGA command line interpreter is particularly useful for the processing\n"
 		"of complex work flows by defining a series of subsequent tool calls in a\n"
 		"script file. Calling saga_cmd with the option \'--create-batch\' will\n"
@@ -0,0 +1,777 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                Command Line Interface                 //
+//                                                       //
+//                   Program: SAGA_CMD                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                      server.cpp                       //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/tool_chain.h>
+
+#include "callback.h"
+#include "server.h"
+
+//---------------------------------------------------------
+#include <wx/filefn.h>
+
+#ifndef _SAGA_MSW
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//---------------------------------------------------------
+bool	Execute_Script_Command	(CSG_String Command, CSG_Tool *pTool);
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CCMD_Data_Cache::CCMD_Data_Cache(double Memory)
+{
+	m_Clock  = 0;
+	m_Memory = Memory * N_MEGABYTE_BYTES;
+}
+
+//---------------------------------------------------------
+CCMD_Data_Cache::~CCMD_Data_Cache(void)
+{
+	for(size_t i=0; i<m_Entries.size(); i++)
+	{
+		delete(m_Entries[i].pObject);
+	}
+
+	for(size_t i=0; i<m_Private.size(); i++)
+	{
+		delete(m_Private[i]);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Returns the data set stored in File, reading it only if it is
+  * not yet cached or if the file has been modified in between.
+  * The caller gets an exclusive lease on the data set until it is
+  * given back with Release(), because tools might change their
+  * input or update its statistics and indexes. If the cached data
+  * set is leased by another request, the caller gets a private
+  * copy read from the file, which is deleted on release.
+*/
+CSG_Data_Object * CCMD_Data_Cache::Get(const CSG_String &File)
+{
+	sLong Time = _Get_Time(File); CSG_Data_Object *pObject = NULL;
+
+	#pragma omp critical(CMD_Data_Cache)
+	{
+		int i = _Find(File);
+
+		if( i >= 0 && m_Entries[i].Time == Time && m_Entries[i].nUsers == 0 )
+		{
+			m_Entries[i].nUsers = 1; m_Entries[i].Used = ++m_Clock;
+
+			pObject = m_Entries[i].pObject;
+		}
+	}
+
+	if( pObject )
+	{
+		return( pObject );
+	}
+
+	//-----------------------------------------------------
+	CSG_Data_Manager Manager;	// read outside of the critical section, so that other requests are not blocked
+
+	if( (pObject = Manager.Add(File)) == NULL || !Manager.Delete(pObject, true) )
+	{
+		return( NULL );
+	}
+
+	#pragma omp critical(CMD_Data_Cache)
+	{
+		int i = _Find(File);
+
+		if( i >= 0 && m_Entries[i].Time == Time )	// has been read by another request in the meantime
+		{
+			if( m_Entries[i].nUsers > 0 )	// leased, keep the own copy private
+			{
+				m_Private.push_back(pObject);
+			}
+			else
+			{
+				delete(pObject);
+
+				m_Entries[i].nUsers = 1; m_Entries[i].Used = ++m_Clock;
+
+				pObject = m_Entries[i].pObject;
+			}
+		}
+		else
+		{
+			_Drop(i);
+
+			SEntry Entry; Entry.bStale = false; Entry.nUsers = 1; Entry.Time = Time; Entry.Used = ++m_Clock; Entry.File = File; Entry.pObject = pObject;
+
+			m_Entries.push_back(Entry);
+		}
+	}
+
+	return( pObject );
+}
+
+//---------------------------------------------------------
+/**
+  * Takes over a data set that has just been written to its file,
+  * replacing any previously cached version of this file.
+*/
+bool CCMD_Data_Cache::Add(CSG_Data_Object *pObject)
+{
+	if( !pObject )
+	{
+		return( false );
+	}
+
+	CSG_String File(pObject->Get_File_Name(false)); sLong Time = _Get_Time(File);
+
+	#pragma omp critical(CMD_Data_Cache)
+	{
+		_Drop(_Find(File));
+
+		SEntry Entry; Entry.bStale = false; Entry.nUsers = 0; Entry.Time = Time; Entry.Used = ++m_Clock; Entry.File = File; Entry.pObject = pObject;
+
+		m_Entries.push_back(Entry);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Release(CSG_Data_Object *pObject)
+{
+	bool bResult = false;
+
+	#pragma omp critical(CMD_Data_Cache)
+	{
+		for(size_t i=0; !bResult && i<m_Entries.size(); i++)
+		{
+			if( m_Entries[i].pObject == pObject && m_Entries[i].nUsers > 0 )
+			{
+				if( --m_Entries[i].nUsers == 0 && (m_Entries[i].bStale || pObject->is_Modified()) )	// changed in place, doesn't represent the file anymore
+				{
+					m_Entries[i].bStale = true;
+
+					_Drop((int)i);
+				}
+
+				bResult = true;
+			}
+		}
+
+		for(size_t i=0; !bResult && i<m_Private.size(); i++)
+		{
+			if( m_Private[i] == pObject )
+			{
+				delete(pObject);
+
+				m_Private.erase(m_Private.begin() + i);
+
+				bResult = true;
+			}
+		}
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+/**
+  * Removes least recently used data sets, which are not in use,
+  * until the total memory fits into the budget.
+*/
+bool CCMD_Data_Cache::Update(void)
+{
+	#pragma omp critical(CMD_Data_Cache)
+	{
+		double Memory = 0.;
+
+		for(size_t i=0; i<m_Entries.size(); i++)
+		{
+			Memory += _Get_Memory(m_Entries[i].pObject);
+		}
+
+		while( Memory > m_Memory )
+		{
+			int Oldest = -1;
+
+			for(size_t i=0; i<m_Entries.size(); i++)
+			{
+				if( m_Entries[i].nUsers == 0 && (Oldest < 0 || m_Entries[i].Used < m_Entries[Oldest].Used) )
+				{
+					Oldest = (int)i;
+				}
+			}
+
+			if( Oldest < 0 )	// everything left is in use
+			{
+				break;
+			}
+
+			Memory -= _Get_Memory(m_Entries[Oldest].pObject);
+
+			_Drop(Oldest);
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+sLong CCMD_Data_Cache::_Get_Time(const CSG_String &File)
+{
+	return( SG_File_Exists(File) ? (sLong)wxFileModificationTime(File.c_str()) : -1 );
+}
+
+//---------------------------------------------------------
+double CCMD_Data_Cache::_Get_Memory(CSG_Data_Object *pObject)
+{
+	switch( pObject->Get_ObjectType() )
+	{
+	case SG_DATAOBJECT_TYPE_Grid : return( (double)pObject->asGrid ()->Get_Memory_Size() );
+	case SG_DATAOBJECT_TYPE_Grids: return( (double)pObject->asGrids()->Get_Memory_Size() );
+
+	case SG_DATAOBJECT_TYPE_Table     :
+	case SG_DATAOBJECT_TYPE_Shapes    :
+	case SG_DATAOBJECT_TYPE_PointCloud:	// rough estimate, assuming 8 bytes per attribute value
+		return( 8. * pObject->asTable()->Get_Count() * pObject->asTable()->Get_Field_Count() );
+
+	default:
+		return( 0. );
+	}
+}
+
+//---------------------------------------------------------
+int CCMD_Data_Cache::_Find(const CSG_String &File)
+{
+	for(size_t i=0; i<m_Entries.size(); i++)
+	{
+		if( !m_Entries[i].bStale && SG_File_Cmp_Path(m_Entries[i].File, File) )
+		{
+			return( (int)i );
+		}
+	}
+
+	return( -1 );
+}
+
+//---------------------------------------------------------
+void CCMD_Data_Cache::_Drop(int Entry)
+{
+	if( Entry >= 0 && Entry < (int)m_Entries.size() )
+	{
+		if( m_Entries[Entry].nUsers > 0 )	// still in use, will be removed when released
+		{
+			m_Entries[Entry].bStale = true;
+		}
+		else
+		{
+			delete(m_Entries[Entry].pObject);
+
+			m_Entries.erase(m_Entries.begin() + Entry);
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static CCMD_Data_Cache *g_pCache = NULL;
+
+static CSG_String *g_pDirectory = NULL;
+#pragma omp threadprivate(g_pDirectory)
+
+//---------------------------------------------------------
+CCMD_Data_Cache * Server_Get_Cache(void)
+{
+	return( g_pCache );
+}
+
+//---------------------------------------------------------
+CSG_String Server_Get_Directory(void)
+{
+	return( g_pDirectory ? *g_pDirectory : CSG_String("") );
+}
+
+//---------------------------------------------------------
+/**
+  * The default socket is placed in the user's runtime directory,
+  * or, if there is none, gets a user specific name in the
+  * temporary directory.
+*/
+static CSG_String Server_Get_Socket(const CSG_String &Socket)
+{
+	if( !Socket.is_Empty() )
+	{
+		return( Socket );
+	}
+
+#ifndef _SAGA_MSW
+	const char *Runtime = getenv("XDG_RUNTIME_DIR");
+
+	if( Runtime && *Runtime && SG_Dir_Exists(Runtime) )
+	{
+		return( SG_File_Make_Path(Runtime, "saga_cmd", "socket") );
+	}
+
+	return( SG_File_Make_Path(SG_Dir_Get_Temp(), CSG_String::Format("saga_cmd-%d", (int)getuid()), "socket") );
+#else
+	return( SG_File_Make_Path(SG_Dir_Get_Temp(), "saga_cmd", "socket") );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+#ifndef _SAGA_MSW
+
+//---------------------------------------------------------
+static bool Server_Write(int Socket, const CSG_String &Text)
+{
+	CSG_Buffer Buffer(Text.to_UTF8()); const char *Data = Buffer.Get_Data(); size_t Size = Buffer.Get_Size() - 1;	// skip terminating null character
+
+	while( Size > 0 )
+	{
+		ssize_t n = write(Socket, Data, Size);
+
+		if( n <= 0 )
+		{
+			return( false );
+		}
+
+		Data += n; Size -= n;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+static CSG_String Server_Read(int Socket)
+{
+	CSG_Buffer Buffer; char Data[4096]; ssize_t n;
+
+	while( (n = read(Socket, Data, sizeof(Data))) > 0 || (n < 0 && errno == EINTR) )
+	{
+		if( n > 0 && Buffer.Inc_Size(n) )
+		{
+			memcpy(Buffer.Get_Data((int)(Buffer.Get_Size() - n)), Data, n);
+		}
+	}
+
+	return( Buffer.Get_Size() > 0 ? CSG_String::from_UTF8(Buffer.Get_Data(), Buffer.Get_Size()) : CSG_String("") );
+}
+
+//---------------------------------------------------------
+static bool Server_Connect(const CSG_String &Socket, struct sockaddr_un &Address)
+{
+	CSG_Buffer Path(Socket.to_UTF8());
+
+	if( Path.Get_Size() > sizeof(Address.sun_path) )
+	{
+		CMD_Print_Error(_TL("socket path is too long"), Socket);
+
+		return( false );
+	}
+
+	memset(&Address, 0, sizeof(Address));
+
+	Address.sun_family = AF_UNIX;
+
+	memcpy(Address.sun_path, Path.Get_Data(), Path.Get_Size());
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * A request is the UTF-8 encoded text the client has sent before
+  * closing its writing end. It starts with an optional line
+  * 'CD <directory>', which sets the directory relative file names
+  * refer to, followed either by one or more saga_cmd command lines
+  * ('<LIBRARY> <TOOL> <OPTIONS>') or by a tool chain definition
+  * (XML), which might be followed by the tool chain's options.
+  * Messages and progress are sent back while processing, the reply
+  * closes with a line 'exit=0' on success or 'exit=1' on failure.
+  * Returns false, if the server has been asked to stop.
+*/
+static bool Server_Request(int Client)
+{
+	CSG_String Request(Server_Read(Client)), Directory; Request.Trim_Both();
+
+	if( !Request.Left(3).Cmp("CD ") )
+	{
+		Directory = Request.AfterFirst(' ').BeforeFirst('\n'); Directory.Trim_Both();
+		Request   = Request.AfterFirst('\n'); Request.Trim_Both();
+	}
+
+	if( Request.is_Empty() )	// a connection probe, e.g. by a starting server
+	{
+		return( true );
+	}
+
+	if( !Request.Cmp("STOP") )
+	{
+		Server_Write(Client, "exit=0\n");
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CMD_Set_Thread_Output(Client);
+
+	g_pDirectory = &Directory;
+
+	bool bResult = true;
+
+	if( Request[0] == '<' )	// tool chain
+	{
+		CSG_MetaData Chain;
+
+		if( !Chain.from_XML(Request.BeforeLast('>') + ">") )
+		{
+			CMD_Print_Error(_TL("invalid tool chain definition"));
+
+			bResult = false;
+		}
+		else
+		{
+			CSG_Tool_Chain Tool(Chain);
+
+			bResult = Tool.is_Okay() && Execute_Script_Command(Request.AfterLast('>'), &Tool);
+		}
+	}
+	else
+	{
+		CSG_Strings Commands(SG_String_Tokenize(Request, "\n"));
+
+		for(int i=0; bResult && i<Commands.Get_Count(); i++)
+		{
+			if( !(bResult = Execute_Script_Command(Commands[i], NULL)) )
+			{
+				CMD_Print_Error(_TL("invalid command"), Commands[i]);
+			}
+		}
+	}
+
+	g_pDirectory = NULL;
+
+	CMD_Set_Thread_Output(-1);
+
+	//-----------------------------------------------------
+	Server_Write(Client, CSG_String::Format("\nexit=%d\n", bResult ? 0 : 1));
+
+	return( true );
+}
+
+#endif // #ifndef _SAGA_MSW
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Runs saga_cmd as a server listening on a local (Unix domain)
+  * socket. Loaded tool libraries and data sets stay resident in
+  * between requests, so that a series of tool calls does not pay
+  * for start up, library loading and data input each time anew.
+  * Requests are processed concurrently by a pool of nWorkers
+  * threads, which share the available processors for the tools'
+  * own parallelization. The socket is only accessible by the user
+  * who started the server.
+*/
+bool Server_Run(const CSG_String &_Socket, double Memory, int nWorkers)
+{
+#ifdef _SAGA_MSW
+	CMD_Print_Error(_TL("server mode is not supported on this platform"));
+
+	return( false );
+#else
+	CSG_String Socket(Server_Get_Socket(_Socket)); struct sockaddr_un Address;
+
+	if( !Server_Connect(Socket, Address) )
+	{
+		return( false );
+	}
+
+	int Probe = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if( Probe >= 0 )
+	{
+		bool bRunning = connect(Probe, (struct sockaddr *)&Address, sizeof(Address)) == 0;
+
+		close(Probe);
+
+		if( bRunning )
+		{
+			CMD_Print_Error(_TL("a server is already listening on socket"), Socket);
+
+			return( false );
+		}
+	}
+
+	unlink(Address.sun_path);	// nobody answers, remove a socket left by a previous server
+
+	int Server = socket(AF_UNIX, SOCK_STREAM, 0), Stop[2] = { -1, -1 };
+
+	mode_t Mask = umask(0077);	// no access for others from the very beginning
+
+	bool bOkay = Server >= 0 && bind(Server, (struct sockaddr *)&Address, sizeof(Address)) == 0;
+
+	umask(Mask);
+
+	if( !bOkay || chmod(Address.sun_path, 0600) < 0 || listen(Server, 64) < 0
+	||  fcntl(Server, F_SETFL, fcntl(Server, F_GETFL) | O_NONBLOCK) < 0	// another worker might have taken the connection in between
+	||  pipe(Stop) < 0 )
+	{
+		CMD_Print_Error(_TL("could not open socket"), Socket);
+
+		if( Server >= 0 )
+		{
+			close(Server);
+
+			if( bOkay )
+			{
+				unlink(Address.sun_path);
+			}
+		}
+
+		return( false );
+	}
+
+	signal(SIGPIPE, SIG_IGN);	// a client that has gone must not terminate the server
+
+	//-----------------------------------------------------
+	CCMD_Data_Cache Cache(Memory); g_pCache = &Cache;
+
+	nWorkers = M_GET_MAX(1, nWorkers);
+
+	int nThreads = M_GET_MAX(1, SG_OMP_Get_Max_Num_Threads() / nWorkers);	// each request's share for the tool's own parallelization
+
+	CMD_Print(CSG_String::Format("%s: %s [%d %s, %d %s, %.0f MB]", _TL("listening"), Socket.c_str(), nWorkers, _TL("workers"), nThreads, _TL("threads"), Memory));
+
+	#ifdef _OPENMP
+	int Max_Levels = omp_get_max_active_levels();
+
+	if( Max_Levels < 2 )
+	{
+		omp_set_max_active_levels(2);	// allow tools to run their own parallel regions
+	}
+	#endif
+
+	#pragma omp parallel num_threads(nWorkers)
+	{
+		#ifdef _OPENMP
+		omp_set_num_threads(nThreads);
+		#endif
+
+		for(bool bRun=true; bRun; )
+		{
+			struct pollfd Wait[2] = { { Stop[0], POLLIN, 0 }, { Server, POLLIN, 0 } };
+
+			if( poll(Wait, 2, -1) < 0 )
+			{
+				bRun = errno == EINTR;
+			}
+			else if( Wait[0].revents )	// stop has been requested
+			{
+				bRun = false;
+			}
+			else if( Wait[1].revents )
+			{
+				int Client = accept(Server, NULL, NULL);
+
+				if( Client >= 0 )
+				{
+					fcntl(Client, F_SETFL, fcntl(Client, F_GETFL) & ~O_NONBLOCK);
+
+					if( !Server_Request(Client) )
+					{
+						bRun = false;
+
+						while( write(Stop[1], "", 1) < 0 && errno == EINTR ) {}	// the pipe is never read, so it stays readable for all workers
+					}
+
+					close(Client);
+				}
+			}
+		}
+	}
+
+	#ifdef _OPENMP
+	omp_set_max_active_levels(Max_Levels);
+	#endif
+
+	//-----------------------------------------------------
+	g_pCache = NULL;
+
+	close(Stop[0]); close(Stop[1]);
+
+	close(Server);
+
+	unlink(Address.sun_path);
+
+	return( true );
+#endif
+}
+
+//---------------------------------------------------------
+/**
+  * Sends the command line to a running server and prints the
+  * server's reply. Relative file names are resolved with the
+  * client's current working directory.
+*/
+bool Client_Run(const CSG_String &_Socket, int argc, char *argv[])
+{
+#ifdef _SAGA_MSW
+	CMD_Print_Error(_TL("server mode is not supported on this platform"));
+
+	return( false );
+#else
+	CSG_String Socket(Server_Get_Socket(_Socket)); struct sockaddr_un Address;
+
+	if( !Server_Connect(Socket, Address) )
+	{
+		return( false );
+	}
+
+	int Server = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if( Server < 0 || connect(Server, (struct sockaddr *)&Address, sizeof(Address)) < 0 )
+	{
+		CMD_Print_Error(_TL("could not connect to server"), Socket);
+
+		if( Server >= 0 )
+		{
+			close(Server);
+		}
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_String Request("CD " + SG_Dir_Get_Current() + "\n");
+
+	for(int i=0; i<argc; i++)
+	{
+		CSG_String Argument(argv[i]);
+
+		if( Argument.Find(' ') >= 0 && Argument.Find('\"') < 0 )
+		{
+			Argument = "\"" + Argument + "\"";
+		}
+
+		Request += (i > 0 ? " " : "") + Argument;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	bool bResult = Server_Write(Server, Request) && shutdown(Server, SHUT_WR) == 0;
+
+	CSG_String Reply(bResult ? Server_Read(Server) : CSG_String(""));
+
+	close(Server);
+
+	//-----------------------------------------------------
+	Reply.Trim(true); int n = Reply.Find('\n', true); CSG_String Exit(n < 0 ? Reply : Reply.Right(Reply.Length() - n - 1));
+
+	if( Exit.Left(5).Cmp("exit=") )
+	{
+		CMD_Print_Error(_TL("no reply from server"), Socket);
+
+		return( false );
+	}
+
+	if( n > 0 )
+	{
+		SG_UI_Console_Print_StdOut(Reply.Left(n), '\n', true);
+	}
+
+	return( Exit.Cmp("exit=0") == 0 );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
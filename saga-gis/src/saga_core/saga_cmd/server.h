@@ -0,0 +1,146 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                Command Line Interface                 //
+//                                                       //
+//                   Program: SAGA_CMD                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                      server.h                         //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef _HEADER_INCLUDED__SAGA_CMD__server_H
+#define _HEADER_INCLUDED__SAGA_CMD__server_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+#include <vector>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Keeps data sets loaded by server requests resident, so that
+  * subsequent requests referring to the same file do not need to
+  * read it again. A cached data set is reloaded, if its file has
+  * been modified. Data sets that are not in use by any request
+  * are removed in least recently used order as soon as the total
+  * memory exceeds the given budget. A data set is never used by
+  * more than one request at a time and is dropped, if a request
+  * has changed it. Thread-safe.
+*/
+//---------------------------------------------------------
+class CCMD_Data_Cache
+{
+public:
+	CCMD_Data_Cache(double Memory = 1024.);
+	virtual ~CCMD_Data_Cache(void);
+
+	CSG_Data_Object *			Get						(const CSG_String &File);
+	bool						Add						(CSG_Data_Object *pObject);
+	bool						Release					(CSG_Data_Object *pObject);
+
+	bool						Update					(void);
+
+
+private:
+
+	struct SEntry
+	{
+		bool					bStale;
+
+		int						nUsers;
+
+		sLong					Time, Used;
+
+		CSG_String				File;
+
+		CSG_Data_Object			*pObject;
+	};
+
+	sLong						m_Clock;
+
+	double						m_Memory;
+
+	std::vector<SEntry>			m_Entries;
+
+	std::vector<CSG_Data_Object *>	m_Private;
+
+
+	static sLong				_Get_Time				(const CSG_String &File);
+	static double				_Get_Memory				(CSG_Data_Object *pObject);
+
+	int							_Find					(const CSG_String &File);
+	void						_Drop					(int Entry);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CCMD_Data_Cache *				Server_Get_Cache		(void);
+CSG_String						Server_Get_Directory	(void);
+
+bool							Server_Run				(const CSG_String &Socket, double Memory, int nWorkers);
+bool							Client_Run				(const CSG_String &Socket, int argc, char *argv[]);
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef _HEADER_INCLUDED__SAGA_CMD__server_H
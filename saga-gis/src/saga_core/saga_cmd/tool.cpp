@@ -49,8 +49,10 @@
 
 //---------------------------------------------------------
 #include <wx/datetime.h>
+#include <wx/filename.h>
 
 #include "callback.h"
+#include "server.h"
 
 #include "tool.h"
 
@@ -64,11 +66,14 @@
 //---------------------------------------------------------
 CCMD_Tool::CCMD_Tool(void)
 {
-	m_pTool = NULL;
+	m_pTool  = NULL;
+	m_pCache = NULL;
 }
 
 CCMD_Tool::CCMD_Tool(CSG_Tool *pTool)
 {
+	m_pCache = NULL;
+
 	Create(pTool);
 }
 
@@ -132,6 +137,11 @@ bool CCMD_Tool::Execute(int argc, char *argv[])
 		return( false );
 	}
 
+	if( m_pCache )	// server mode, data created by this request is kept apart from the resident data
+	{
+		m_pTool->Set_Manager(&m_Manager);
+	}
+
 	//-----------------------------------------------------
 	bool bResult = _Get_Parameters(m_pTool->Get_Parameters(), true);
 
@@ -142,6 +152,8 @@ bool CCMD_Tool::Execute(int argc, char *argv[])
 
 	if( !bResult )
 	{
+		_Cache_Data(NULL);
+
 		Usage();
 
 		return( false );
@@ -169,13 +181,27 @@ bool CCMD_Tool::Execute(int argc, char *argv[])
 			_Save_Output(m_pTool->Get_Parameters(i));
 		}
 
-		SG_Get_Data_Manager().Delete(false, true);	// remove temporary data to save memory resources
+		if( m_pCache )
+		{
+			_Cache_Data(m_pTool->Get_Parameters());
+
+			for(int i=0; i<m_pTool->Get_Parameters_Count(); i++)
+			{
+				_Cache_Data(m_pTool->Get_Parameters(i));
+			}
+		}
+		else
+		{
+			SG_Get_Data_Manager().Delete(false, true);	// remove temporary data to save memory resources
+		}
 	}
 	else
 	{
 		CMD_Print_Error(_TL("executing tool"), m_pTool->Get_Name());
 	}
 
+	_Cache_Data(NULL);
+
 	SG_UI_ProgressAndMsg_Reset(); SG_UI_Process_Set_Okay();
 
 	return( bResult && _has_Unused() == false );
@@ -527,6 +553,10 @@ bool CCMD_Tool::_Get_Options(CSG_Parameters *pParameters, bool bInitialize)
 						valString.Replace(";", "\" \"");
 						valString.Append ("\"");
 					}
+					else
+					{
+						valString = _Get_File(valString);
+					}
 
 					pParameter->Set_Value(valString);
 				}
@@ -659,14 +689,16 @@ bool CCMD_Tool::_Load_Input(CSG_Parameter *pParameter)
 
 	if( pParameter->is_DataObject() )
 	{
-		if( !SG_Get_Data_Manager().Find(FileName) && !SG_Get_Data_Manager().Add(FileName) && !pParameter->is_Optional() )
+		CSG_Data_Object *pObject = _Get_Data(FileName);
+
+		if( !pObject && !pParameter->is_Optional() )
 		{
 			CMD_Print_Error(_TL("input file"), FileName);
 
 			return( false );
 		}
 
-		return( pParameter->Set_Value(SG_Get_Data_Manager().Find(FileName, false)) );
+		return( pParameter->Set_Value(pObject) );
 	}
 
 	else if( pParameter->is_DataObject_List() )
@@ -680,12 +712,7 @@ bool CCMD_Tool::_Load_Input(CSG_Parameter *pParameter)
 			FileName  = FileNames.BeforeFirst(';'); FileName.Trim_Both();
 			FileNames = FileNames.AfterFirst (';');
 
-			if( !SG_Get_Data_Manager().Find(FileName) )
-			{
-				SG_Get_Data_Manager().Add(FileName);
-			}
-
-			pParameter->asList()->Add_Item(SG_Get_Data_Manager().Find(FileName, false));
+			pParameter->asList()->Add_Item(_Get_Data(FileName));
 		}
 		while( FileNames.Length() > 0 );
 
@@ -795,7 +822,117 @@ bool CCMD_Tool::_Save_Output(CSG_Data_Object *pObject, const CSG_String &FileNam
 {
 	pObject->Set_Name(SG_File_Get_Name(FileName, false));
 
-	return( pObject->Save(FileName) );
+	return( pObject->Save(_Get_File(FileName)) );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCMD_Tool::Add_Data(CSG_Data_Object *pObject)
+{
+	return( (m_pCache ? m_Manager : SG_Get_Data_Manager()).Add(pObject) != NULL );
+}
+
+//---------------------------------------------------------
+CSG_String CCMD_Tool::_Get_File(const CSG_String &File)
+{
+	if( m_Directory.is_Empty() || File.is_Empty() )
+	{
+		return( File );
+	}
+
+	wxFileName FileName(File.c_str());	// relative file names refer to the client's working directory
+
+	if( FileName.IsRelative() )
+	{
+		FileName.MakeAbsolute(m_Directory.c_str());
+	}
+
+	wxString Path(FileName.GetFullPath());
+
+	return( CSG_String(&Path) );
+}
+
+//---------------------------------------------------------
+CSG_Data_Object * CCMD_Tool::_Get_Data(const CSG_String &_File)
+{
+	CSG_String File(_Get_File(_File));
+
+	if( m_pCache )
+	{
+		CSG_Data_Object *pObject = m_pCache->Get(File);
+
+		if( pObject )
+		{
+			m_Cached.Add(pObject);	// pinned, won't be evicted before the request has finished
+		}
+
+		return( pObject );
+	}
+
+	if( !SG_Get_Data_Manager().Find(File) )
+	{
+		SG_Get_Data_Manager().Add(File);
+	}
+
+	return( SG_Get_Data_Manager().Find(File, false) );
+}
+
+//---------------------------------------------------------
+/**
+  * Server mode only. Hands the stored output over to the data
+  * cache, so that subsequent requests can use it as input without
+  * reading it again. Called with NULL, releases the inputs and
+  * removes all temporary data of this request.
+*/
+void CCMD_Tool::_Cache_Data(CSG_Parameters *pParameters)
+{
+	if( !m_pCache )
+	{
+		return;
+	}
+
+	if( pParameters )
+	{
+		for(int j=0; j<pParameters->Get_Count(); j++)
+		{
+			CSG_Parameter *pParameter = pParameters->Get_Parameter(j); CSG_String FileName;
+
+			if( pParameter->is_Output() && _Found(pParameter->Get_CmdID(), FileName) && FileName.Length() > 0 )
+			{
+				int n = pParameter->is_DataObject() ? 1 : pParameter->is_DataObject_List() ? pParameter->asList()->Get_Item_Count() : 0;
+
+				for(int i=0; i<n; i++)
+				{
+					CSG_Data_Object *pObject = pParameter->is_DataObject() ? pParameter->asDataObject() : pParameter->asList()->Get_Item(i);
+
+					if( pObject && !pObject->is_Modified() && SG_File_Exists(pObject->Get_File_Name(false)) && m_Manager.Delete(pObject, true) )
+					{
+						m_pCache->Add(pObject);
+					}
+				}
+			}
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	m_pTool->Set_Manager(&SG_Get_Data_Manager());
+
+	for(sLong i=0; i<m_Cached.Get_Size(); i++)
+	{
+		m_pCache->Release((CSG_Data_Object *)m_Cached[i]);
+	}
+
+	m_Cached.Destroy();
+
+	m_Manager.Delete();
+
+	m_pCache->Update();
 }
 
 
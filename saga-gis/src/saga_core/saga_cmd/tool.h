@@ -85,15 +85,32 @@ public:
 
 	bool						Get_Parameters			(CSG_Parameters *pParameters)	{	return( _Get_Parameters(pParameters, false) );	}
 
+	void						Set_Cache				(class CCMD_Data_Cache *pCache)	{	m_pCache    = pCache   ;	}
+	void						Set_Directory			(const CSG_String &Directory)	{	m_Directory = Directory;	}
+
+	bool						Add_Data				(CSG_Data_Object *pObject);
+
 
 private:
 
 	CSG_Tool					*m_pTool;
 
-	CSG_String					m_Usage;
+	class CCMD_Data_Cache		*m_pCache;
+
+	CSG_String					m_Usage, m_Directory;
 
 	CSG_Table					m_Arguments;
 
+	CSG_Array_Pointer			m_Cached;
+
+	CSG_Data_Manager			m_Manager;
+
+
+	CSG_String					_Get_File				(const CSG_String &File);
+
+	CSG_Data_Object *			_Get_Data				(const CSG_String &File);
+
+	void						_Cache_Data				(CSG_Parameters *pParameters);
 
 	bool						_Parse					(int argc, char *argv[]);
 
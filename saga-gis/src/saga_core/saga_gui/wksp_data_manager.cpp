@@ -277,12 +277,30 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 		SG_Grid_Cache_Get_Threshold_MB(), 0., true
 	);
 
+	m_Parameters.Add_Double("GRID_CACHE_MODE",
+		"GRID_CACHE_BUFFER"		, _TL("Buffer Size [MB]"),
+		_TL("Maximum memory used by each file cached grid to hold blocks of rows."),
+		SG_Grid_Cache_Get_Buffer_MB(), 1., true
+	);
+
 	m_Parameters.Add_FilePath("GRID_CACHE_MODE",
 		"GRID_CACHE_TMPDIR"		, _TL("Temporary files"),
 		_TL("Directory, where temporary cache files shall be saved."),
 		NULL, SG_Grid_Cache_Get_Directory(), true, true
 	);
 
+	m_Parameters.Add_Bool("NODE_GRID",
+		"GRID_MEMORY_MAP"		, _TL("Memory Mapping"),
+		_TL("Map uncompressed native grid files directly to memory instead of reading them. Changes are kept in memory and never written back to the file. Do not use this with files that are changed by other programs while loaded, e.g. on shared network drives."),
+		SG_Grid_Get_Memory_Mapping()
+	);
+
+	m_Parameters.Add_Double("NODE_GRID",
+		"GRID_COMPRESSION"		, _TL("Compression Threshold [MB]"),
+		_TL("Keep new grids exceeding this memory size compressed in memory. Saves memory for grids with large constant or no-data areas, e.g. masks and categorical grids. Zero switches compression off."),
+		SG_Grid_Compression_Get_Threshold_MB(), 0., true
+	);
+
 	//-----------------------------------------------------
 	m_Parameters.Add_Node("", "NODE_TABLE", _TL("Tables"), _TL(""));
 
@@ -322,7 +340,10 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 
 	SG_Grid_Cache_Set_Mode           (m_Parameters("GRID_CACHE_MODE"     )->asInt   ());
 	SG_Grid_Cache_Set_Threshold_MB   (m_Parameters("GRID_CACHE_THRSHLD"  )->asDouble());
+	SG_Grid_Cache_Set_Buffer_MB      (m_Parameters("GRID_CACHE_BUFFER"   )->asDouble());
 	SG_Grid_Cache_Set_Directory      (m_Parameters("GRID_CACHE_TMPDIR"   )->asString());
+	SG_Grid_Set_Memory_Mapping       (m_Parameters("GRID_MEMORY_MAP"     )->asBool  ());
+	SG_Grid_Compression_Set_Threshold_MB(m_Parameters("GRID_COMPRESSION"    )->asDouble());
 
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
@@ -721,7 +742,10 @@ void CWKSP_Data_Manager::Parameters_Changed(void)
 
 	SG_Grid_Cache_Set_Mode           (m_Parameters("GRID_CACHE_MODE"     )->asInt   ());
 	SG_Grid_Cache_Set_Threshold_MB   (m_Parameters("GRID_CACHE_THRSHLD"  )->asDouble());
+	SG_Grid_Cache_Set_Buffer_MB      (m_Parameters("GRID_CACHE_BUFFER"   )->asDouble());
 	SG_Grid_Cache_Set_Directory      (m_Parameters("GRID_CACHE_TMPDIR"   )->asString());
+	SG_Grid_Set_Memory_Mapping       (m_Parameters("GRID_MEMORY_MAP"     )->asBool  ());
+	SG_Grid_Compression_Set_Threshold_MB(m_Parameters("GRID_COMPRESSION"    )->asDouble());
 
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
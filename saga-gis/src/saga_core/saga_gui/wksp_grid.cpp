@@ -145,7 +145,11 @@ wxString CWKSP_Grid::Get_Description(void)
 	DESC_ADD_STR (_TL("Value Type"        ), SG_Data_Type_Get_Name(Get_Grid()->Get_Type()).c_str());
 	DESC_ADD_STR (_TL("Memory Size"       ), Get_nBytes_asString(Get_Grid()->Get_Memory_Size(), 2).c_str());
 
-	if( Get_Grid()->is_Cached() )
+	if( Get_Grid()->is_Compressed() )
+	{
+		DESC_ADD_STR(_TL("Compressed Size"), Get_nBytes_asString(Get_Grid()->Get_Memory_Size_Compressed(), 2).c_str());
+	}
+	else if( Get_Grid()->is_Cached() )
 	{
 		DESC_ADD_STR(_TL("File Cache"     ), _TL("activated"));
 	}
@@ -47,6 +47,9 @@
 //---------------------------------------------------------
 #include "Grid_Calculator.h"
 
+//---------------------------------------------------------
+#define CALCULATOR_CHUNK	1024	// maximum number of cells passed at once to the formula
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -366,6 +369,15 @@ inline bool CGrid_Calculator_Base::Get_Result(const CSG_Vector &Values, double &
 	return( _finite(Result = m_Formula.Get_Value(Values)) != 0 );
 }
 
+//---------------------------------------------------------
+// Evaluates the formula for a chunk of cells at once. Each
+// row of the values matrix holds one variable.
+//---------------------------------------------------------
+bool CGrid_Calculator_Base::Get_Result(const CSG_Matrix &Values, CSG_Vector &Result)
+{
+	return( m_Formula.Get_Values((const double **)Values.Get_Data(), m_nValues, Result.Get_Data(), Result.Get_N()) );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -479,21 +491,14 @@ bool CGrid_Calculator::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
+	int nChunk = SG_OMP_Get_Chunk_Size(Get_NX(), CALCULATOR_CHUNK);
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		for(int x=0; x<Get_NX(); x+=nChunk)
 		{
-			double Result; CSG_Vector Values(m_nValues);
-
-			if( Get_Values(x, y, Values) && Get_Result(Values, Result) )
-			{
-				pResult->Set_Value(x, y, Result);
-			}
-			else
-			{
-				pResult->Set_NoData(x, y);
-			}
+			Set_Results(x, y, M_GET_MIN(nChunk, Get_NX() - x), pResult);
 		}
 	}
 
@@ -542,6 +547,40 @@ bool CGrid_Calculator::Get_Values(int x, int y, CSG_Vector &Values)
 	return( true );
 }
 
+//---------------------------------------------------------
+void CGrid_Calculator::Set_Results(int x, int y, int n, CSG_Grid *pResult)
+{
+	CSG_Vector Values(m_nValues), Result(n); CSG_Matrix Chunk(n, m_nValues); CSG_Array_Int bValid(n);
+
+	for(int i=0; i<n; i++)
+	{
+		if( (bValid[i] = Get_Values(x + i, y, Values)) != 0 )
+		{
+			for(int j=0; j<m_nValues; j++)
+			{
+				Chunk[j][i] = Values[j];
+			}
+		}
+	}
+
+	if( !Get_Result(Chunk, Result) )
+	{
+		bValid.Assign(0);
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		if( bValid[i] && _finite(Result[i]) )
+		{
+			pResult->Set_Value(x + i, y, Result[i]);
+		}
+		else
+		{
+			pResult->Set_NoData(x + i, y);
+		}
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -678,24 +717,14 @@ bool CGrids_Calculator::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
+	int nChunk = SG_OMP_Get_Chunk_Size(Get_NX(), CALCULATOR_CHUNK);
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		for(int x=0; x<Get_NX(); x+=nChunk)
 		{
-			double Result; CSG_Vector Values(m_nValues);
-
-			for(int z=0; z<pResult->Get_NZ(); z++)
-			{
-				if( Get_Values(x, y, z, Values) && Get_Result(Values, Result) )
-				{
-					pResult->Set_Value(x, y, z, Result);
-				}
-				else
-				{
-					pResult->Set_NoData(x, y, z);
-				}
-			}
+			Set_Results(x, y, M_GET_MIN(nChunk, Get_NX() - x), pResult);
 		}
 	}
 
@@ -748,6 +777,43 @@ bool CGrids_Calculator::Get_Values(int x, int y, int z, CSG_Vector &Values)
 	return( true );
 }
 
+//---------------------------------------------------------
+void CGrids_Calculator::Set_Results(int x, int y, int n, CSG_Grids *pResult)
+{
+	CSG_Vector Values(m_nValues), Result(n); CSG_Matrix Chunk(n, m_nValues); CSG_Array_Int bValid(n);
+
+	for(int z=0; z<pResult->Get_NZ(); z++)
+	{
+		for(int i=0; i<n; i++)
+		{
+			if( (bValid[i] = Get_Values(x + i, y, z, Values)) != 0 )
+			{
+				for(int j=0; j<m_nValues; j++)
+				{
+					Chunk[j][i] = Values[j];
+				}
+			}
+		}
+
+		if( !Get_Result(Chunk, Result) )
+		{
+			bValid.Assign(0);
+		}
+
+		for(int i=0; i<n; i++)
+		{
+			if( bValid[i] && _finite(Result[i]) )
+			{
+				pResult->Set_Value(x + i, y, z, Result[i]);
+			}
+			else
+			{
+				pResult->Set_NoData(x + i, y, z);
+			}
+		}
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
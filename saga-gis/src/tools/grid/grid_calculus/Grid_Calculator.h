@@ -95,6 +95,7 @@ protected:
 	TSG_Data_Type				Get_Result_Type			(void);
 
 	bool						Get_Result				(const CSG_Vector &Values, double &Result);
+	bool						Get_Result				(const CSG_Matrix &Values, CSG_Vector &Result);
 
 };
 
@@ -121,6 +122,7 @@ private:
 
 
 	bool						Get_Values				(int x, int y, CSG_Vector &Values);
+	void						Set_Results				(int x, int y, int n, CSG_Grid *pResult);
 
 };
 
@@ -151,6 +153,7 @@ private:
 	virtual bool				Preprocess_Formula		(CSG_String &Formula);
 
 	bool						Get_Values				(int x, int y, int z, CSG_Vector &Values);
+	void						Set_Results				(int x, int y, int n, CSG_Grids *pResult);
 
 };
 
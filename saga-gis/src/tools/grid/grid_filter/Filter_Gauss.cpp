@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <vector>
+
 #include "Filter_Gauss.h"
 
 
@@ -68,9 +70,22 @@ CFilter_Gauss::CFilter_Gauss(void)
 		"The degree of smoothing is determined by the kernel size specified as "
 		"radius and the weighting of each raster cell within the kernel. The "
 		"weighting scheme uses the Gaussian bell curve function and can be adjusted "
-		"to the kernel size with the 'Standard Deviation' option. "
+		"to the kernel size with the 'Standard Deviation' option.\n"
+		"The separable method applies the one-dimensional Gaussian kernel to the rows "
+		"and then to the columns, which gives the same result as a two-dimensional "
+		"kernel at a fraction of its costs. The recursive method approximates the "
+		"Gaussian with an infinite impulse response filter, whose costs do not depend "
+		"on the standard deviation at all. Both normalize the weights with respect to "
+		"no-data cells. The kernel method is the former implementation, kept for "
+		"compatibility, which uses a differently shaped weighting function. "
 	));
 
+	Add_Reference("Young, I.T., van Vliet, L.J., van Ginkel, M.", "2002",
+		"Recursive Gabor filtering",
+		"IEEE Transactions on Signal Processing, 50(11), 2798-2805.",
+		SG_T("https://doi.org/10.1109/TSP.2002.804095"), SG_T("doi:10.1109/TSP.2002.804095")
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Grid("",
 		"INPUT"			, _TL("Grid"),
@@ -95,6 +110,16 @@ CFilter_Gauss::CFilter_Gauss(void)
 		_TL("The standard deviation as percentage of the kernel radius."),
 		50., 1., true
 	);
+
+	Parameters.Add_Choice("",
+		"METHOD"		, _TL("Method"),
+		_TL(""),
+		CSG_String::Format("%s|%s|%s",
+			_TL("kernel"),
+			_TL("separable"),
+			_TL("recursive")
+		), 0
+	);
 }
 
 
@@ -107,27 +132,7 @@ bool CFilter_Gauss::On_Execute(void)
 {
 	int Radius = Parameters("KERNEL_RADIUS")->asInt();
 
-	CSG_Matrix Kernel;
-
-	if( !Kernel.Create(1 + 2 * (sLong)Radius, 1 + 2 * (sLong)Radius) )
-	{
-		Error_Set(_TL("Kernel initialization failed!"));
-
-		return( false );
-	}
-
-	//-----------------------------------------------------
-	double Bandwidth = Radius * Parameters("SIGMA")->asDouble() / 100.;
-
-	for(int i=0; i<Kernel.Get_NY(); i++)
-	{
-		for(int j=0; j<Kernel.Get_NX(); j++)
-		{
-			double d = SG_Get_Square((double)i - Radius) + SG_Get_Square((double)j - Radius) / Bandwidth;
-
-			Kernel[i][j] = exp(-0.5 * d*d);
-		}
-	}
+	double Sigma = Radius * Parameters("SIGMA")->asDouble() / 100.;
 
 	//-----------------------------------------------------
 	CSG_Grid Input, *pInput = Parameters("INPUT")->asGrid();
@@ -147,6 +152,52 @@ bool CFilter_Gauss::On_Execute(void)
 		pResult->Set_NoData_Value(pInput->Get_NoData_Value());
 	}
 
+	//-----------------------------------------------------
+	bool bResult;
+
+	switch( Parameters("METHOD")->asInt() )
+	{
+	default: bResult = Get_Kernel   (pInput, pResult, Radius, Sigma); break;
+	case  1: bResult = Get_Separable(pInput, pResult, Radius, Sigma); break;
+	case  2: bResult = Get_Recursive(pInput, pResult,         Sigma); break;
+	}
+
+	//-----------------------------------------------------
+	if( pResult == Parameters("INPUT")->asGrid() )
+	{
+		DataObject_Update(pResult);
+	}
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CFilter_Gauss::Get_Kernel(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, double Bandwidth)
+{
+	CSG_Matrix Kernel;
+
+	if( !Kernel.Create(1 + 2 * (sLong)Radius, 1 + 2 * (sLong)Radius) )
+	{
+		Error_Set(_TL("Kernel initialization failed!"));
+
+		return( false );
+	}
+
+	for(int i=0; i<Kernel.Get_NY(); i++)
+	{
+		for(int j=0; j<Kernel.Get_NX(); j++)
+		{
+			double d = SG_Get_Square((double)i - Radius) + SG_Get_Square((double)j - Radius) / Bandwidth;
+
+			Kernel[i][j] = exp(-0.5 * d*d);
+		}
+	}
+
 	//-----------------------------------------------------
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
@@ -180,10 +231,241 @@ bool CFilter_Gauss::On_Execute(void)
 		}
 	}
 
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Convolves the rows of a band (plus the kernel radius above
+// and below) and then its columns. Values and weights are
+// accumulated separately, so that no-data cells do not
+// contribute and the result equals the normalized 2D kernel.
+//---------------------------------------------------------
+bool CFilter_Gauss::Get_Separable(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, double Sigma)
+{
+	std::vector<double> Kernel(1 + 2 * Radius);
+
+	for(int i=-Radius; i<=Radius; i++)
+	{
+		Kernel[Radius + i] = exp(-0.5 * SG_Get_Square(i / Sigma));
+	}
+
 	//-----------------------------------------------------
-	if( pResult == Parameters("INPUT")->asGrid() )
+	int nx = Get_NX(), nBand = M_GET_MAX(128, 2 * Radius), nRows = nBand + 2 * Radius;
+
+	std::vector<double> V((size_t)nRows * nx), W((size_t)nRows * nx);
+
+	for(int yBand=0; yBand<Get_NY() && Set_Progress_Rows(yBand); yBand+=nBand)
 	{
-		DataObject_Update(pResult);
+		int yEnd = M_GET_MIN(yBand + nBand, Get_NY()), yMin = M_GET_MAX(0, yBand - Radius), yMax = M_GET_MIN(Get_NY(), yEnd + Radius);
+
+		#pragma omp parallel for
+		for(int y=yMin; y<yMax; y++)
+		{
+			std::vector<double> Row(nx), Valid(nx);
+
+			for(int x=0; x<nx; x++)
+			{
+				Valid[x] = pInput->is_NoData(x, y) ? 0. : 1.;
+				Row  [x] = Valid[x] > 0. ? pInput->asDouble(x, y) : 0.;
+			}
+
+			double *v = &V[(size_t)(y - yMin) * nx], *w = &W[(size_t)(y - yMin) * nx];
+
+			for(int x=0; x<nx; x++)
+			{
+				int iMin = M_GET_MAX(0, x - Radius), iMax = M_GET_MIN(nx - 1, x + Radius); double sv = 0., sw = 0.;
+
+				for(int ix=iMin; ix<=iMax; ix++)
+				{
+					double k = Kernel[Radius + ix - x];
+
+					sv += k * Row[ix]; sw += k * Valid[ix];
+				}
+
+				v[x] = sv; w[x] = sw;
+			}
+		}
+
+		//-------------------------------------------------
+		#pragma omp parallel for
+		for(int y=yBand; y<yEnd; y++)
+		{
+			std::vector<double> sv(nx, 0.), sw(nx, 0.);
+
+			for(int iy=M_GET_MAX(yMin, y - Radius); iy<=M_GET_MIN(yMax - 1, y + Radius); iy++)
+			{
+				double k = Kernel[Radius + iy - y];
+
+				const double *v = &V[(size_t)(iy - yMin) * nx], *w = &W[(size_t)(iy - yMin) * nx];
+
+				for(int x=0; x<nx; x++)
+				{
+					sv[x] += k * v[x]; sw[x] += k * w[x];
+				}
+			}
+
+			for(int x=0; x<nx; x++)
+			{
+				if( sw[x] > 0. && !pInput->is_NoData(x, y) )
+				{
+					pResult->Set_Value(x, y, sv[x] / sw[x]);
+				}
+				else
+				{
+					pResult->Set_NoData(x, y);
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Recursive Gaussian (Young, van Vliet & van Ginkel 2002),
+// a causal and an anti-causal third order filter applied
+// in place, first along the rows, then along the columns.
+// Like the separable method it filters values and validity
+// weights separately. Rows are processed in bands, each
+// extended by a margin of twelve standard deviations, over
+// which the column recursion's truncation error decays below
+// single float precision.
+//---------------------------------------------------------
+bool CFilter_Gauss::Get_Recursive(CSG_Grid *pInput, CSG_Grid *pResult, double Sigma)
+{
+	if( Sigma < 0.5 )
+	{
+		Sigma = 0.5;
+	}
+
+	const double m0 = 1.16680, m1 = 1.10783, m2 = 1.40586;	// pole positions
+
+	double q = 1.31564 * (sqrt(1. + 0.490811 * Sigma*Sigma) - 1.);
+
+	double s  = (m0 + q) * (m1*m1 + m2*m2 + 2. * m1 * q + q*q);
+	double b1 = q * (2. * m0 * m1 + m1*m1 + m2*m2 + (2. * m0 + 4. * m1) * q + 3. * q*q) / s;
+	double b2 = -q*q * (m0 + 2. * m1 + 3. * q) / s;
+	double b3 = q*q*q / s;
+	double B  = 1. - (b1 + b2 + b3);
+
+	//-----------------------------------------------------
+	int nx = Get_NX(), ny = Get_NY(), Margin = 3 + (int)ceil(12. * Sigma), nBand = M_GET_MAX(128, 2 * Margin);
+
+	if( nBand + 2 * Margin >= ny )	// a single band, i.e. no margin needed
+	{
+		nBand = ny;
+	}
+
+	std::vector<double> V, W;
+
+	for(int yBand=0; yBand<ny && Set_Progress_Rows(yBand); yBand+=nBand)
+	{
+		int yEnd = M_GET_MIN(yBand + nBand, ny), yMin = M_GET_MAX(0, yBand - Margin), yMax = M_GET_MIN(ny, yEnd + Margin), nRows = yMax - yMin;
+
+		V.resize((size_t)nRows * nx); W.resize((size_t)nRows * nx);
+
+		//-------------------------------------------------
+		#pragma omp parallel for
+		for(int y=yMin; y<yMax; y++)
+		{
+			double *v = &V[(size_t)(y - yMin) * nx], *w = &W[(size_t)(y - yMin) * nx];
+
+			for(int x=0; x<nx; x++)
+			{
+				bool bValid = !pInput->is_NoData(x, y);
+
+				v[x] = bValid ? pInput->asDouble(x, y) : 0.;
+				w[x] = bValid ? 1. : 0.;
+			}
+
+			for(int i=0; i<2; i++)
+			{
+				double *z = i == 0 ? v : w;
+
+				for(int x=0; x<nx; x++)	// causal
+				{
+					z[x] = B * z[x]
+						+ b1 * (x > 0 ? z[x - 1] : 0.)
+						+ b2 * (x > 1 ? z[x - 2] : 0.)
+						+ b3 * (x > 2 ? z[x - 3] : 0.);
+				}
+
+				for(int x=nx-1; x>=0; x--)	// anti-causal
+				{
+					z[x] = B * z[x]
+						+ b1 * (x < nx - 1 ? z[x + 1] : 0.)
+						+ b2 * (x < nx - 2 ? z[x + 2] : 0.)
+						+ b3 * (x < nx - 3 ? z[x + 3] : 0.);
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		// columns, processed in tiles, vectorised along the rows
+
+		#define TILE_WIDTH	256
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int x0=0; x0<nx; x0+=TILE_WIDTH)
+		{
+			int x1 = M_GET_MIN(x0 + TILE_WIDTH, nx);
+
+			for(int i=0; i<2; i++)
+			{
+				double *z = i == 0 ? &V[0] : &W[0];
+
+				for(int y=0; y<nRows; y++)	// causal
+				{
+					double *z0 = z + (size_t)y * nx;
+					double *z1 = y > 0 ? z0 - nx : NULL, *z2 = y > 1 ? z1 - nx : NULL, *z3 = y > 2 ? z2 - nx : NULL;
+
+					for(int x=x0; x<x1; x++)
+					{
+						z0[x] = B * z0[x] + (z1 ? b1 * z1[x] : 0.) + (z2 ? b2 * z2[x] : 0.) + (z3 ? b3 * z3[x] : 0.);
+					}
+				}
+
+				for(int y=nRows-1; y>=0; y--)	// anti-causal
+				{
+					double *z0 = z + (size_t)y * nx;
+					double *z1 = y < nRows - 1 ? z0 + nx : NULL, *z2 = y < nRows - 2 ? z1 + nx : NULL, *z3 = y < nRows - 3 ? z2 + nx : NULL;
+
+					for(int x=x0; x<x1; x++)
+					{
+						z0[x] = B * z0[x] + (z1 ? b1 * z1[x] : 0.) + (z2 ? b2 * z2[x] : 0.) + (z3 ? b3 * z3[x] : 0.);
+					}
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		#pragma omp parallel for
+		for(int y=yBand; y<yEnd; y++)
+		{
+			const double *v = &V[(size_t)(y - yMin) * nx], *w = &W[(size_t)(y - yMin) * nx];
+
+			for(int x=0; x<nx; x++)
+			{
+				if( w[x] > 1e-6 && !pInput->is_NoData(x, y) )
+				{
+					pResult->Set_Value(x, y, v[x] / w[x]);
+				}
+				else
+				{
+					pResult->Set_NoData(x, y);
+				}
+			}
+		}
 	}
 
 	return( true );
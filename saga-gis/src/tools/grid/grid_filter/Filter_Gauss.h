@@ -77,6 +77,13 @@ protected:
 
 	virtual bool			On_Execute			(void);
 
+
+private:
+
+	bool					Get_Kernel			(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, double Sigma);
+	bool					Get_Separable		(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, double Sigma);
+	bool					Get_Recursive		(CSG_Grid *pInput, CSG_Grid *pResult, double Sigma);
+
 };
 
 
@@ -46,9 +46,20 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <vector>
+
 #include "Filter_Rank.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define HISTOGRAM_MAX_BINS	65536
+#define HISTOGRAM_BLOCK		256
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -63,7 +74,13 @@ CFilter_Rank::CFilter_Rank(void)
 	Set_Author		("O.Conrad (c) 2010");
 
 	Set_Description	(_TW(
-		"Rank filter for grids. Set rank to fifty percent to apply a median filter."
+		"Rank filter for grids. Set rank to fifty percent to apply a median filter.\n"
+		"The sliding histogram method updates a histogram of the kernel values only "
+		"with the cells entering and leaving the kernel while moving along a row, "
+		"so that its costs grow only linearly with the kernel radius. It gives exact "
+		"results for integer grids with a value range of up to 65536, for other grids "
+		"the values are quantized to 65536 classes. The automatic choice uses the "
+		"sliding histogram whenever this is exact."
 	));
 
 	//-----------------------------------------------------
@@ -85,6 +102,16 @@ CFilter_Rank::CFilter_Rank(void)
 		50., 0., true, 100., true
 	);
 
+	Parameters.Add_Choice("",
+		"METHOD", _TL("Method"),
+		_TL(""),
+		CSG_String::Format("%s|%s|%s",
+			_TL("automatic"),
+			_TL("sliding histogram"),
+			_TL("sorting")
+		), 0
+	);
+
 	CSG_Grid_Cell_Addressor::Add_Parameters(Parameters);
 }
 
@@ -126,7 +153,28 @@ bool CFilter_Rank::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	bool bExact = false;
+
+	switch( m_pInput->Get_Type() )
+	{
+	case SG_DATATYPE_Bit  : case SG_DATATYPE_Byte : case SG_DATATYPE_Char :
+	case SG_DATATYPE_Word : case SG_DATATYPE_Short: case SG_DATATYPE_DWord:
+	case SG_DATATYPE_Int  : case SG_DATATYPE_ULong: case SG_DATATYPE_Long :
+		bExact = !m_pInput->is_Scaled()	// one class per integer step of the stored values, which are no integers anymore when scaled
+			&& m_pInput->Get_Max() - m_pInput->Get_Min() < HISTOGRAM_MAX_BINS;
+		break;
+
+	default:
+		break;
+	}
+
+	int Method = Parameters("METHOD")->asInt();
+
+	if( Method == 1 || (Method == 0 && bExact) )
+	{
+		Get_Histogram(pResult, Quantile, !bExact);
+	}
+	else for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
@@ -190,6 +238,137 @@ bool CFilter_Rank::Get_Value(int x, int y, double Quantile, double &Value)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Sliding Histogram					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Returns the class holding the k-th smallest value of the
+// histogram, using the block sums to skip empty ranges.
+//---------------------------------------------------------
+static int Get_Histogram_Class(const std::vector<int> &Counts, const std::vector<int> &Blocks, int k)
+{
+	int Block = 0;
+
+	for(; Block<(int)Blocks.size()-1 && k>=Blocks[Block]; Block++)
+	{
+		k -= Blocks[Block];
+	}
+
+	int i = Block * HISTOGRAM_BLOCK, n = (int)Counts.size();
+
+	for(; i<n-1 && k>=Counts[i]; i++)
+	{
+		k -= Counts[i];
+	}
+
+	return( i );
+}
+
+//---------------------------------------------------------
+bool CFilter_Rank::Get_Histogram(CSG_Grid *pResult, double Quantile, bool bQuantize)
+{
+	//-----------------------------------------------------
+	// kernel cells entering (dx, dy) and leaving (dx - 1, dy)
+	// the kernel when moving one cell to the right
+
+	int Radius = 0;
+
+	for(int i=0; i<m_Kernel.Get_Count(); i++)
+	{
+		Radius = M_GET_MAX(Radius, abs(m_Kernel.Get_X(i)));
+		Radius = M_GET_MAX(Radius, abs(m_Kernel.Get_Y(i)));
+	}
+
+	int nKernel = 2 * Radius + 3; std::vector<bool> Kernel(nKernel * nKernel, false);
+
+	#define KERNEL_CELL(dx, dy)	Kernel[(Radius + 1 + (dy)) * nKernel + Radius + 1 + (dx)]
+
+	for(int i=0; i<m_Kernel.Get_Count(); i++)
+	{
+		KERNEL_CELL(m_Kernel.Get_X(i), m_Kernel.Get_Y(i)) = true;
+	}
+
+	std::vector<int> Enter, Leave;	// (dx, dy) pairs
+
+	for(int i=0; i<m_Kernel.Get_Count(); i++)
+	{
+		int dx = m_Kernel.Get_X(i), dy = m_Kernel.Get_Y(i);
+
+		if( !KERNEL_CELL(dx + 1, dy) ) { Enter.push_back(dx    ); Enter.push_back(dy); }
+		if( !KERNEL_CELL(dx - 1, dy) ) { Leave.push_back(dx - 1); Leave.push_back(dy); }
+	}
+
+	//-----------------------------------------------------
+	double Minimum = m_pInput->Get_Min(), Range = m_pInput->Get_Max() - Minimum;
+
+	int nClasses = bQuantize ? HISTOGRAM_MAX_BINS : 1 + (int)Range;
+
+	double dClass = bQuantize && Range > 0. ? Range / nClasses : 1.;
+
+	double Center = bQuantize && Range > 0. ? 0.5 : 0.;	// class centers, but a constant grid's value as it is
+
+	//-----------------------------------------------------
+	int nRows = SG_OMP_Get_Max_Num_Threads();
+
+	for(int yBand=0; yBand<Get_NY() && Set_Progress_Rows(yBand); yBand+=nRows)
+	{
+		int yEnd = M_GET_MIN(yBand + nRows, Get_NY());
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int y=yBand; y<yEnd; y++)
+		{
+			std::vector<int> Counts(nClasses, 0), Blocks(1 + nClasses / HISTOGRAM_BLOCK, 0); int n = 0;
+
+			#define HISTOGRAM_UPDATE(ix, iy, dn) if( m_pInput->is_InGrid(ix, iy) ) {\
+				int Class = (int)((m_pInput->asDouble(ix, iy) - Minimum) / dClass);\
+				if( Class >= nClasses ) { Class = nClasses - 1; } else if( Class < 0 ) { Class = 0; }\
+				Counts[Class] += dn; Blocks[Class / HISTOGRAM_BLOCK] += dn; n += dn;\
+			}
+
+			for(int i=0; i<m_Kernel.Get_Count(); i++)
+			{
+				HISTOGRAM_UPDATE(m_Kernel.Get_X(i), m_Kernel.Get_Y(i, y), 1);
+			}
+
+			for(int x=0; x<Get_NX(); x++)
+			{
+				if( x > 0 )
+				{
+					for(size_t i=0; i<Leave.size(); i+=2) { HISTOGRAM_UPDATE(x + Leave[i], y + Leave[i + 1], -1); }
+					for(size_t i=0; i<Enter.size(); i+=2) { HISTOGRAM_UPDATE(x + Enter[i], y + Enter[i + 1],  1); }
+				}
+
+				if( n < 1 || m_pInput->is_NoData(x, y) )
+				{
+					pResult->Set_NoData(x, y);
+
+					continue;
+				}
+
+				//-----------------------------------------
+				// same interpolation as CSG_Simple_Statistics::Get_Quantile()
+
+				double r = Quantile <= 0. ? 0. : Quantile >= 1. ? n - 1. : Quantile * (n - 1.); int i = (int)r; r -= i;
+
+				double Value = Minimum + dClass * (Get_Histogram_Class(Counts, Blocks, i) + Center);
+
+				if( r > 0. && i + 1 < n )
+				{
+					Value = (1. - r) * Value + r * (Minimum + dClass * (Get_Histogram_Class(Counts, Blocks, i + 1) + Center));
+				}
+
+				pResult->Set_Value(x, y, Value);
+			}
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -87,6 +87,8 @@ private:
 
 	bool					Get_Value			(int x, int y, double Quantile, double &Value);
 
+	bool					Get_Histogram		(CSG_Grid *pResult, double Quantile, bool bQuantize);
+
 };
 
 
@@ -169,6 +169,19 @@ CSG_Tool *		Create_Tool(int i)
 //---------------------------------------------------------
 //{{AFX_SAGA
 
-	TLB_INTERFACE
+	TLB_INTERFACE_ESTABLISH
+	TLB_INTERFACE_INITIALIZE
 
 //}}AFX_SAGA
+
+//---------------------------------------------------------
+static bool is_GDAL_Source(const CSG_Grid_Source *pSource)
+{
+	return( dynamic_cast<const CSG_GDAL_Grid_Source *>(pSource) != NULL );
+}
+
+//---------------------------------------------------------
+extern "C" _SAGA_DLL_EXPORT bool TLB_Finalize	(void)
+{
+	return( SG_Grid_Get_Source_Count(is_GDAL_Source) == 0 );	// grids still reading on demand from this library's data sets keep it loaded
+}
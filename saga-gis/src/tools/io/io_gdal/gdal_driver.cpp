@@ -55,6 +55,8 @@
 #include <cpl_string.h>
 #include <cpl_error.h>
 
+#include <assert.h>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -969,11 +971,202 @@ bool CSG_GDAL_DataSet::Get_MetaData_Item(int i, const char *pszName, CSG_String
 //---------------------------------------------------------
 CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 {
-	if( !is_Reading() )
+	CSG_Array_Int Bands; Bands += i; CSG_Array_Pointer Grids;
+
+	return( Read(Bands, Grids) ? (CSG_Grid *)Grids[0] : NULL );
+}
+
+//---------------------------------------------------------
+/**
+  * Reads the requested bands together. The raster is read in
+  * windows of complete native block rows, so that each block
+  * is decompressed only once, and a pixel interleaved block
+  * serves all bands with the same request. Windows are read
+  * in parallel, each worker thread using its own handle to the
+  * data set. Values are copied row by row into grid memory.
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::Read(const CSG_Array_Int &Bands, CSG_Array_Pointer &Grids)
+{
+	Grids.Destroy();
+
+	if( !is_Reading() || Bands.Get_Size() < 1 )
+	{
+		return( false );
+	}
+
+	for(sLong i=0; i<Bands.Get_Size(); i++)
+	{
+		CSG_Grid *pGrid = _Read_Grid(Bands[i]);
+
+		if( !pGrid )
+		{
+			for(sLong j=0; j<Grids.Get_Size(); j++)
+			{
+				delete((CSG_Grid *)Grids[j]);
+			}
+
+			Grids.Destroy();
+
+			return( false );
+		}
+
+		Grids.Add(pGrid);
+	}
+
+	//-----------------------------------------------------
+	CSG_Grid **pGrids = (CSG_Grid **)Grids.Get_Array(); int nBands = (int)Bands.Get_Size();
+
+	CSG_Array_Int Band_Map(nBands); // one-based band numbers as expected by GDAL
+
+	for(int i=0; i<nBands; i++)
+	{
+		Band_Map[i] = Bands[i] + 1;
+	}
+
+	int nxBlock, nyBlock; GDALGetBlockSize(GDALGetRasterBand(m_pDataSet, Band_Map[0]), &nxBlock, &nyBlock);
+
+	int nRows = nyBlock > 0 ? nyBlock : 1; // window height is a multiple of the native block height
+
+	while( nRows < Get_NY() && (sLong)nRows * Get_NX() < 65536 )
+	{
+		nRows += nyBlock > 0 ? nyBlock : 1;
+	}
+
+	int nMax = (int)M_GET_MAX(1, (64 * N_MEGABYTE_BYTES) / ((sLong)Get_NX() * nBands * 8));	// each thread's buffer takes up to 8 bytes per cell and band, e.g. a single strip might cover the whole image
+
+	if( nRows > nMax )
+	{
+		nRows = nMax;
+	}
+
+	int nWindows = 1 + (Get_NY() - 1) / nRows;
+
+	//-----------------------------------------------------
+	int nThreads = m_pVrtSource ? 1 : M_GET_MIN(SG_OMP_Get_Max_Num_Threads(), nWindows); // virtual subsets are read through the original handle only
+
+	for(int i=0; nThreads>1 && i<nBands; i++)
+	{
+		if( !pGrids[i]->Get_Row_Data(0) ) // cached grids are filled through Set_Value(), which is not thread safe
+		{
+			nThreads = 1;
+		}
+	}
+
+	CSG_Array_Pointer Handles(nThreads);
+
+	for(int i=0; i<nThreads; i++)
+	{
+		Handles[i] = i == 0 ? m_pDataSet : NULL;
+	}
+
+	bool bOkay = true; int nDone = 0;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+	for(int iWindow=0; iWindow<nWindows; iWindow++)
+	{
+		if( !bOkay )
+		{
+			continue;
+		}
+
+		int iThread = nThreads > 1 ? SG_OMP_Get_Thread_Num() : 0;
+
+		if( !Handles[iThread] )
+		{
+			Handles[iThread] = _Read_Handle();
+		}
+
+		if( !Handles[iThread] || !_Read_Rows((GDALDatasetH)Handles[iThread], pGrids, Band_Map.Get_Array(), nBands, iWindow * nRows, M_GET_MIN(nRows, Get_NY() - iWindow * nRows)) )
+		{
+			bOkay = false;
+		}
+
+		#pragma omp atomic
+		nDone++;
+
+		if( iThread == 0 && !SG_UI_Process_Set_Progress(nDone, nWindows) )
+		{
+			bOkay = false;
+		}
+	}
+
+	for(int i=1; i<nThreads; i++)
+	{
+		if( Handles[i] )
+		{
+			GDALClose((GDALDatasetH)Handles[i]);
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int i=0; i<nBands; i++)
+	{
+		if( bOkay )
+		{
+			pGrids[i]->Set_Modified();
+		}
+		else	// failed or cancelled
+		{
+			delete(pGrids[i]);
+		}
+	}
+
+	if( !bOkay )
 	{
+		Grids.Destroy();
+	}
+
+	return( bOkay );
+}
+
+//---------------------------------------------------------
+/**
+  * Creates the grid for band i without reading its values. These
+  * are read from a separate handle to the data set, when a block
+  * of rows is accessed for the first time (see CSG_Grid_Source).
+  * Returns NULL for virtual subsets, which cannot be reopened.
+*/
+//---------------------------------------------------------
+CSG_Grid * CSG_GDAL_DataSet::Read_on_Demand(int i)
+{
+	if( !is_Reading() || m_pVrtSource || i < 0 || i >= Get_Count() )
+	{
+		return( NULL );
+	}
+
+	GDALDatasetH pDataSet = _Read_Handle();
+
+	if( !pDataSet )
+	{
+		return( NULL );
+	}
+
+	CSG_Grid *pGrid = _Read_Grid(i, true);
+
+	if( !pGrid )
+	{
+		GDALClose(pDataSet);
+
 		return( NULL );
 	}
 
+	CSG_GDAL_Grid_Source *pSource = new CSG_GDAL_Grid_Source(pDataSet, i, pGrid->Get_Type(), pGrid->Get_System(), !m_bTransform);
+
+	if( !pGrid->Set_Source(pSource, !m_bTransform) )	// not owned by the grid then
+	{
+		delete(pSource);
+		delete(pGrid);
+
+		return( NULL );
+	}
+
+	return( pGrid );
+}
+
+//---------------------------------------------------------
+CSG_Grid * CSG_GDAL_DataSet::_Read_Grid(int i, bool bCached)
+{
 	//-----------------------------------------------------
 	GDALRasterBandH pBand = GDALGetRasterBand(m_pDataSet, i + 1);
 
@@ -985,7 +1178,7 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 	//-----------------------------------------------------
 	TSG_Data_Type Type = gSG_GDAL_Drivers.Get_SAGA_Type(GDALGetRasterDataType(pBand));
 
-	CSG_Grid *pGrid = SG_Create_Grid(Type, Get_NX(), Get_NY(), Get_Cellsize(), Get_xMin(), Get_yMin());
+	CSG_Grid *pGrid = SG_Create_Grid(Type, Get_NX(), Get_NY(), Get_Cellsize(), Get_xMin(), Get_yMin(), bCached);
 
 	if( !pGrid )
 	{
@@ -1041,39 +1234,135 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 		}
 	}
 
-	//-----------------------------------------------------
-	void *zLine; GDALDataType zType;
+	return( pGrid );
+}
 
-	switch( Type )
+//---------------------------------------------------------
+/**
+  * Opens an additional read-only handle to the data set for a
+  * worker thread, using the driver of the original handle.
+*/
+//---------------------------------------------------------
+GDALDatasetH CSG_GDAL_DataSet::_Read_Handle(void)	const
+{
+	#ifdef GDAL_V2_0_OR_NEWER
+	const char *Drivers[] = { GDALGetDriverShortName(GDALGetDatasetDriver(m_pDataSet)), NULL };
+
+	return( GDALOpenEx(m_File_Name.to_UTF8().Get_Data(), GDAL_OF_RASTER|GDAL_OF_READONLY, Drivers, NULL, NULL) );
+	#else
+	return( GDALOpen(m_File_Name.to_UTF8().Get_Data(), GA_ReadOnly) );
+	#endif
+}
+
+//---------------------------------------------------------
+/**
+  * Reads nRows rows starting at yOffset. Bands sharing the same
+  * buffer type are requested with a single data set request.
+  * Rows of grids held in memory receive the native values by
+  * a plain copy, other grids are filled through Set_Value().
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::_Read_Rows(GDALDatasetH pDataSet, CSG_Grid **pGrids, int *Bands, int nBands, int yOffset, int nRows)	const
+{
+	CSG_Array_Int Types(nBands); bool bSameType = true; sLong nCells = (sLong)Get_NX() * nRows, nBytes = 0;
+
+	for(int i=0; i<nBands; i++)
 	{
-	default                : zLine = SG_Malloc(Get_NX() * sizeof(   int)); zType = GDT_Int32  ; break;
-	case SG_DATATYPE_Float : zLine = SG_Malloc(Get_NX() * sizeof( float)); zType = GDT_Float32; break;
-	case SG_DATATYPE_Double: zLine = SG_Malloc(Get_NX() * sizeof(double)); zType = GDT_Float64; break;
+		Types[i] = gSG_GDAL_Drivers.Get_GDAL_Type(pGrids[i]->Get_Type());
+
+		if( !pGrids[i]->Get_Row_Data(0) || (int)(8 * SG_Data_Type_Get_Size(pGrids[i]->Get_Type())) != GDALGetDataTypeSize((GDALDataType)Types[i]) )
+		{
+			Types[i] = GDT_Float64;
+		}
+
+		bSameType = bSameType && Types[i] == Types[0];
+
+		nBytes += nCells * (GDALGetDataTypeSize((GDALDataType)Types[i]) / 8);
 	}
 
-	for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+	CSG_Array Buffer(1, nBytes);
+
+	if( !Buffer.Get_Array() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( bSameType )
+	{
+		if( GDALDatasetRasterIO(pDataSet, GF_Read, 0, yOffset, Get_NX(), nRows, Buffer.Get_Array(), Get_NX(), nRows, (GDALDataType)Types[0], nBands, Bands, 0, 0, 0) != CE_None )
+		{
+			return( false );
+		}
+	}
+	else
 	{
-		int	yy	= m_bTransform ? y : Get_NY() - 1 - y;
+		char *pBuffer = (char *)Buffer.Get_Array();
 
-		if( GDALRasterIO(pBand, GF_Read, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, zType, 0, 0) == CE_None )
+		for(int i=0; i<nBands; i++)
 		{
-			for(int x=0; x<Get_NX(); x++)
+			if( GDALRasterIO(GDALGetRasterBand(pDataSet, Bands[i]), GF_Read, 0, yOffset, Get_NX(), nRows, pBuffer, Get_NX(), nRows, (GDALDataType)Types[i], 0, 0) != CE_None )
 			{
-				switch( Type )
-				{
-				default                : pGrid->Set_Value(x, yy, ((int    *)zLine)[x], false); break;
-				case SG_DATATYPE_Float : pGrid->Set_Value(x, yy, ((float  *)zLine)[x], false); break;
-				case SG_DATATYPE_Double: pGrid->Set_Value(x, yy, ((double *)zLine)[x], false); break;
-				}
+				return( false );
 			}
+
+			pBuffer += nCells * (GDALGetDataTypeSize((GDALDataType)Types[i]) / 8);
 		}
 	}
 
-	SG_Free(zLine);
+	//-----------------------------------------------------
+	char *pBuffer = (char *)Buffer.Get_Array();
 
-	return( pGrid );
+	for(int i=0; i<nBands; i++)
+	{
+		int nValueBytes = GDALGetDataTypeSize((GDALDataType)Types[i]) / 8;
+
+		for(int iRow=0, y=yOffset; iRow<nRows; iRow++, y++, pBuffer+=Get_NX()*nValueBytes)
+		{
+			int yy = m_bTransform ? y : Get_NY() - 1 - y;
+
+			if( Types[i] != GDT_Float64 || pGrids[i]->Get_Type() == SG_DATATYPE_Double )
+			{
+				memcpy(pGrids[i]->Get_Row_Data(yy), pBuffer, Get_NX() * nValueBytes);
+			}
+			else for(int x=0; x<Get_NX(); x++)
+			{
+				pGrids[i]->Set_Value(x, yy, ((double *)pBuffer)[x], false);
+			}
+		}
+	}
+
+	return( true );
 }
 
+//---------------------------------------------------------
+template <typename TValue>
+static bool SG_GDAL_Get_Row(const CSG_Grid *pGrid, int y, double noDataValue, TValue *Row)
+{
+	const TValue *Values = pGrid->Get_Row_Ptr<TValue>(y);
+
+	assert(Values != NULL);	// TValue has to match the grid's data type
+
+	if( !Values )
+	{
+		return( false );
+	}
+
+	for(int x=0; x<pGrid->Get_NX(); x++)
+	{
+		Row[x] = pGrid->is_NoData_Value((double)Values[x]) ? (TValue)noDataValue : Values[x];
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Writes the grid in stripes of complete native block rows.
+  * If the band's data type is that of the grid and the grid is
+  * held in memory, rows are written without conversion to and
+  * from double precision values.
+*/
 //---------------------------------------------------------
 bool CSG_GDAL_DataSet::Write(int i, CSG_Grid *pGrid, double noDataValue)
 {
@@ -1085,22 +1374,84 @@ bool CSG_GDAL_DataSet::Write(int i, CSG_Grid *pGrid, double noDataValue)
 	GDALRasterBandH pBand = GDALGetRasterBand(m_pDataSet, i + 1);
 
 	//-----------------------------------------------------
-	CPLErr Error  = CE_None;
+	GDALDataType Type = GDALGetRasterDataType(pBand);
+
+	bool bNative = false;
+
+	switch( pGrid->Get_Type() )	// only types with a row copy below
+	{
+	case SG_DATATYPE_Byte  :
+	case SG_DATATYPE_Word  :
+	case SG_DATATYPE_Short :
+	case SG_DATATYPE_DWord :
+	case SG_DATATYPE_Int   :
+	case SG_DATATYPE_Float :
+	case SG_DATATYPE_Double:
+		bNative = pGrid->Get_Row_Data(0) && Type == (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(pGrid->Get_Type());
+		break;
+
+	default:
+		break;
+	}
+
+	if( !bNative )
+	{
+		Type = GDT_Float64;
+	}
+
+	int nxBlock, nyBlock; GDALGetBlockSize(pBand, &nxBlock, &nyBlock);
 
-	double *zLine = (double *)SG_Malloc(Get_NX() * sizeof(double));
+	int nRows = nyBlock > 0 ? nyBlock : 1; // stripe height is a multiple of the native block height
 
-	for(int y=0, yy=Get_NY()-1; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++, yy--)
+	while( nRows < Get_NY() && (sLong)nRows * Get_NX() < 65536 )
 	{
-		for(int x=0; x<Get_NX(); x++)
+		nRows += nyBlock > 0 ? nyBlock : 1;
+	}
+
+	size_t nLineBytes = (size_t)Get_NX() * (GDALGetDataTypeSize(Type) / 8);
+
+	CSG_Array Stripe(nLineBytes, nRows);
+
+	//-----------------------------------------------------
+	CPLErr Error = Stripe.Get_Array() ? CE_None : CE_Failure;
+
+	for(int y=0; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y+=nRows)
+	{
+		int n = M_GET_MIN(nRows, Get_NY() - y); bool bRows = true;
+
+		#pragma omp parallel for
+		for(int iRow=0; iRow<n; iRow++)
 		{
-			zLine[x] = pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy, false);
+			int yy = Get_NY() - 1 - (y + iRow); char *pRow = (char *)Stripe.Get_Array() + iRow * nLineBytes; bool bRow = true;
+
+			if( bNative ) switch( pGrid->Get_Type() )
+			{
+			case SG_DATATYPE_Byte  : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (BYTE   *)pRow); break;
+			case SG_DATATYPE_Word  : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (WORD   *)pRow); break;
+			case SG_DATATYPE_Short : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (short  *)pRow); break;
+			case SG_DATATYPE_DWord : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (DWORD  *)pRow); break;
+			case SG_DATATYPE_Int   : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (int    *)pRow); break;
+			case SG_DATATYPE_Float : bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (float  *)pRow); break;
+			case SG_DATATYPE_Double: bRow = SG_GDAL_Get_Row(pGrid, yy, noDataValue, (double *)pRow); break;
+			default                : bRow = false; break;
+			}
+			else
+			{
+				for(int x=0; x<Get_NX(); x++)
+				{
+					((double *)pRow)[x] = pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy, false);
+				}
+			}
+
+			if( !bRow )
+			{
+				bRows = false;
+			}
 		}
 
-		Error = GDALRasterIO(pBand, GF_Write, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, GDT_Float64, 0, 0);
+		Error = bRows ? GDALRasterIO(pBand, GF_Write, 0, y, Get_NX(), n, Stripe.Get_Array(), Get_NX(), n, Type, 0, 0) : CE_Failure;
 	}
 
-	SG_Free(zLine);
-
 	//-----------------------------------------------------
 	if( Error != CE_None )
 	{
@@ -1126,6 +1477,169 @@ bool CSG_GDAL_DataSet::Write(int i, CSG_Grid *pGrid)
 	return (CSG_GDAL_DataSet::Write(i, pGrid, pGrid->Get_NoData_Value()));
 }
 
+//---------------------------------------------------------
+/**
+  * Adds empty overview levels to all bands, each halving the
+  * resolution of the previous one, until the smaller level's
+  * larger dimension does not exceed nMinSize cells. Fill these
+  * with Write_Overviews().
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::Add_Overviews(int nMinSize)
+{
+	if( !is_Writing() || nMinSize < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Array_Int Levels;
+
+	for(int Factor=2; M_GET_MAX(Get_NX(), Get_NY()) > nMinSize * (Factor / 2); Factor*=2)
+	{
+		Levels += Factor;
+	}
+
+	return( Levels.Get_Size() < 1
+		|| GDALBuildOverviews(m_pDataSet, "NONE", (int)Levels.Get_Size(), Levels.Get_Array(), 0, NULL, NULL, NULL) == CE_None
+	);
+}
+
+//---------------------------------------------------------
+/**
+  * Fills the overview levels of band i. Like CSG_Grid_Pyramid
+  * does, each level generalises the next finer one, here by
+  * combining 2 x 2 cells. The first level is derived from the
+  * grid itself, all others from the level written before.
+  * Levels are processed in stripes, so that memory usage does
+  * not depend on the grid size.
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::Write_Overviews(int i, CSG_Grid *pGrid, TSG_Grid_Pyramid_Generalisation Generalisation, double noDataValue)
+{
+	if( !is_Writing() || !pGrid || pGrid->Get_NX() != Get_NX() || pGrid->Get_NY() != Get_NY() || i < 0 || i >= Get_Count() )
+	{
+		return( false );
+	}
+
+	GDALRasterBandH pBand = GDALGetRasterBand(m_pDataSet, i + 1), pFiner = NULL;
+
+	int nxFiner = Get_NX(), nyFiner = Get_NY();
+
+	for(int iLevel=0; iLevel<GDALGetOverviewCount(pBand); iLevel++)
+	{
+		GDALRasterBandH pLevel = GDALGetOverview(pBand, iLevel);
+
+		int nx = GDALGetRasterBandXSize(pLevel), ny = GDALGetRasterBandYSize(pLevel);
+
+		int nxBlock, nyBlock; GDALGetBlockSize(pLevel, &nxBlock, &nyBlock); int nRows = nyBlock > 0 ? nyBlock : 1;
+
+		CSG_Array Values(sizeof(double), (sLong)nx * nRows), Finer(sizeof(double), pFiner ? (sLong)nxFiner * 2 * nRows : 0);
+
+		for(int y=0; y<ny && SG_UI_Process_Set_Progress(y, ny); y+=nRows)
+		{
+			int n = M_GET_MIN(nRows, ny - y), nFiner = M_GET_MIN(2 * n, nyFiner - 2 * y);
+
+			if( pFiner && GDALRasterIO(pFiner, GF_Read, 0, 2 * y, nxFiner, nFiner, Finer.Get_Array(), nxFiner, nFiner, GDT_Float64, 0, 0) != CE_None )
+			{
+				return( false );
+			}
+
+			#pragma omp parallel for
+			for(int iRow=0; iRow<n; iRow++)
+			{
+				double *pValue = (double *)Values.Get_Array() + (sLong)iRow * nx;
+
+				for(int x=0; x<nx; x++)
+				{
+					double Value = 0.; int Count = 0;
+
+					for(int iy=2*iRow; iy<=2*iRow+1 && iy<nFiner; iy++) for(int ix=2*x; ix<=2*x+1 && ix<nxFiner; ix++)
+					{
+						double z;
+
+						if( pFiner )
+						{
+							z = ((double *)Finer.Get_Array())[(sLong)iy * nxFiner + ix];
+
+							if( z == noDataValue || SG_is_NaN(z) )
+							{
+								continue;
+							}
+						}
+						else
+						{
+							int yy = Get_NY() - 1 - (2 * y + iy);	// the grid's rows are bottom up
+
+							if( pGrid->is_NoData(ix, yy) )
+							{
+								continue;
+							}
+
+							z = pGrid->asDouble(ix, yy, false);
+						}
+
+						switch( Count++ ? Generalisation : GRID_PYRAMID_MaxCount )
+						{
+						case GRID_PYRAMID_Max: if( Value < z ) Value = z; break;
+						case GRID_PYRAMID_Min: if( Value > z ) Value = z; break;
+						case GRID_PYRAMID_Mean: Value += z; break;
+						default: Value = z; break;	// first value
+						}
+					}
+
+					pValue[x] = Count < 1 ? noDataValue : Generalisation == GRID_PYRAMID_Mean ? Value / Count : Value;
+				}
+			}
+
+			if( GDALRasterIO(pLevel, GF_Write, 0, y, nx, n, Values.Get_Array(), nx, n, GDT_Float64, 0, 0) != CE_None )
+			{
+				return( false );
+			}
+		}
+
+		pFiner = pLevel; nxFiner = nx; nyFiner = ny;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Writes a copy of this data set with the given driver, which
+  * has to support copy creation, e.g. "COG".
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::Write_Copy(const CSG_String &File_Name, const CSG_String &Driver, const CSG_String &Options)	const
+{
+	GDALDriverH	pDriver = gSG_GDAL_Drivers.Get_Driver(Driver);
+
+	if( !m_pDataSet || !pDriver || !CSG_GDAL_Drivers::has_Capability(pDriver, GDAL_DCAP_CREATECOPY) )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s", _TL("Driver does not support copy creation."), Driver.c_str()));
+
+		return( false );
+	}
+
+	GDALFlushCache(m_pDataSet);
+
+	char **pOptions = Options.is_Empty() ? NULL : CSLTokenizeString2(Options, " ", CSLT_STRIPLEADSPACES);
+
+	GDALDatasetH pCopy = GDALCreateCopy(pDriver, File_Name.to_UTF8().Get_Data(), m_pDataSet, FALSE, pOptions, NULL, NULL);
+
+	CSLDestroy(pOptions);
+
+	if( !pCopy )
+	{
+		SG_UI_Msg_Add_Error(_TL("Could not create dataset."));
+
+		return( false );
+	}
+
+	GDALClose(pCopy);
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1298,6 +1812,129 @@ bool CSG_GDAL_DataSet::Get_Transformation(CSG_Grid **ppGrid, TSG_Grid_Resampling
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_GDAL_Grid_Source::CSG_GDAL_Grid_Source(GDALDatasetH pDataSet, int i, TSG_Data_Type Type, const CSG_Grid_System &System, bool bFlip)
+{
+	m_pDataSet	= pDataSet;
+	m_pBand		= GDALGetRasterBand(pDataSet, i + 1);
+	m_Type		= (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type);
+	m_System	= System;
+	m_bFlip		= bFlip;
+
+	int	bSuccess;
+
+	m_zScale	= GDALGetRasterScale      (m_pBand, &bSuccess); if( !bSuccess || !m_zScale ) m_zScale  = 1.;
+	m_zOffset	= GDALGetRasterOffset     (m_pBand, &bSuccess); if( !bSuccess              ) m_zOffset = 0.;
+	m_NoData	= GDALGetRasterNoDataValue(m_pBand, &bSuccess); m_bNoData = bSuccess != 0;
+}
+
+//---------------------------------------------------------
+CSG_GDAL_Grid_Source::~CSG_GDAL_Grid_Source(void)
+{
+	GDALClose(m_pDataSet);
+}
+
+//---------------------------------------------------------
+int CSG_GDAL_Grid_Source::Get_Block_Rows(void)	const
+{
+	int	nxBlock, nyBlock;	GDALGetBlockSize(m_pBand, &nxBlock, &nyBlock);
+
+	return( nyBlock > 0 ? nyBlock : 1 );
+}
+
+//---------------------------------------------------------
+bool CSG_GDAL_Grid_Source::Read_Rows(int yFirst, int nRows, void *Buffer)
+{
+	return( GDALRasterIO(m_pBand, GF_Read, 0, yFirst, m_System.Get_NX(), nRows, Buffer, m_System.Get_NX(), nRows, m_Type, 0, 0) == CE_None );
+}
+
+//---------------------------------------------------------
+/**
+  * Lets GDAL resample the requested area, which chooses the
+  * most suitable overview, if the data set provides any.
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_Grid_Source::Read_Resampled(CSG_Grid *pGrid, TSG_Grid_Resampling Resampling)
+{
+	#ifdef GDAL_V2_0_OR_NEWER
+	if( !m_bFlip )	// rows are not in image order
+	{
+		return( false );
+	}
+
+	GDALRasterIOExtraArg Arg; INIT_RASTERIO_EXTRA_ARG(Arg);
+
+	switch( Resampling )
+	{
+	case GRID_RESAMPLING_NearestNeighbour: Arg.eResampleAlg = GRIORA_NearestNeighbour; break;
+	case GRID_RESAMPLING_Bilinear        : Arg.eResampleAlg = GRIORA_Bilinear        ; break;
+	case GRID_RESAMPLING_BicubicSpline   : Arg.eResampleAlg = GRIORA_Cubic           ; break;
+	case GRID_RESAMPLING_BSpline         : Arg.eResampleAlg = GRIORA_CubicSpline     ; break;
+	case GRID_RESAMPLING_Majority        : Arg.eResampleAlg = GRIORA_Mode            ; break;
+	case GRID_RESAMPLING_Minimum         :
+	case GRID_RESAMPLING_Maximum         : return( false );
+	default                              : Arg.eResampleAlg = GRIORA_Average         ; break;
+	}
+
+	//-----------------------------------------------------
+	// requested area in pixel coordinates of the data set, must not exceed its extent
+
+	CSG_Rect Extent(pGrid->Get_Extent(true));
+
+	double xOff = (Extent.Get_XMin() - m_System.Get_XMin(true)) / m_System.Get_Cellsize(), xSize = Extent.Get_XRange() / m_System.Get_Cellsize();
+	double yOff = (m_System.Get_YMax(true) - Extent.Get_YMax()) / m_System.Get_Cellsize(), ySize = Extent.Get_YRange() / m_System.Get_Cellsize();
+
+	if( xOff < 0. || yOff < 0. || xOff + xSize > m_System.Get_NX() || yOff + ySize > m_System.Get_NY() )
+	{
+		return( false );
+	}
+
+	Arg.bFloatingPointWindowValidity = TRUE;
+	Arg.dfXOff = xOff; Arg.dfXSize = xSize;
+	Arg.dfYOff = yOff; Arg.dfYSize = ySize;
+
+	int nxOff = (int)xOff, nxSize = M_GET_MIN(m_System.Get_NX() - nxOff, (int)ceil(xOff + xSize) - nxOff);
+	int nyOff = (int)yOff, nySize = M_GET_MIN(m_System.Get_NY() - nyOff, (int)ceil(yOff + ySize) - nyOff);
+
+	//-----------------------------------------------------
+	CSG_Array Values(sizeof(double), pGrid->Get_NCells());
+
+	if( !Values.Get_Array() || GDALRasterIOEx(m_pBand, GF_Read, nxOff, nyOff, nxSize, nySize, Values.Get_Array(), pGrid->Get_NX(), pGrid->Get_NY(), GDT_Float64, 0, 0, &Arg) != CE_None )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<pGrid->Get_NY(); y++)
+	{
+		double *pValue = (double *)Values.Get_Array() + (sLong)(pGrid->Get_NY() - 1 - y) * pGrid->Get_NX();
+
+		for(int x=0; x<pGrid->Get_NX(); x++, pValue++)
+		{
+			if( (m_bNoData && *pValue == m_NoData) || SG_is_NaN(*pValue) )
+			{
+				pGrid->Set_NoData(x, y);
+			}
+			else
+			{
+				pGrid->Set_Value(x, y, m_zOffset + m_zScale * *pValue);
+			}
+		}
+	}
+
+	return( true );
+	#else
+	return( false );
+	#endif
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
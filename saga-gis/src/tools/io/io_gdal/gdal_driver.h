@@ -174,8 +174,13 @@ public:
 	const char *				Get_MetaData_Item	(int i, const char *pszName)	const;
 	bool						Get_MetaData_Item	(int i, const char *pszName, CSG_String &MetaData)	const;
 	CSG_Grid *					Read				(int i);
+	bool						Read				(const CSG_Array_Int &Bands, CSG_Array_Pointer &Grids);
+	CSG_Grid *					Read_on_Demand		(int i);
 	bool						Write				(int i, CSG_Grid *pGrid, double NoDataValue);
 	bool						Write				(int i, CSG_Grid *pGrid);
+	bool						Add_Overviews		(int nMinSize);
+	bool						Write_Overviews		(int i, CSG_Grid *pGrid, TSG_Grid_Pyramid_Generalisation Generalisation, double NoDataValue);
+	bool						Write_Copy			(const CSG_String &File_Name, const CSG_String &Driver, const CSG_String &Options)	const;
 
 	CSG_Strings					Get_SubDataSets		(bool bDescription = false)	const;
 
@@ -200,6 +205,10 @@ private:
 	bool						_Get_Transformation	(double Transform[6]);
 	bool						_Set_Transformation	(void);
 
+	CSG_Grid *					_Read_Grid			(int i, bool bCached = false);
+	GDALDatasetH				_Read_Handle		(void)	const;
+	bool						_Read_Rows			(GDALDatasetH pDataSet, CSG_Grid **pGrids, int *Bands, int nBands, int yOffset, int nRows)	const;
+
 
 public:
 
@@ -235,6 +244,39 @@ public:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CSG_GDAL_Grid_Source : public CSG_Grid_Source
+{
+public:
+	CSG_GDAL_Grid_Source(GDALDatasetH pDataSet, int i, TSG_Data_Type Type, const CSG_Grid_System &System, bool bFlip);
+	virtual ~CSG_GDAL_Grid_Source(void);
+
+	virtual int					Get_Block_Rows		(void)	const;
+	virtual bool				Read_Rows			(int yFirst, int nRows, void *Buffer);
+	virtual bool				Read_Resampled		(CSG_Grid *pGrid, TSG_Grid_Resampling Resampling);
+
+
+private:
+
+	bool						m_bFlip, m_bNoData;
+
+	double						m_zScale, m_zOffset, m_NoData;
+
+	GDALDataType				m_Type;
+
+	GDALDatasetH				m_pDataSet;
+
+	GDALRasterBandH				m_pBand;
+
+	CSG_Grid_System				m_System;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
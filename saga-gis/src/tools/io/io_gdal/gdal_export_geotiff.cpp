@@ -97,6 +97,42 @@ CGDAL_Export_GeoTIFF::CGDAL_Export_GeoTIFF(void)
 		_TL("A space separated list of key-value pairs (K=V)."),
 		_TL("")
 	);
+
+	//-----------------------------------------------------
+	Parameters.Add_Bool("",
+		"COG"		, _TL("Cloud Optimized"),
+		_TL("Writes a Cloud Optimized GeoTIFF (COG), i.e. an internally tiled and compressed GeoTIFF with internal overviews, "
+			"which are derived from the grids in the same run. Needs temporary disk space for an uncompressed copy."),
+		false
+	);
+
+	Parameters.Add_Choice("COG",
+		"COMPRESSION", _TL("Compression"),
+		_TL("Tiles are compressed in parallel."),
+		CSG_String::Format("%s|%s|%s|%s",
+			_TL("none"),
+			_TL("LZW"),
+			_TL("DEFLATE"),
+			_TL("ZSTD")
+		), 2
+	);
+
+	Parameters.Add_Int("COG",
+		"BLOCKSIZE"	, _TL("Tile Size"),
+		_TL("Width and height of tiles in cells."),
+		512, 16, true
+	);
+
+	Parameters.Add_Choice("COG",
+		"OVERVIEWS"	, _TL("Overviews"),
+		_TL("Generalisation used for the overview levels."),
+		CSG_String::Format("%s|%s|%s|%s",
+			_TL("none"),
+			_TL("mean"),
+			_TL("maximum"),
+			_TL("minimum")
+		), 1
+	);
 }
 
 
@@ -117,6 +153,19 @@ int CGDAL_Export_GeoTIFF::On_Parameter_Changed(CSG_Parameters *pParameters, CSG_
 	return( CSG_Tool_Grid::On_Parameter_Changed(pParameters, pParameter) );
 }
 
+//---------------------------------------------------------
+int CGDAL_Export_GeoTIFF::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
+{
+	if( pParameter->Cmp_Identifier("COG") )
+	{
+		pParameters->Set_Enabled("COMPRESSION", pParameter->asBool());
+		pParameters->Set_Enabled("BLOCKSIZE"  , pParameter->asBool());
+		pParameters->Set_Enabled("OVERVIEWS"  , pParameter->asBool());
+	}
+
+	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -132,6 +181,12 @@ bool CGDAL_Export_GeoTIFF::On_Execute(void)
 		return( false );
 	}
 
+	if( Parameters("COG")->asBool() )
+	{
+		return( Write_COG(pGrids) );
+	}
+
+	//-----------------------------------------------------
 	CSG_GDAL_DataSet DataSet; CSG_Projection Projection; Get_Projection(Projection);
 
 	if( !DataSet.Open_Write(Parameters("FILE")->asString(), "GTiff", Parameters("OPTIONS")->asString(),
@@ -163,6 +218,95 @@ bool CGDAL_Export_GeoTIFF::On_Execute(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The grids are written with their native data type to a
+// temporary, tiled and uncompressed GeoTIFF first, together
+// with the overviews. This is then copied to the target file
+// with GDAL's COG driver, which compresses the tiles with
+// multiple threads and takes the overviews as they are. GDAL
+// versions without COG driver create the same layout with the
+// GeoTIFF driver's COPY_SRC_OVERVIEWS option.
+
+//---------------------------------------------------------
+bool CGDAL_Export_GeoTIFF::Write_COG(CSG_Parameter_Grid_List *pGrids)
+{
+	const char *Compressions[] = { "NONE", "LZW", "DEFLATE", "ZSTD" };
+
+	CSG_String File(Parameters("FILE")->asString()), Temp(SG_File_Get_Name_Temp("sg_cog", SG_File_Get_Path(File)));
+
+	TSG_Data_Type Type = SG_Get_Grid_Type(pGrids);
+
+	int Blocksize = Parameters("BLOCKSIZE")->asInt() / 16 * 16; // tile sizes need to be multiples of 16
+
+	const char *Compression = Compressions[Parameters("COMPRESSION")->asInt()];
+
+	//-----------------------------------------------------
+	CSG_GDAL_DataSet DataSet; CSG_Projection Projection; Get_Projection(Projection);
+
+	if( !DataSet.Open_Write(Temp, "GTiff", CSG_String::Format("TILED=YES BLOCKXSIZE=%d BLOCKYSIZE=%d BIGTIFF=IF_SAFER", Blocksize, Blocksize),
+		Type, pGrids->Get_Grid_Count(), Get_System(), Projection) )
+	{
+		return( false );
+	}
+
+	bool bOverviews = Parameters("OVERVIEWS")->asInt() > 0 && DataSet.Add_Overviews(Blocksize);
+
+	TSG_Grid_Pyramid_Generalisation Generalisation = Parameters("OVERVIEWS")->asInt() == 2 ? GRID_PYRAMID_Max
+		                                           : Parameters("OVERVIEWS")->asInt() == 3 ? GRID_PYRAMID_Min : GRID_PYRAMID_Mean;
+
+	bool bResult = true;
+
+	for(int i=0; bResult && i<pGrids->Get_Grid_Count() && Process_Get_Okay(); i++)
+	{
+		CSG_Grid *pGrid = pGrids->Get_Grid(i);
+
+		Process_Set_Text("%s %d", _TL("Band"), i + 1);
+
+		bResult = DataSet.Write(i, pGrid);
+
+		if( bResult && bOverviews )
+		{
+			Process_Set_Text("%s %d: %s", _TL("Band"), i + 1, _TL("overviews"));
+
+			bResult = DataSet.Write_Overviews(i, pGrid, Generalisation, pGrid->Get_NoData_Value());
+		}
+
+		DataSet.Set_Description(i, pGrids->Get_Grid_Count() > 1 ? pGrid->Get_Name() : pGrid->Get_Description());
+	}
+
+	//-----------------------------------------------------
+	if( (bResult = bResult && Process_Get_Okay()) == true )
+	{
+		Process_Set_Text(_TL("compression"));
+
+		bool bFloat = Type == SG_DATATYPE_Float || Type == SG_DATATYPE_Double, bPredictor = Parameters("COMPRESSION")->asInt() > 0;
+
+		if( SG_Get_GDAL_Drivers().Get_Driver("COG") )
+		{
+			bResult = DataSet.Write_Copy(File, "COG", CSG_String::Format("COMPRESS=%s NUM_THREADS=ALL_CPUS BLOCKSIZE=%d BIGTIFF=IF_SAFER OVERVIEWS=%s PREDICTOR=%s %s",
+				Compression, Blocksize, bOverviews ? "FORCE_USE_EXISTING" : "NONE", bPredictor ? "YES" : "NO", Parameters("OPTIONS")->asString()
+			));
+		}
+		else
+		{
+			bResult = DataSet.Write_Copy(File, "GTiff", CSG_String::Format("TILED=YES BLOCKXSIZE=%d BLOCKYSIZE=%d COMPRESS=%s NUM_THREADS=ALL_CPUS BIGTIFF=IF_SAFER COPY_SRC_OVERVIEWS=YES PREDICTOR=%d %s",
+				Blocksize, Blocksize, Compression, !bPredictor ? 1 : bFloat ? 3 : 2, Parameters("OPTIONS")->asString()	// floating point or horizontal differencing
+			));
+		}
+	}
+
+	DataSet.Close();
+
+	SG_File_Delete(Temp);
+
+	return( bResult );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -78,9 +78,15 @@ public:
 protected:
 
 	virtual int					On_Parameter_Changed	(CSG_Parameters *pParameters, CSG_Parameter *pParameter);
+	virtual int					On_Parameters_Enable	(CSG_Parameters *pParameters, CSG_Parameter *pParameter);
 
 	virtual bool				On_Execute				(void);
 
+
+private:
+
+	bool						Write_COG				(CSG_Parameter_Grid_List *pGrids);
+
 };
 
 
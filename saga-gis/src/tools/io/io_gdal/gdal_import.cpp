@@ -190,6 +190,14 @@ CGDAL_Import::CGDAL_Import(void)
 		), 0
 	);
 
+	Parameters.Add_Bool("",
+		"ON_DEMAND"		, _TL("Load on Demand"),
+		_TL("Keeps the data set open and reads blocks of values only when these are accessed for the first time. "
+			"Coarser resampled views are then taken from overviews, if the data set provides these. "
+			"Not available for user defined extents."),
+		false
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("",
 		"EXTENT"		, _TL("Extent"),
@@ -252,6 +260,7 @@ int CGDAL_Import::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Paramete
 		pParameters->Set_Enabled("EXTENT_GRID"  , pParameter->asInt() == 2);
 		pParameters->Set_Enabled("EXTENT_SHAPES", pParameter->asInt() == 3);
 		pParameters->Set_Enabled("EXTENT_BUFFER", pParameter->asInt() >= 2);
+		pParameters->Set_Enabled("ON_DEMAND"    , pParameter->asInt() == 0);
 	}
 
 	return( CSG_Tool::On_Parameters_Enable(pParameters, pParameter) );
@@ -452,43 +461,75 @@ bool CGDAL_Import::Load(const CSG_String &File, TSG_Grid_Resampling Resampling,
 	}
 
 	//-----------------------------------------------------
-	CSG_Array_Pointer pGrids;
+	CSG_Array_Int Selection; CSG_Array_Int Records; CSG_Array_Pointer pGrids;
 
-	for(int i=0; i<DataSet.Get_Count() && Process_Get_Okay(); i++)
+	for(int i=0; i<DataSet.Get_Count(); i++)
 	{
 		if( !Bands.Get_Selection_Count() || Bands[i].is_Selected() )
 		{
-			CSG_String	Message	= "%s: " + SG_File_Get_Name(File, false);	if( DataSet.Get_Count() > 1 )	Message	+= CSG_String::Format(" [%d/%d]", i + 1, DataSet.Get_Count());
+			Selection += (int)Bands[i].Get_Index(); Records += i;
+		}
+	}
+
+	CSG_String	Message	= "%s: " + SG_File_Get_Name(File, false);
 
-			Process_Set_Text(Message.c_str(), _TL("loading"));
+	Process_Set_Text(Message.c_str(), _TL("loading"));
 
-			CSG_Grid	*pGrid	= DataSet.Read((int)Bands[i].Get_Index());
+	bool bOkay = Selection.Get_Size() > 0;
+
+	if( bOkay && Parameters("ON_DEMAND")->asBool() && !Extent.Get_Area() )
+	{
+		for(sLong j=0; bOkay && j<Selection.Get_Size(); j++)
+		{
+			CSG_Grid *pGrid = DataSet.Read_on_Demand(Selection[j]);
 
-			if( pGrid != NULL )
+			if( (bOkay = pGrid != NULL) == true )
 			{
-				if( bTransform )
-				{
-					Process_Set_Text(Message.c_str(), _TL("translation"));
+				pGrids.Add(pGrid);
+			}
+		}
 
-					DataSet.Get_Transformation(&pGrid, Resampling, true);
-				}
+		if( !bOkay ) // not supported for this data set, read it as a whole
+		{
+			for(sLong j=0; j<pGrids.Get_Size(); j++)
+			{
+				delete((CSG_Grid *)pGrids[j]);
+			}
 
-				if( !Extent.Get_Area() ) // don't associate it with the original file if it's only a subset!
-				{
-					pGrid->Set_File_Name(DataSet.Get_File_Name());
-				}
+			pGrids.Destroy(); bOkay = true;
+		}
+	}
+
+	if( bOkay && (pGrids.Get_Size() > 0 || DataSet.Read(Selection, pGrids)) ) // all selected bands at once, sharing block reads
+	{
+		for(sLong j=0; j<pGrids.Get_Size(); j++)
+		{
+			CSG_Grid	*pGrid	= (CSG_Grid *)pGrids[j]; int i = Records[j];
 
-				pGrid->Set_Name(SG_File_Get_Name(File, false) + (DataSet.Get_Count() == 1 ? CSG_String("") : CSG_String::Format(" [%s]", Bands[i].asString(0))));
+			if( bTransform )
+			{
+				Message	= "%s: " + SG_File_Get_Name(File, false);	if( DataSet.Get_Count() > 1 )	Message	+= CSG_String::Format(" [%d/%d]", i + 1, DataSet.Get_Count());
 
-				if( !pGrid->Get_Projection().is_Okay() && Projection.is_Okay() )
-				{
-					pGrid->Get_Projection().Create(Projection);
-				}
+				Process_Set_Text(Message.c_str(), _TL("translation"));
 
-				pGrids.Add(pGrid);
+				DataSet.Get_Transformation(&pGrid, Resampling, true);
+
+				pGrids[j]	= pGrid;
+			}
+
+			if( !Extent.Get_Area() ) // don't associate it with the original file if it's only a subset!
+			{
+				pGrid->Set_File_Name(DataSet.Get_File_Name());
+			}
+
+			pGrid->Set_Name(SG_File_Get_Name(File, false) + (DataSet.Get_Count() == 1 ? CSG_String("") : CSG_String::Format(" [%s]", Bands[i].asString(0))));
+
+			if( !pGrid->Get_Projection().is_Okay() && Projection.is_Okay() )
+			{
+				pGrid->Get_Projection().Create(Projection);
 			}
 		}
-    }
+	}
 
 	//-----------------------------------------------------
 	CSG_Parameter_Grid_List	*pList	= Parameters("GRIDS")->asGridList();
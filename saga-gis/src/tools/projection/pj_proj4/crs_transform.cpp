@@ -113,7 +113,7 @@ bool CSG_CRSProjector::Create(const CSG_CRSProjector &Projector)
 //---------------------------------------------------------
 bool CSG_CRSProjector::Destroy(void)
 {
-	PROJ_FREE(m_pSource); PROJ_FREE(m_pTarget);
+	PROJ_FREE(m_pSource); PROJ_FREE(m_pTarget); PROJ_FREE(m_pForward); PROJ_FREE(m_pInverse);
 
 	m_bInverse = false;
 
@@ -372,7 +372,37 @@ bool CSG_CRSProjector::Set_Transformation(void)
 {
 	PROJ_FREE(m_pSource); PROJ_FREE(m_pTarget);
 
-	return( _Set_Projection(m_Source, &m_pSource) && _Set_Projection(m_Target, &m_pTarget) );
+	if( !_Set_Projection(m_Source, &m_pSource) || !_Set_Projection(m_Target, &m_pTarget) )
+	{
+		return( false );
+	}
+
+	_Set_Pipeline(m_Source, m_Target, &m_pForward);	// optional, if not available
+	_Set_Pipeline(m_Target, m_Source, &m_pInverse);	// fall back to the two step transformation
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Combines the inverse of the source and the forward
+// projection of the target into a single pipeline, so that
+// each coordinate needs only one transformation call.
+//---------------------------------------------------------
+bool CSG_CRSProjector::_Set_Pipeline(const CSG_Projection &Source, const CSG_Projection &Target, void **ppPipeline) const
+{
+	PROJ_FREE(*ppPipeline);
+
+	CSG_String Pipeline("+proj=pipeline +step +inv " + Source.Get_PROJ() + " +step " + Target.Get_PROJ()); Pipeline.Replace("+type=crs", "");
+
+	*ppPipeline = proj_create((PJ_CONTEXT *)m_pContext, Pipeline);
+
+	if( !*ppPipeline || proj_errno((PJ *)(*ppPipeline)) )
+	{
+		proj_errno_reset((PJ *)m_pSource); // also resets the error state of the shared context
+
+		PROJ_FREE(*ppPipeline);
+	}
+	return( *ppPipeline != NULL );
 }
 
 //---------------------------------------------------------
@@ -421,6 +451,27 @@ bool CSG_CRSProjector::Get_Projection(double &x, double &y)	const
 {
 	if( !m_pSource || !m_pTarget ) { return( false ); }
 
+	PJ *pPipeline = (PJ *)(m_bInverse ? m_pInverse : m_pForward);
+
+	if( pPipeline )
+	{
+		if( proj_angular_input(pPipeline, PJ_FWD) )
+		{
+			x *= M_DEG_TO_RAD; y *= M_DEG_TO_RAD;
+		}
+
+		PJ_COORD c = proj_trans(pPipeline, PJ_FWD, proj_coord(x, y, 0., 0.)); if( proj_errno(pPipeline) ) { proj_errno_reset(pPipeline); return( false ); }
+
+		x = c.v[0]; y = c.v[1];
+
+		if( proj_angular_output(pPipeline, PJ_FWD) )
+		{
+			x *= M_RAD_TO_DEG; y *= M_RAD_TO_DEG;
+		}
+
+		return( true );
+	}
+
 	PJ *pSource = (PJ *)(m_bInverse ? m_pTarget : m_pSource);
 	PJ *pTarget = (PJ *)(m_bInverse ? m_pSource : m_pTarget);
 
@@ -449,6 +500,27 @@ bool CSG_CRSProjector::Get_Projection(double &x, double &y, double &z)	const
 {
 	if( !m_pSource || !m_pTarget ) { return( false ); }
 
+	PJ *pPipeline = (PJ *)(m_bInverse ? m_pInverse : m_pForward);
+
+	if( pPipeline )
+	{
+		if( proj_angular_input(pPipeline, PJ_FWD) )
+		{
+			x *= M_DEG_TO_RAD; y *= M_DEG_TO_RAD;
+		}
+
+		PJ_COORD c = proj_trans(pPipeline, PJ_FWD, proj_coord(x, y, z, 0.)); if( proj_errno(pPipeline) ) { proj_errno_reset(pPipeline); return( false ); }
+
+		x = c.v[0]; y = c.v[1]; z = c.v[2];
+
+		if( proj_angular_output(pPipeline, PJ_FWD) )
+		{
+			x *= M_RAD_TO_DEG; y *= M_RAD_TO_DEG;
+		}
+
+		return( true );
+	}
+
 	PJ *pSource = (PJ *)(m_bInverse ? m_pTarget : m_pSource);
 	PJ *pTarget = (PJ *)(m_bInverse ? m_pSource : m_pTarget);
 
@@ -510,6 +582,186 @@ bool CSG_CRSProjector::Get_Projection(CSG_Point_3D &Point) const
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Transforms n points at once. Points that cannot be
+  * transformed are set to HUGE_VAL.
+*/
+//---------------------------------------------------------
+bool CSG_CRSProjector::Get_Projection(double *x, double *y, int n) const
+{
+	if( !m_pSource || !m_pTarget || n < 1 ) { return( false ); }
+
+	PJ *pPipeline = (PJ *)(m_bInverse ? m_pInverse : m_pForward);
+
+	if( !pPipeline )
+	{
+		for(int i=0; i<n; i++)
+		{
+			if( !Get_Projection(x[i], y[i]) )
+			{
+				x[i] = y[i] = HUGE_VAL;
+			}
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	if( proj_angular_input(pPipeline, PJ_FWD) )
+	{
+		for(int i=0; i<n; i++)
+		{
+			x[i] *= M_DEG_TO_RAD; y[i] *= M_DEG_TO_RAD;
+		}
+	}
+
+	proj_trans_generic(pPipeline, PJ_FWD,
+		x, sizeof(double), n,
+		y, sizeof(double), n,
+		NULL, 0, 0, NULL, 0, 0
+	);
+
+	if( proj_errno(pPipeline) )	// failed points have been set to HUGE_VAL
+	{
+		proj_errno_reset(pPipeline);
+	}
+
+	if( proj_angular_output(pPipeline, PJ_FWD) )
+	{
+		for(int i=0; i<n; i++)
+		{
+			if( x[i] != HUGE_VAL && y[i] != HUGE_VAL )
+			{
+				x[i] *= M_RAD_TO_DEG; y[i] *= M_RAD_TO_DEG;
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Transforms the n regularly spaced points x + i * dx of
+  * row y. If Tolerance is greater than zero, only the end
+  * points of the row are transformed exactly at first. The
+  * midpoint of a segment is then transformed as a further
+  * control point. If it deviates by no more than Tolerance
+  * (in units of the transformed coordinates) from the line
+  * between the end points of the segment, the remaining
+  * points are interpolated linearly. Otherwise the segment
+  * is split and both halves are tested again, down to exact
+  * transformations of all points. The control points of one
+  * subdivision level are transformed with a single call.
+  * Points that cannot be transformed are set to HUGE_VAL.
+*/
+//---------------------------------------------------------
+bool CSG_CRSProjector::Get_Projection_Row(double x, double dx, double y, int n, double *xRow, double *yRow, double Tolerance) const
+{
+	if( n < 1 )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		xRow[i] = x + i * dx; yRow[i] = y;
+	}
+
+	if( Tolerance <= 0. || n < 8 )
+	{
+		return( Get_Projection(xRow, yRow, n) );
+	}
+
+	//-----------------------------------------------------
+	double xEnds[2] = { xRow[0], xRow[n - 1] }, yEnds[2] = { yRow[0], yRow[n - 1] };
+
+	if( !Get_Projection(xEnds, yEnds, 2) )
+	{
+		return( false );
+	}
+
+	xRow[0] = xEnds[0]; xRow[n - 1] = xEnds[1];
+	yRow[0] = yEnds[0]; yRow[n - 1] = yEnds[1];
+
+	CSG_Array_Int Segments; Segments.Add(0); Segments.Add(n - 1);
+
+	while( Segments.Get_Size() > 0 )
+	{
+		int nSegments = (int)Segments.Get_Size() / 2;
+
+		CSG_Vector xMid(nSegments), yMid(nSegments);
+
+		for(int i=0; i<nSegments; i++)
+		{
+			int m = (Segments[2 * i] + Segments[2 * i + 1]) / 2;
+
+			xMid[i] = xRow[m]; yMid[i] = yRow[m];
+		}
+
+		if( !Get_Projection(xMid.Get_Data(), yMid.Get_Data(), nSegments) )
+		{
+			return( false );
+		}
+
+		//-------------------------------------------------
+		CSG_Array_Int Next;
+
+		for(int i=0; i<nSegments; i++)
+		{
+			int a = Segments[2 * i], b = Segments[2 * i + 1], m = (a + b) / 2;
+
+			bool bOkay = xRow[a] != HUGE_VAL && xRow[b] != HUGE_VAL && xMid[i] != HUGE_VAL;
+
+			if( bOkay )
+			{
+				double t = (m - a) / (double)(b - a);
+
+				bOkay = SG_Get_Distance(xMid[i], yMid[i],
+					xRow[a] + t * (xRow[b] - xRow[a]),
+					yRow[a] + t * (yRow[b] - yRow[a])
+				) <= Tolerance;
+			}
+
+			xRow[m] = xMid[i]; yRow[m] = yMid[i];
+
+			if( bOkay )
+			{
+				for(int j=a+1; j<m; j++)
+				{
+					double t = (j - a) / (double)(m - a);
+
+					xRow[j] = xRow[a] + t * (xRow[m] - xRow[a]);
+					yRow[j] = yRow[a] + t * (yRow[m] - yRow[a]);
+				}
+
+				for(int j=m+1; j<b; j++)
+				{
+					double t = (j - m) / (double)(b - m);
+
+					xRow[j] = xRow[m] + t * (xRow[b] - xRow[m]);
+					yRow[j] = yRow[m] + t * (yRow[b] - yRow[m]);
+				}
+			}
+			else
+			{
+				if( m - a > 1 ) { Next.Add(a); Next.Add(m); }
+				if( b - m > 1 ) { Next.Add(m); Next.Add(b); }
+			}
+		}
+
+		Segments = Next;
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                   CRS Operation                       //
@@ -118,12 +118,15 @@ public:
 	bool					Get_Projection				(TSG_Point_3D &Point)             const;
 	bool					Get_Projection				(CSG_Point_3D &Point)             const;
 
+	bool					Get_Projection				(double *x, double *y, int n)     const;
+	bool					Get_Projection_Row			(double x, double dx, double y, int n, double *xRow, double *yRow, double Tolerance = 0.) const;
+
 
 private:
 
 	bool					m_bInverse = false;
 
-	void					*m_pContext = NULL, *m_pSource = NULL, *m_pTarget = NULL;
+	void					*m_pContext = NULL, *m_pSource = NULL, *m_pTarget = NULL, *m_pForward = NULL, *m_pInverse = NULL;
 
 	CSG_Projection			m_Source, m_Target;
 
@@ -135,6 +138,7 @@ private:
 	void					_On_Construction			(void);
 
 	bool					_Set_Projection				(const CSG_Projection &Projection, void **ppProjection) const;
+	bool					_Set_Pipeline				(const CSG_Projection &Source, const CSG_Projection &Target, void **ppPipeline) const;
 
 
 //	void					*m_pTransformation = NULL;
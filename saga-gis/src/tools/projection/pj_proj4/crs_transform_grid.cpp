@@ -48,6 +48,9 @@
 //---------------------------------------------------------
 #include "crs_transform_grid.h"
 
+//---------------------------------------------------------
+#define TRANSFORM_CHUNK	1024	// maximum number of row cells that are transformed together
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -131,6 +134,12 @@ CCRS_Transform_Grid::CCRS_Transform_Grid(bool bList)
 		false
 	);
 
+	Parameters.Add_Double("TARGET_NODE",
+		"MAX_ERROR"		, _TL("Maximum Approximation Error"),
+		_TL("Along each target row only a few control points are transformed exactly and the coordinates in between are interpolated, as long as the interpolation error does not exceed this maximum, given in source cell units. Set to zero to transform each cell exactly."),
+		0.125, 0., true
+	);
+
 	//-----------------------------------------------------
 	m_Grid_Target.Create(&Parameters, false, "TARGET_NODE", "TARGET_");
 
@@ -237,6 +246,8 @@ bool CCRS_Transform_Grid::On_Execute_Transformation(void)
 
 	m_bByteWise = Parameters("BYTEWISE")->asBool();
 
+	m_MaxError  = Parameters("MAX_ERROR")->asDouble();
+
 	//-----------------------------------------------------
 	if( m_bList )
 	{
@@ -358,6 +369,8 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	double Tolerance = m_MaxError * pGrid->Get_Cellsize(); int nChunk = SG_OMP_Get_Chunk_Size(pTarget->Get_NX(), TRANSFORM_CHUNK);
+
 	for(int y=0; y<pTarget->Get_NY() && Set_Progress(y, pTarget->Get_NY()); y++)
 	{
 		double yTarget = pTarget->Get_YMin() + y * pTarget->Get_Cellsize();
@@ -365,39 +378,42 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 		#ifndef _DEBUG
 		#pragma omp parallel for
 		#endif
-		for(int x=0; x<pTarget->Get_NX(); x++)
+		for(int xChunk=0; xChunk<pTarget->Get_NX(); xChunk+=nChunk)
 		{
-			if( !is_In_Target_Area(x, y) )
-			{
-				continue;
-			}
-
-			double z, ySource, xSource = pTarget->Get_XMin() + x * pTarget->Get_Cellsize();
+			int nCells = M_GET_MIN(nChunk, pTarget->Get_NX() - xChunk); double xSources[TRANSFORM_CHUNK], ySources[TRANSFORM_CHUNK];
 
-			//---------------------------------------------------------
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
-			{
-				continue;
-			}
+			m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection_Row(pTarget->Get_XMin() + xChunk * pTarget->Get_Cellsize(),
+				pTarget->Get_Cellsize(), yTarget, nCells, xSources, ySources, Tolerance
+			);
 
-			if( bGeogCS_Adjust )
+			for(int iCell=0, x=xChunk; iCell<nCells; iCell++, x++)
 			{
-				if( xSource < 0. )
+				if( !is_In_Target_Area(x, y) || xSources[iCell] == HUGE_VAL || ySources[iCell] == HUGE_VAL )
 				{
-					xSource	+= 360.;
+					continue;
 				}
-				else if( xSource >= 360. )
+
+				double z, ySource = ySources[iCell], xSource = xSources[iCell];
+
+				if( bGeogCS_Adjust )
 				{
-					xSource	-= 360.;
+					if( xSource < 0. )
+					{
+						xSource	+= 360.;
+					}
+					else if( xSource >= 360. )
+					{
+						xSource	-= 360.;
+					}
 				}
-			}
 
-			if( pX ) pX->Set_Value(x, y, xSource);
-			if( pY ) pY->Set_Value(x, y, ySource);
+				if( pX ) pX->Set_Value(x, y, xSource);
+				if( pY ) pY->Set_Value(x, y, ySource);
 
-			if( pGrid->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
-			{
-				pTarget->Set_Value(x, y, z);
+				if( pGrid->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
+				{
+					pTarget->Set_Value(x, y, z);
+				}
 			}
 		}
 	}
@@ -514,6 +530,8 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	double Tolerance = m_MaxError * Source_System.Get_Cellsize(); int nChunk = SG_OMP_Get_Chunk_Size(Target_System.Get_NX(), TRANSFORM_CHUNK);
+
 	for(int y=0; y<Target_System.Get_NY() && Set_Progress(y, Target_System.Get_NY()); y++)
 	{
 		double yTarget = Target_System.Get_YMin() + y * Target_System.Get_Cellsize();
@@ -521,57 +539,61 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 		#ifndef _DEBUG
 		#pragma omp parallel for
 		#endif
-		for(int x=0; x<Target_System.Get_NX(); x++)
+		for(int xChunk=0; xChunk<Target_System.Get_NX(); xChunk+=nChunk)
 		{
-			if( !is_In_Target_Area(x, y) )
-			{
-				continue;
-			}
+			int nCells = M_GET_MIN(nChunk, Target_System.Get_NX() - xChunk); double xSources[TRANSFORM_CHUNK], ySources[TRANSFORM_CHUNK];
 
-			double z, ySource, xSource = Target_System.Get_XMin() + x * Target_System.Get_Cellsize();
-
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
-			{
-				continue;
-			}
+			m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection_Row(Target_System.Get_XMin() + xChunk * Target_System.Get_Cellsize(),
+				Target_System.Get_Cellsize(), yTarget, nCells, xSources, ySources, Tolerance
+			);
 
-			if( bGeogCS_Adjust )
+			for(int iCell=0, x=xChunk; iCell<nCells; iCell++, x++)
 			{
-				if( xSource < 0. )
-				{
-					xSource += 360.;
-				}
-				else if( xSource >= 360. )
+				if( !is_In_Target_Area(x, y) || xSources[iCell] == HUGE_VAL || ySources[iCell] == HUGE_VAL )
 				{
-					xSource -= 360.;
+					continue;
 				}
-			}
 
-			if( pX ) { pX->Set_Value(x, y, xSource); }
-			if( pY ) { pY->Set_Value(x, y, ySource); }
+				double z, ySource = ySources[iCell], xSource = xSources[iCell];
 
-			for(size_t i=0, j=n; i<nSources; i++, j++)
-			{
-				if( pSources[i]->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grid )
+				if( bGeogCS_Adjust )
 				{
-					CSG_Grid *pSource = (CSG_Grid *)pSources[i];
-					CSG_Grid *pTarget = (CSG_Grid *)pTargets->Get_Item((int)j);
-
-					if( pSource->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
+					if( xSource < 0. )
+					{
+						xSource += 360.;
+					}
+					else if( xSource >= 360. )
 					{
-						pTarget->Set_Value(x, y, z);
+						xSource -= 360.;
 					}
 				}
-				else // if( pSources[i]->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grids )
+
+				if( pX ) { pX->Set_Value(x, y, xSource); }
+				if( pY ) { pY->Set_Value(x, y, ySource); }
+
+				for(size_t i=0, j=n; i<nSources; i++, j++)
 				{
-					CSG_Grids *pSource = (CSG_Grids *)pSources[i];
-					CSG_Grids *pTarget = (CSG_Grids *)pTargets->Get_Item((int)j);
+					if( pSources[i]->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grid )
+					{
+						CSG_Grid *pSource = (CSG_Grid *)pSources[i];
+						CSG_Grid *pTarget = (CSG_Grid *)pTargets->Get_Item((int)j);
 
-					for(int k=0; k<pTarget->Get_Grid_Count(); k++)
+						if( pSource->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
+						{
+							pTarget->Set_Value(x, y, z);
+						}
+					}
+					else // if( pSources[i]->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grids )
 					{
-						if( pSource->Get_Grid_Ptr(k)->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
+						CSG_Grids *pSource = (CSG_Grids *)pSources[i];
+						CSG_Grids *pTarget = (CSG_Grids *)pTargets->Get_Item((int)j);
+
+						for(int k=0; k<pTarget->Get_Grid_Count(); k++)
 						{
-							pTarget->Get_Grid_Ptr(k)->Set_Value(x, y, z); // pTarget->Set_Value(x, y, k, z);
+							if( pSource->Get_Grid_Ptr(k)->Get_Value(xSource, ySource, z, m_Resampling, false, m_bByteWise) )
+							{
+								pTarget->Get_Grid_Ptr(k)->Set_Value(x, y, z); // pTarget->Set_Value(x, y, k, z);
+							}
 						}
 					}
 				}
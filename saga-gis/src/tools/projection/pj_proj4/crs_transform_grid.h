@@ -87,6 +87,8 @@ private:
 
 	bool						m_bList, m_bByteWise;
 
+	double						m_MaxError;
+
 	TSG_Grid_Resampling			m_Resampling;
 
 	CSG_Parameters_Grid_Target	m_Grid_Target;
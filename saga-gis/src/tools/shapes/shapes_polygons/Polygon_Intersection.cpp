@@ -48,6 +48,9 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <vector>
+#include <algorithm>
+
 #include "Polygon_Intersection.h"
 
 
@@ -156,73 +159,211 @@ bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 	m_pA	= pA;
 	m_pB	= pB;
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	return( _Get_Overlay(true) );
+}
+
+//---------------------------------------------------------
+bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+{
+	m_bInvert	= bInvert;
+
+	m_pA	= pA;
+	m_pB	= pB;
+
+	return( _Get_Overlay(false) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define OVERLAY_CHUNK	4096	// number of layer A polygons processed in parallel before their results are merged
+
+//---------------------------------------------------------
+// Only pairs with overlapping extents, found with layer B's
+// spatial index, are clipped. Each thread collects its
+// results in its own layer, tagged with the source ids,
+// which are merged in the order of the sequential A/B loop.
+//---------------------------------------------------------
+bool CPolygon_Overlay::_Get_Overlay(bool bIntersection)
+{
+	_Prepare(m_pA);
+	_Prepare(m_pB);
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+	m_pB->Set_Spatial_Index();
 
 	//-----------------------------------------------------
-	for(sLong id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+	int	nResults	= SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Shapes	*Results	= new CSG_Shapes[nResults];
+
+	for(int i=0; i<nResults; i++)
+	{
+		Results[i].Create(SHAPE_TYPE_Polygon);
+		Results[i].Add_Field("A", SG_DATATYPE_Long);
+		Results[i].Add_Field("B", SG_DATATYPE_Long);
+	}
+
+	//-----------------------------------------------------
+	for(sLong iChunk=0; iChunk<m_pA->Get_Count() && Set_Progress(iChunk, m_pA->Get_Count()); iChunk+=OVERLAY_CHUNK)
 	{
-		for(sLong id_B=0; id_B<m_pB->Get_Count(); id_B++)
+		sLong	nChunk	= iChunk + OVERLAY_CHUNK < m_pA->Get_Count() ? iChunk + OVERLAY_CHUNK : m_pA->Get_Count();
+
+		#pragma omp parallel for schedule(dynamic)
+		for(sLong id_A=iChunk; id_A<nChunk; id_A++)
 		{
-			if( SG_Shape_Get_Intersection(m_pA->Get_Shape(id_A), m_pB->Get_Shape(id_B)->asPolygon(), pResult) )
+			if( bIntersection )
 			{
-				_Add_Polygon(pResult, id_A, id_B);
+				_Get_Intersection(id_A, &Results[SG_OMP_Get_Thread_Num()]);
+			}
+			else
+			{
+				_Get_Difference  (id_A, &Results[SG_OMP_Get_Thread_Num()]);
 			}
 		}
+
+		_Add_Results(Results, nResults);
 	}
 
+	delete[](Results);
+
 	return( true );
 }
 
+//---------------------------------------------------------
+// Updates the lazily evaluated extents, areas and ring
+// orientations, so that the input polygons are only read
+// by the parallel overlay.
+//---------------------------------------------------------
+void CPolygon_Overlay::_Prepare(CSG_Shapes *pPolygons)
+{
+	pPolygons->Update();
 
-///////////////////////////////////////////////////////////
-//														 //
-///////////////////////////////////////////////////////////
+	#pragma omp parallel for
+	for(sLong i=0; i<pPolygons->Get_Count(); i++)
+	{
+		CSG_Shape_Polygon	*pPolygon	= pPolygons->Get_Shape(i)->asPolygon();
+
+		pPolygon->Get_Extent();
+
+		for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+		{
+			pPolygon->Get_Polygon_Part(iPart)->Get_Extent();
+			pPolygon->is_Clockwise(iPart);
+			pPolygon->is_Lake     (iPart);
+		}
+	}
+}
 
 //---------------------------------------------------------
-bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+void CPolygon_Overlay::_Get_Intersection(sLong id_A, CSG_Shapes *pResults)
 {
-	m_bInvert	= bInvert;
+	CSG_Shape	*pA	= m_pA->Get_Shape(id_A);
 
-	m_pA	= pA;
-	m_pB	= pB;
+	CSG_Array_sLong	B;	m_pB->Get_Shapes(pA->Get_Extent(), B);
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	for(sLong i=0; i<B.Get_Size(); i++)
+	{
+		CSG_Shape	*pResult	= pResults->Add_Shape();
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+		if( SG_Shape_Get_Intersection(pA, m_pB->Get_Shape(B[i])->asPolygon(), pResult) )
+		{
+			pResult->Set_Value(0, id_A);
+			pResult->Set_Value(1, B[i]);
+		}
+		else
+		{
+			pResults->Del_Shape(pResults->Get_Count() - 1);
+		}
+	}
+}
 
-	//-----------------------------------------------------
-	for(sLong id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+//---------------------------------------------------------
+void CPolygon_Overlay::_Get_Difference(sLong id_A, CSG_Shapes *pResults)
+{
+	CSG_Shape_Polygon	*pResult	= pResults->Add_Shape()->asPolygon();
+
+	pResult->Assign(m_pA->Get_Shape(id_A), false);
+
+	CSG_Array_sLong	B;	m_pB->Get_Shapes(pResult->Get_Extent(), B);
+
+	for(sLong i=0; i<B.Get_Size() && pResult->is_Valid(); i++)
 	{
-		pResult->Assign(m_pA->Get_Shape(id_A), false);
+		CSG_Shape	*pB	= m_pB->Get_Shape(B[i]);
 
-		for(sLong id_B=0; id_B<m_pB->Get_Count() && pResult->is_Valid(); id_B++)
+		switch( pResult->Intersects(pB) )
 		{
-			switch( pResult->Intersects(m_pB->Get_Shape(id_B)) )
-			{
-			case INTERSECTION_None:
-				break;
-
-			case INTERSECTION_Identical:
-			case INTERSECTION_Contained:
-				pResult->Del_Parts();
-				break;
-
-			case INTERSECTION_Contains:
-			case INTERSECTION_Overlaps:
-				SG_Shape_Get_Difference(pResult, m_pB->Get_Shape(id_B)->asPolygon());
-				break;
-			}
+		case INTERSECTION_None:
+			break;
+
+		case INTERSECTION_Identical:
+		case INTERSECTION_Contained:
+			pResult->Del_Parts();
+			break;
+
+		case INTERSECTION_Contains:
+		case INTERSECTION_Overlaps:
+			SG_Shape_Get_Difference(pResult, pB->asPolygon());
+			break;
 		}
+	}
+
+	if( pResult->is_Valid() )
+	{
+		pResult->Set_Value(0, id_A);
+		pResult->Set_Value(1, -1);
+	}
+	else
+	{
+		pResults->Del_Shape(pResults->Get_Count() - 1);
+	}
+}
+
+//---------------------------------------------------------
+struct SOverlay_Result
+{
+	sLong	A, B, Shape;	int	Layer;
+};
 
-		if( pResult->is_Valid() )
+//---------------------------------------------------------
+static bool Overlay_Result_Compare(const SOverlay_Result &a, const SOverlay_Result &b)
+{
+	return( a.A < b.A || (a.A == b.A && a.B < b.B) );
+}
+
+//---------------------------------------------------------
+void CPolygon_Overlay::_Add_Results(CSG_Shapes *pResults, int nResults)
+{
+	std::vector<SOverlay_Result>	Results;
+
+	for(int i=0; i<nResults; i++)
+	{
+		for(sLong j=0; j<pResults[i].Get_Count(); j++)
 		{
-			_Add_Polygon(pResult, id_A);
+			SOverlay_Result	Result;
+
+			Result.A		= pResults[i].Get_Shape(j)->asLong(0);
+			Result.B		= pResults[i].Get_Shape(j)->asLong(1);
+			Result.Shape	= j;
+			Result.Layer	= i;
+
+			Results.push_back(Result);
 		}
 	}
 
-	return( true );
+	std::sort(Results.begin(), Results.end(), Overlay_Result_Compare);	// deterministic order, as from the sequential A/B loop
+
+	for(size_t i=0; i<Results.size(); i++)
+	{
+		_Add_Polygon(pResults[Results[i].Layer].Get_Shape(Results[i].Shape)->asPolygon(), Results[i].A, Results[i].B);
+	}
+
+	for(int i=0; i<nResults; i++)
+	{
+		pResults[i].Del_Shapes();
+	}
 }
 
 
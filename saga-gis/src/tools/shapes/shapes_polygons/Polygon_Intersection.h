@@ -99,6 +99,12 @@ private:
 	bool					_Add_Polygon		(CSG_Shape_Polygon *pPolygon, sLong id_A, sLong id_B = -1);
 	bool					_Fit_Polygon		(CSG_Shape_Polygon *pPolygon);
 
+	bool					_Get_Overlay		(bool bIntersection);
+	void					_Get_Intersection	(sLong id_A, CSG_Shapes *pResults);
+	void					_Get_Difference		(sLong id_A, CSG_Shapes *pResults);
+	void					_Add_Results		(CSG_Shapes *pResults, int nResults);
+	void					_Prepare			(CSG_Shapes *pPolygons);
+
 };
 
 
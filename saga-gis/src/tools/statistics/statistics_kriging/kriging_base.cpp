@@ -49,6 +49,8 @@
 
 #include "kriging_base.h"
 
+#include <algorithm>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -59,6 +61,8 @@
 //---------------------------------------------------------
 CKriging_Base::CKriging_Base(void)
 {
+	m_Caches	= NULL;	m_nCaches	= 0;
+
 	//-----------------------------------------------------
 	Parameters.Add_Shapes("",
 		"POINTS"		, _TL("Points"),
@@ -247,6 +251,9 @@ int CKriging_Base::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Paramet
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define KRIGING_TILE	16	// tile size used for the cell traversal
+
 //---------------------------------------------------------
 bool CKriging_Base::On_Execute(void)
 {
@@ -313,6 +320,8 @@ bool CKriging_Base::On_Execute(void)
 	//-----------------------------------------------------
 	if( bResult )
 	{
+		m_Caches = new CKriging_Cache[m_nCaches = SG_OMP_Get_Max_Num_Threads()];
+
 		bResult = _Init_Grids() && _Init_Search(true);
 	}
 
@@ -323,34 +332,31 @@ bool CKriging_Base::On_Execute(void)
 
 		Message_Fmt("\n%s: %s", _TL("Variogram Model"), m_Model.Get_Formula(SG_TREND_STRING_Formula_Parameters).c_str());
 
-		for(int y=0; y<m_pValue->Get_NY() && Set_Progress(y, m_pValue->Get_NY()); y++)
+		//-------------------------------------------------
+		// tile-wise, serpentine traversal, so that consecutive
+		// cells of a thread mostly share the same neighbours
+
+		int nx = m_pValue->Get_NX(), ny = m_pValue->Get_NY(), nxTiles = 1 + (nx - 1) / KRIGING_TILE;
+
+		double Minimum = bLog ? pPoints->Get_Minimum(Field) : 0.;
+
+		for(int yTile=0; yTile<ny && Set_Progress(yTile, ny); yTile+=KRIGING_TILE)
 		{
-			double py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
+			int yEnd = M_GET_MIN(yTile + KRIGING_TILE, ny);
 
 			#ifndef _DEBUG
-			#pragma omp parallel for
+			#pragma omp parallel for schedule(dynamic)
 			#endif // !_DEBUG
-			for(int x=0; x<m_pValue->Get_NX(); x++)
+			for(int xTile=0; xTile<nxTiles; xTile++)
 			{
-				double v, e, px = m_pValue->Get_XMin() + x * m_pValue->Get_Cellsize();
+				int xMin = xTile * KRIGING_TILE, xMax = M_GET_MIN(xMin + KRIGING_TILE, nx) - 1;
 
-				if( Get_Value(px, py, v, e) )
+				for(int y=yTile; y<yEnd; y++)
 				{
-					if( bLog )
+					for(int i=0; i<=xMax-xMin; i++)
 					{
-						v = exp(v) - 1. + pPoints->Get_Minimum(Field);
+						_Set_Value((y - yTile) % 2 ? xMax - i : xMin + i, y, bLog, Minimum, bStdDev);
 					}
-
-					if( bStdDev )
-					{
-						e = sqrt(e);
-					}
-
-					Set_Value(x, y, v, e);
-				}
-				else
-				{
-					Set_NoData(x, y);
 				}
 			}
 		}
@@ -365,9 +371,36 @@ bool CKriging_Base::On_Execute(void)
 	m_W     .Destroy();
 	m_Points.Destroy();
 
+	delete[](m_Caches); m_Caches = NULL; m_nCaches = 0;
+
 	return( bResult );
 }
 
+//---------------------------------------------------------
+void CKriging_Base::_Set_Value(int x, int y, bool bLog, double Minimum, bool bStdDev)
+{
+	double v, e, px = m_pValue->Get_XMin() + x * m_pValue->Get_Cellsize(), py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
+
+	if( Get_Value(px, py, v, e) )
+	{
+		if( bLog )
+		{
+			v = exp(v) - 1. + Minimum;
+		}
+
+		if( bStdDev )
+		{
+			e = sqrt(e);
+		}
+
+		Set_Value(x, y, v, e);
+	}
+	else
+	{
+		Set_NoData(x, y);
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -426,6 +459,11 @@ bool CKriging_Base::Init_Points(CSG_Shapes *pPoints, int Field, bool bLog)
 //---------------------------------------------------------
 bool CKriging_Base::_Init_Search(bool bUpdate)
 {
+	for(int i=0; i<m_nCaches; i++)	// point indices have changed
+	{
+		m_Caches[i].Index.Destroy();
+	}
+
 	if( m_Search_Options.Do_Use_All(bUpdate) )	// global
 	{
 		return( Get_Weights(m_Points, m_W) );
@@ -440,26 +478,80 @@ bool CKriging_Base::_Init_Search(bool bUpdate)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CKriging_Base::Get_Points(double x, double y, CSG_Matrix &Points)
+/**
+  * Provides the points and the inverted weights matrix of the
+  * kriging system for the given location. Local systems are
+  * cached per thread and reused as long as the neighbourhood,
+  * i.e. the sorted set of point indices, does not change. The
+  * returned arrays belong to the calling thread's cache, so local
+  * systems are only available while the caches are allocated.
+*/
+//---------------------------------------------------------
+bool CKriging_Base::Get_System(double x, double y, double **&P, double **&W, sLong &n)
 {
-	if( m_Search.is_Okay() )
+	if( !m_Search.is_Okay() )	// global
+	{
+		n = m_Points.Get_NRows();
+		P = m_Points.Get_Data ();
+		W = m_W     .Get_Data ();
+
+		return( n > 0 );
+	}
+
+	//-----------------------------------------------------
+	CSG_Array_sLong Index; CSG_Vector Distance;
+
+	m_Search.Get_Nearest_Points(x, y, m_Search_Options.Get_Max_Points(), m_Search_Options.Get_Radius(), Index, Distance);
+
+	if( Index.Get_Size() < 1 || Index.Get_Size() < (sLong)m_Search_Options.Get_Min_Points() )
 	{
-		CSG_Array_sLong Index; CSG_Vector Distance;
+		return( false );
+	}
+
+	int Thread = SG_OMP_Get_Thread_Num();
+
+	if( !m_Caches || Thread < 0 || Thread >= m_nCaches )	// the returned system must outlive this call, so it has to be stored in a thread's cache
+	{
+		return( false );
+	}
+
+	std::sort(Index.Get_Array(), Index.Get_Array() + Index.Get_Size());
+
+	CKriging_Cache &Cache = m_Caches[Thread];
 
-		m_Search.Get_Nearest_Points(x, y, m_Search_Options.Get_Max_Points(), m_Search_Options.Get_Radius(), Index, Distance);
-		
-		if( Index.Get_Size() >= (sLong)m_Search_Options.Get_Min_Points() && Points.Create(3, Index.Get_Size()) )
+	if( Cache.Index.Get_Size() != Index.Get_Size()
+	||  memcmp(Cache.Index.Get_Array(), Index.Get_Array(), Index.Get_Size() * sizeof(sLong)) )
+	{
+		Cache.Index = Index;
+
+		if( !Cache.Points.Create(3, Index.Get_Size()) )
 		{
-			for(sLong i=0; i<Index.Get_Size(); i++)
-			{
-				Points.Set_Row(i, m_Points[Index[i]]);
-			}
+			Cache.Index.Destroy();
 
-			return( true );
+			return( false );
+		}
+
+		for(sLong i=0; i<Index.Get_Size(); i++)
+		{
+			Cache.Points.Set_Row(i, m_Points[Index[i]]);
+		}
+
+		if( !Get_Weights(Cache.Points, Cache.W) )
+		{
+			Cache.W.Destroy();	// remember the failure for this neighbourhood, too
 		}
 	}
 
-	return( false );
+	if( Cache.W.Get_NRows() < 1 )
+	{
+		return( false );
+	}
+
+	n = Cache.Points.Get_NRows();
+	P = Cache.Points.Get_Data ();
+	W = Cache.W     .Get_Data ();
+
+	return( true );
 }
 
 
@@ -65,6 +65,17 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+class CKriging_Cache	// a thread's last local kriging system
+{
+public:
+
+	CSG_Array_sLong					Index;
+
+	CSG_Matrix						Points, W;
+
+};
+
 //---------------------------------------------------------
 class CKriging_Base : public CSG_Tool
 {
@@ -89,7 +100,7 @@ protected:
 
 	virtual bool					Init_Points				(CSG_Shapes *pPoints, int Field, bool bLog);
 
-	bool							Get_Points				(double x, double y, CSG_Matrix &Points);
+	bool							Get_System				(double x, double y, double **&P, double **&W, sLong &n);
 
 	virtual bool					Get_Weights				(const CSG_Matrix &Points, CSG_Matrix &W)	= 0;
 
@@ -130,6 +141,8 @@ protected:
 
 private:
 
+	int								m_nCaches;
+
 	double							m_Block;
 
 	CSG_Trend						m_Model;
@@ -140,11 +153,15 @@ private:
 
 	class CVariogram_Dialog			*m_pVariogram;
 
+	CKriging_Cache					*m_Caches;
+
 
 	bool							_Init_Grids				(void);
 
 	bool							_Init_Search			(bool bUpdate = false);
 
+	void							_Set_Value				(int x, int y, bool bLog, double Minimum, bool bStdDev);
+
 	bool							_Get_Cross_Validation	(void);
 
 };
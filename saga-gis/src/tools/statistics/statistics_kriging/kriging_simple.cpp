@@ -105,22 +105,9 @@ bool CKriging_Simple::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 //---------------------------------------------------------
 bool CKriging_Simple::Get_Value(double x, double y, double &v, double &e)
 {
-	CSG_Matrix __Points, __W; double **P, **W; sLong n = 0; v = e = 0.;
+	double **P, **W; sLong n = 0; v = e = 0.;
 
-	if( !m_Search.is_Okay() )
-	{	// global
-		n = m_Points.Get_NRows();
-		P = m_Points.Get_Data ();
-		W = m_W     .Get_Data ();
-	}
-	else if( Get_Points(x, y, __Points) && Get_Weights(__Points, __W) )
-	{	// local
-		n = __Points.Get_NRows();
-		P = __Points.Get_Data ();
-		W = __W     .Get_Data ();
-	}
-
-	if( n < 1 )
+	if( !Get_System(x, y, P, W, n) )
 	{
 		return( false );
 	}
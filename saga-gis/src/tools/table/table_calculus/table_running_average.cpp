@@ -197,6 +197,16 @@ bool CTable_Running_Average::On_Execute(void)
 
 	#undef GET_FIELD
 
+	//-----------------------------------------------------
+	CSG_Vector Values; CSG_Array_Int NoData;	// each value is requested up to 'Length' times
+
+	if( !pTable->Get_Column(fValue, Values, &NoData) )
+	{
+		Error_Set(_TL("failed to request field values"));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	for(sLong i=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i++)
 	{
@@ -208,11 +218,11 @@ bool CTable_Running_Average::On_Execute(void)
 			{
 				if( j >= 0 && j < pTable->Get_Count() )
 				{
-					CSG_Table_Record *pRecord = pTable->Get_Record(Index.is_Okay() ? Index[j] : j);
+					sLong k = Index.is_Okay() ? Index[j] : j;
 
-					if( pRecord && !pRecord->is_NoData(fValue) )
+					if( !NoData[k] )
 					{
-						s += pRecord->asDouble(fValue);
+						s += Values[k];
 					}
 				}
 			}
@@ -387,6 +397,16 @@ bool CTable_Aggregation::On_Execute(void)
 		Message_Fmt("\n%s: %s (%d > %d", _TL("Warning"), _TL("number of aggregation records exceeds table's record count"), Length, (int)pTable->Get_Count());
 	}
 
+	//-----------------------------------------------------
+	CSG_Vector Values; CSG_Array_Int NoData;
+
+	if( !pTable->Get_Column(Field, Values, &NoData) )
+	{
+		Error_Set(_TL("failed to request field values"));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	for(sLong i=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i+=Length)
 	{
@@ -394,11 +414,11 @@ bool CTable_Aggregation::On_Execute(void)
 
 		for(sLong j=i, n=i+Length; j<n && j<pTable->Get_Count(); j++)
 		{
-			CSG_Table_Record *pRecord = pTable->Get_Record(Index.is_Okay() ? Index[j] : j);
+			sLong k = Index.is_Okay() ? Index[j] : j;
 
-			if( pRecord && !pRecord->is_NoData(Field) )
+			if( !NoData[k] )
 			{
-				s += pRecord->asDouble(Field);
+				s += Values[k];
 			}
 		}
 
@@ -62,7 +62,10 @@ CFlow_Accumulation_MP::CFlow_Accumulation_MP(void)
 	Set_Author		("O.Conrad (c) 2018");
 
 	Set_Description	(_TW(
-		"A simple implementation of a parallelizable flow accumulation algorithn."
+		"A simple implementation of a parallelizable flow accumulation algorithm. "
+		"Each cell counts its upslope neighbours and is processed as soon as all of "
+		"them have been processed, so that the accumulation is done in a single pass "
+		"shared by all available processor cores."
 	));
 
 	Add_Reference("Freeman, G.T.", "1991",
@@ -98,9 +101,9 @@ CFlow_Accumulation_MP::CFlow_Accumulation_MP(void)
 
 	Parameters.Add_Int("",
 		"UPDATE"	, _TL("Update Frequency"),
-		_TL("if zero no updates will be done"),
+		_TL("ignored, only kept for compatibility"),
 		0, 0, true
-	);
+	)->Set_UseInGUI(false);
 
 	Parameters.Add_Choice("",
 		"METHOD"	, _TL("Method"),
@@ -153,40 +156,64 @@ bool CFlow_Accumulation_MP::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	bool	bChanged;	int	nPasses	= 1;
+	// start with all cells without upslope neighbours, the cells
+	// released by a wavefront batch form the next batch
 
-	int	Update	= Parameters("UPDATE")->asInt();
+	CSG_Array_sLong	Front;
 
-	do
+	for(int y=0; y<Get_NY(); y++)
 	{
-		Process_Set_Text(CSG_String::Format("%s %d", _TL("pass"), nPasses++));
+		for(int x=0; x<Get_NX(); x++)
+		{
+			sLong	Cell	= Get_System().Get_IndexFromRowCol(x, y);
+
+			if( !m_pDEM->is_NoData(x, y) && m_Inflow[Cell] == 0 )
+			{
+				Front.Add(Cell);
+			}
+		}
+	}
 
-		bChanged	= false;
+	sLong	nCells	= Get_NCells() - m_pDEM->Get_NoData_Count(), nDone = 0;
 
-		#ifndef _DEBUG
-		#pragma omp parallel for
-		#endif
-		for(int y=0; y<Get_NY(); y++)
+	while( Front.Get_Size() > 0 && Set_Progress(nDone, nCells) )
+	{
+		CSG_Array_sLong	Next;
+
+		#pragma omp parallel
 		{
-			for(int x=0; x<Get_NX(); x++)
+			CSG_Array_sLong	Queue, Released;	sLong	n	= 0;
+
+			#pragma omp for schedule(dynamic)
+			for(sLong i=0; i<Front.Get_Size(); i++)
 			{
-				if( Get_Flow(x, y) )
+				Queue.Add(Front[i]);
+
+				n	+= Get_Flow(Queue);
+
+				for(sLong j=0; j<Queue.Get_Size(); j++)
 				{
-					bChanged	= true;
+					Released.Add(Queue[j]);
 				}
+
+				Queue.Destroy();
 			}
-		}
 
-		if( Update > 0 && nPasses % Update == 0 )
-		{
-			DataObject_Update(m_pFlow);
+			#pragma omp critical
+			{
+				for(sLong j=0; j<Released.Get_Size(); j++)
+				{
+					Next.Add(Released[j]);
+				}
+
+				nDone	+= n;
+			}
 		}
+
+		Front.Create(Next);
 	}
-	while( bChanged && Process_Get_Okay() );
 
 	//-----------------------------------------------------
-	Message_Fmt("\n%s: %d", _TL("number of passes"), nPasses);
-
 	DataObject_Set_Colors   (m_pFlow, 11, SG_COLORS_WHITE_BLUE);
 	DataObject_Set_Parameter(m_pFlow, "METRIC_SCALE_MODE",   1);	// increasing geometrical intervals
 	DataObject_Set_Parameter(m_pFlow, "METRIC_SCALE_LOG" , 100);	// Geometrical Interval Factor
@@ -204,6 +231,8 @@ bool CFlow_Accumulation_MP::On_Execute(void)
 //---------------------------------------------------------
 bool CFlow_Accumulation_MP::Initialize(void)
 {
+	m_Inflow	= NULL;
+
 	m_pDEM	= Parameters("DEM" )->asGrid();
 	m_pFlow	= Parameters("FLOW")->asGrid();
 
@@ -244,7 +273,7 @@ bool CFlow_Accumulation_MP::Initialize(void)
 	}
 
 	//-----------------------------------------------------
-	return( true );
+	return( Set_Inflow() );
 }
 
 //---------------------------------------------------------
@@ -255,6 +284,44 @@ bool CFlow_Accumulation_MP::Finalize(void)
 		m_Flow[i].Destroy();
 	}
 
+	SG_FREE_SAFE(m_Inflow);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+#define INFLOW_FLAG	0x10	// marks cells with upslope neighbours, so that released cells are not taken as sources
+
+//---------------------------------------------------------
+bool CFlow_Accumulation_MP::Set_Inflow(void)
+{
+	if( (m_Inflow = (char *)SG_Calloc(Get_NCells(), sizeof(char))) == NULL )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		for(int x=0; x<Get_NX(); x++)
+		{
+			char	n	= 0;
+
+			for(int i=0; i<8; i++)
+			{
+				int	ix	= Get_xFrom(i, x);
+				int	iy	= Get_yFrom(i, y);
+
+				if( m_Flow[i].is_InGrid(ix, iy) && m_Flow[i].asDouble(ix, iy) > 0.0 )
+				{
+					n++;
+				}
+			}
+
+			m_Inflow[Get_System().Get_IndexFromRowCol(x, y)]	= n > 0 ? INFLOW_FLAG + n : 0;
+		}
+	}
+
 	return( true );
 }
 
@@ -350,36 +417,59 @@ bool CFlow_Accumulation_MP::Set_MFD(int x, int y, double Convergence)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CFlow_Accumulation_MP::Get_Flow(int x, int y)
+#define BATCH_CELLS	4096	// cells processed per queue and wavefront batch, the remaining queue is passed to the next batch
+
+//---------------------------------------------------------
+sLong CFlow_Accumulation_MP::Get_Flow(CSG_Array_sLong &Queue)
 {
-	if( !m_pFlow->is_NoData(x, y) || m_pDEM->is_NoData(x, y) )
+	sLong	nCells	= 0;
+
+	for( ; Queue.Get_Size() > 0 && nCells < BATCH_CELLS; nCells++)
 	{
-		return( false );
-	}
+		//-------------------------------------------------
+		sLong	Cell	= Queue[Queue.Get_Size() - 1];	Queue.Dec_Array(false);
 
-	//-----------------------------------------------------
-	double	Flow	= Get_Cellarea();
+		int	x	= (int)(Cell % Get_NX());
+		int	y	= (int)(Cell / Get_NX());
 
-	for(int i=0; i<8; i++)
-	{
-		int	ix	= Get_xFrom(i, x);
-		int	iy	= Get_yFrom(i, y);
+		double	Flow	= Get_Cellarea();
 
-		if( m_Flow[i].is_InGrid(ix, iy) && m_Flow[i].asDouble(ix, iy) > 0.0 )
+		for(int i=0; i<8; i++)	// all upslope cells have been processed
 		{
-			if( m_pFlow->is_NoData(ix, iy) )
+			int	ix	= Get_xFrom(i, x);
+			int	iy	= Get_yFrom(i, y);
+
+			if( m_Flow[i].is_InGrid(ix, iy) && m_Flow[i].asDouble(ix, iy) > 0.0 )
 			{
-				return( false );
+				Flow	+= m_Flow[i].asDouble(ix, iy) * m_pFlow->asDouble(ix, iy);
 			}
+		}
+
+		m_pFlow->Set_Value(x, y, Flow);
+
+		#pragma omp flush
 
-			Flow	+= m_Flow[i].asDouble(ix, iy) * m_pFlow->asDouble(ix, iy);
+		//-------------------------------------------------
+		for(int i=0; i<8; i++)	// release the downslope cells
+		{
+			if( m_Flow[i].asDouble(x, y) > 0.0 )
+			{
+				sLong	iCell	= Get_System().Get_IndexFromRowCol(Get_xTo(i, x), Get_yTo(i, y));	char	n;
+
+				#pragma omp atomic capture
+				n	= --m_Inflow[iCell];
+
+				if( n == INFLOW_FLAG )
+				{
+					#pragma omp flush
+
+					Queue.Add(iCell);
+				}
+			}
 		}
 	}
 
-	m_pFlow->Set_Value(x, y, Flow);
-
-	//-----------------------------------------------------
-	return( true );
+	return( nCells );
 }
 
 
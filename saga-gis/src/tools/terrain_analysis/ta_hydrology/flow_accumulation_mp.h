@@ -83,6 +83,8 @@ protected:
 
 private:
 
+	char					*m_Inflow;
+
 	CSG_Grid				*m_pDEM, *m_pFlow, m_Flow[8];
 
 
@@ -93,7 +95,8 @@ private:
 	bool					Set_Dinf				(int x, int y);
 	bool					Set_MFD					(int x, int y, double Convergence);
 
-	bool					Get_Flow				(int x, int y);
+	bool					Set_Inflow				(void);
+	sLong					Get_Flow				(CSG_Array_sLong &Queue);
 
 };
 
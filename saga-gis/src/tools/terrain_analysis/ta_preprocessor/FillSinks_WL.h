@@ -55,6 +55,7 @@
 #include <saga_api/saga_api.h>
 
 #include <iostream>
+#include <map>
 #include <queue>
 #include <vector>
 
@@ -123,6 +124,8 @@ public:
 
 protected:
 
+	virtual int			On_Parameters_Enable	(CSG_Parameters *pParameters, CSG_Parameter *pParameter);
+
 	virtual bool		On_Execute(void);
 
 
@@ -131,6 +134,19 @@ private:
 	typedef		vector< CFillSinks_WL_Node > nodeVector;
 	typedef		priority_queue< CFillSinks_WL_Node, nodeVector, CompareGreater > PriorityQ;
 
+	typedef		map< pair< int, int >, double > SpillMap;
+
+	int			m_Tile_Size, m_nxTiles, m_nyTiles;
+
+	CSG_Grid	*m_pElev;
+
+
+	bool		Fill_Tiled				(CSG_Grid *pFilled);
+
+	int			Get_Tile_Label			(int Tile);
+	void		Get_Tile_Flood			(int Tile, vector<int> &Label, vector<double> &Z, SpillMap *pSpills);
+	int			Get_Perimeter_Label		(const vector< vector<int> > &Perimeter, int x, int y);
+
 };
 
 
@@ -53,6 +53,9 @@
 //---------------------------------------------------------
 #include "FillSinks_WL.h"
 
+#include <float.h>
+#include <limits.h>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -72,8 +75,15 @@ CFillSinks_WL_XXL::CFillSinks_WL_XXL(void)
 		"fill the depression(s) but also to preserve a downward slope along the flow path. If desired, this is accomplished "
 		"by preserving a minimum slope gradient (and thus elevation difference) between cells.\n"
 		"This version of the tool is designed to work on large data sets (e.g. LIDAR data), with smaller "
-		"datasets you might like to check out the fully featured standard version of the tool.\n\n\n"
+		"datasets you might like to check out the fully featured standard version of the tool.\n"
+		"The tiled method follows the parallel priority-flood approach of Barnes (2016). Tiles are filled "
+		"independently and in parallel, the spill elevations between the watersheds found at the tile borders "
+		"are resolved in a small global graph and applied to the tiles in a second pass. The working memory "
+		"is then bounded by a few tiles per processor core. Sinks are filled up to their spill elevation, "
+		"a minimum slope is not preserved.\n\n\n"
 		"References:\n"
+		"Barnes, R. (2016): Parallel priority-flood depression filling for trillion cell digital elevation "
+		"models on desktops or clusters. Computers & Geosciences, Vol. 96: 56-68.\n"
 		"Wang, L. & H. Liu (2006): An efficient method for identifying and filling surface depressions in "
 		"digital elevation models for hydrologic analysis and modelling. International Journal of Geographical "
 		"Information Science, Vol. 20, No. 2: 193-213.\n"
@@ -98,6 +108,33 @@ CFillSinks_WL_XXL::CFillSinks_WL_XXL(void)
 		PARAMETER_TYPE_Double, 0.1, 0.0, true
 	);
 
+	Parameters.Add_Choice(
+		NULL, "METHOD", _TL("Method"),
+		_TL("Either process the whole grid with one priority queue or fill tiles in parallel and resolve the spill elevations across the tile borders."),
+		CSG_String::Format("%s|%s",
+			_TL("global"),
+			_TL("tiled")
+		), 0
+	);
+
+	Parameters.Add_Int(
+		NULL, "TILE_SIZE", _TL("Tile Size"),
+		_TL("Number of columns and rows of a tile."),
+		1024, 64, true
+	);
+
+}
+
+//---------------------------------------------------------
+int CFillSinks_WL_XXL::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
+{
+	if(	pParameter->Cmp_Identifier("METHOD") )
+	{
+		pParameters->Set_Enabled("MINSLOPE" , pParameter->asInt() == 0);
+		pParameters->Set_Enabled("TILE_SIZE", pParameter->asInt() == 1);
+	}
+
+	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
 }
 
 //---------------------------------------------------------
@@ -131,6 +168,14 @@ bool CFillSinks_WL_XXL::On_Execute(void)
 
 	pFilled->Fmt_Name("%s [%s]", pElev->Get_Name(), _TL("no sinks"));
 
+	if( Parameters("METHOD")->asInt() == 1 )
+	{
+		m_pElev		= pElev;
+		m_Tile_Size	= Parameters("TILE_SIZE")->asInt();
+
+		return( Fill_Tiled(pFilled) );
+	}
+
 
 	if( minslope > 0.0 )
 	{
@@ -223,3 +268,366 @@ bool CFillSinks_WL_XXL::On_Execute(void)
 	return (true);
 }
 
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define LABEL_NONE	0
+#define LABEL_OUTER	1	// cells draining to the grid's edge or to no-data
+
+//---------------------------------------------------------
+struct CFillSinks_WL_Cell
+{
+	double	z;	int	i;
+
+	bool	operator < (const CFillSinks_WL_Cell &Cell)	const	{	return( z > Cell.z );	}	// lowest first
+};
+
+//---------------------------------------------------------
+bool CFillSinks_WL_XXL::Fill_Tiled(CSG_Grid *pFilled)
+{
+	m_nxTiles	= 1 + (Get_NX() - 1) / m_Tile_Size;
+	m_nyTiles	= 1 + (Get_NY() - 1) / m_Tile_Size;
+
+	int	nTiles	= m_nxTiles * m_nyTiles;
+
+	if( 2. + 4. * m_Tile_Size * nTiles >= (double)INT_MAX )
+	{
+		Error_Set(_TL("too many tiles, increase the tile size"));
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// 1. fill each tile from its perimeter, label the
+	// watersheds and collect their spill elevations
+
+	vector< vector<int> >	Perimeter(nTiles);	vector<int>	From, To;	vector<double>	Spill;
+
+	Process_Set_Text(_TL("filling tiles"));
+
+	for(int yTile=0; yTile<m_nyTiles && Set_Progress(yTile, m_nyTiles); yTile++)
+	{
+		#pragma omp parallel for schedule(dynamic)
+		for(int xTile=0; xTile<m_nxTiles; xTile++)
+		{
+			int	Tile	= yTile * m_nxTiles + xTile;
+
+			vector<int>	Label;	vector<double>	Z;	SpillMap	Spills;
+
+			Get_Tile_Flood(Tile, Label, Z, &Spills);
+
+			int	nx	= M_GET_MIN(m_Tile_Size, Get_NX() - xTile * m_Tile_Size);
+			int	ny	= M_GET_MIN(m_Tile_Size, Get_NY() - yTile * m_Tile_Size);
+
+			vector<int>	&Border	= Perimeter[Tile];	Border.resize(2 * nx + 2 * ny);
+
+			for(int x=0; x<nx; x++)
+			{
+				Border[         x]	= Label[x];
+				Border[nx +     x]	= Label[x + (ny - 1) * nx];
+			}
+
+			for(int y=0; y<ny; y++)
+			{
+				Border[2 * nx + y]	= Label[y * nx];
+				Border[2 * nx + ny + y]	= Label[y * nx + nx - 1];
+			}
+
+			#pragma omp critical
+			{
+				for(SpillMap::iterator it=Spills.begin(); it!=Spills.end(); it++)
+				{
+					From.push_back(it->first.first);	To.push_back(it->first.second);	Spill.push_back(it->second);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	// 2. link the watersheds across the tile borders; the
+	// perimeter cells keep their elevation when filled
+
+	Process_Set_Text(_TL("linking tiles"));
+
+	SpillMap	Links;
+
+	for(int y=0; y<Get_NY() && Process_Get_Okay(); y++)
+	{
+		bool	bRow	= (y + 1) % m_Tile_Size == 0 && y + 1 < Get_NY();	// last row of a tile
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			bool	bCol	= (x + 1) % m_Tile_Size == 0 && x + 1 < Get_NX();	// last column of a tile
+
+			if( (bRow || bCol) && !m_pElev->is_NoData(x, y) )
+			{
+				int	a	= Get_Perimeter_Label(Perimeter, x, y);
+
+				for(int i=0; i<8; i++)
+				{
+					int	ix	= Get_xTo(i, x);
+					int	iy	= Get_yTo(i, y);
+
+					if( ((bCol && ix > x) || (bRow && iy > y)) && is_InGrid(ix, iy) && !m_pElev->is_NoData(ix, iy) )
+					{
+						int	b	= Get_Perimeter_Label(Perimeter, ix, iy);
+
+						if( a != b )
+						{
+							double	z	= M_GET_MAX(m_pElev->asDouble(x, y), m_pElev->asDouble(ix, iy));
+
+							pair<int, int>	Key(M_GET_MIN(a, b), M_GET_MAX(a, b));
+
+							SpillMap::iterator	it	= Links.find(Key);
+
+							if( it == Links.end() || it->second > z )
+							{
+								Links[Key]	= z;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for(SpillMap::iterator it=Links.begin(); it!=Links.end(); it++)
+	{
+		From.push_back(it->first.first);	To.push_back(it->first.second);	Spill.push_back(it->second);
+	}
+
+	Links.clear();
+
+	//-----------------------------------------------------
+	// 3. priority-flood the watershed graph from the outer
+	// watershed to get each watershed's spill elevation
+
+	Process_Set_Text(_TL("resolving spill elevations"));
+
+	int	nLabels	= Get_Tile_Label(nTiles);
+
+	vector<sLong>	First(nLabels + 1, 0);	vector<int>	Next(2 * From.size());	vector<double>	Next_z(2 * From.size());
+
+	for(size_t i=0; i<From.size(); i++)
+	{
+		First[From[i] + 1]++;
+		First[To  [i] + 1]++;
+	}
+
+	for(int i=0; i<nLabels; i++)
+	{
+		First[i + 1]	+= First[i];
+	}
+
+	{
+		vector<sLong>	n(First.begin(), First.end() - 1);
+
+		for(size_t i=0; i<From.size(); i++)
+		{
+			int	a	= From[i], b	= To[i];
+
+			Next[n[a]]	= b;	Next_z[n[a]++]	= Spill[i];
+			Next[n[b]]	= a;	Next_z[n[b]++]	= Spill[i];
+		}
+	}
+
+	From.clear();	To.clear();	Spill.assign(nLabels, DBL_MAX);
+
+	priority_queue<CFillSinks_WL_Cell>	Queue;	CFillSinks_WL_Cell	Cell;
+
+	Cell.z	= Spill[LABEL_OUTER]	= -DBL_MAX;	Cell.i	= LABEL_OUTER;	Queue.push(Cell);
+
+	while( !Queue.empty() )
+	{
+		Cell	= Queue.top();	Queue.pop();
+
+		if( Cell.z <= Spill[Cell.i] )
+		{
+			for(sLong i=First[Cell.i]; i<First[Cell.i + 1]; i++)
+			{
+				double	z	= M_GET_MAX(Cell.z, Next_z[i]);
+
+				if( z < Spill[Next[i]] )
+				{
+					CFillSinks_WL_Cell	Link;	Link.z = Spill[Next[i]] = z; Link.i = Next[i];
+
+					Queue.push(Link);
+				}
+			}
+		}
+	}
+
+	First.clear();	Next.clear();	Next_z.clear();
+
+	//-----------------------------------------------------
+	// 4. fill the tiles again and raise each watershed to
+	// its spill elevation
+
+	Process_Set_Text(_TL("applying spill elevations"));
+
+	for(int yTile=0; yTile<m_nyTiles && Set_Progress(yTile, m_nyTiles); yTile++)
+	{
+		#pragma omp parallel for schedule(dynamic)
+		for(int xTile=0; xTile<m_nxTiles; xTile++)
+		{
+			int	Tile	= yTile * m_nxTiles + xTile;
+
+			vector<int>	Label;	vector<double>	Z;
+
+			Get_Tile_Flood(Tile, Label, Z, NULL);
+
+			int	xOff	= xTile * m_Tile_Size, nx = M_GET_MIN(m_Tile_Size, Get_NX() - xOff);
+			int	yOff	= yTile * m_Tile_Size, ny = M_GET_MIN(m_Tile_Size, Get_NY() - yOff);
+
+			for(int y=0, i=0; y<ny; y++)
+			{
+				for(int x=0; x<nx; x++, i++)
+				{
+					if( Label[i] == LABEL_NONE )
+					{
+						pFilled->Set_NoData(xOff + x, yOff + y);
+					}
+					else
+					{
+						double	z	= Spill[Label[i]];	// never reached watersheds (DBL_MAX) are not raised
+
+						pFilled->Set_Value(xOff + x, yOff + y, z < DBL_MAX && z > Z[i] ? z : Z[i]);
+					}
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CFillSinks_WL_XXL::Get_Tile_Label(int Tile)
+{
+	return( 2 + Tile * 4 * m_Tile_Size );	// first label of a tile, new labels are only given to perimeter cells
+}
+
+//---------------------------------------------------------
+void CFillSinks_WL_XXL::Get_Tile_Flood(int Tile, vector<int> &Label, vector<double> &Z, SpillMap *pSpills)
+{
+	int	xOff	= (Tile % m_nxTiles) * m_Tile_Size, nx = M_GET_MIN(m_Tile_Size, Get_NX() - xOff);
+	int	yOff	= (Tile / m_nxTiles) * m_Tile_Size, ny = M_GET_MIN(m_Tile_Size, Get_NY() - yOff);
+
+	Label.assign(nx * ny, LABEL_NONE);	Z.assign(nx * ny, 0.0);	vector<bool>	bDone(nx * ny, false);
+
+	int	New	= Get_Tile_Label(Tile);
+
+	priority_queue<CFillSinks_WL_Cell>	Queue;	CFillSinks_WL_Cell	Cell;
+
+	//-----------------------------------------------------
+	for(int y=0, i=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++, i++)
+		{
+			int	gx	= xOff + x;
+			int	gy	= yOff + y;
+
+			if( !m_pElev->is_NoData(gx, gy) )
+			{
+				bool	bOuter	= false;
+
+				for(int j=0; !bOuter && j<8; j++)
+				{
+					bOuter	= !is_InGrid(Get_xTo(j, gx), Get_yTo(j, gy)) || m_pElev->is_NoData(Get_xTo(j, gx), Get_yTo(j, gy));
+				}
+
+				if( bOuter || x == 0 || y == 0 || x == nx - 1 || y == ny - 1 )
+				{
+					Label[i]	= bOuter ? LABEL_OUTER : LABEL_NONE;
+
+					Cell.z	= Z[i]	= m_pElev->asDouble(gx, gy);	Cell.i	= i;	Queue.push(Cell);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	while( !Queue.empty() )
+	{
+		Cell	= Queue.top();	Queue.pop();
+
+		if( bDone[Cell.i] )
+		{
+			continue;
+		}
+
+		bDone[Cell.i]	= true;
+
+		if( Label[Cell.i] == LABEL_NONE )	// a perimeter cell not reached by another watershed
+		{
+			Label[Cell.i]	= New++;
+		}
+
+		int	x	= Cell.i % nx;
+		int	y	= Cell.i / nx;
+
+		for(int j=0; j<8; j++)
+		{
+			int	ix	= Get_xTo(j, x);
+			int	iy	= Get_yTo(j, y);
+
+			if( ix >= 0 && ix < nx && iy >= 0 && iy < ny && !m_pElev->is_NoData(xOff + ix, yOff + iy) )
+			{
+				int	i	= ix + iy * nx;
+
+				if( Label[i] == LABEL_NONE )
+				{
+					Label[i]	= Label[Cell.i];
+
+					CFillSinks_WL_Cell	Neighbour;	Neighbour.i = i;
+
+					Neighbour.z	= Z[i]	= M_GET_MAX(m_pElev->asDouble(xOff + ix, yOff + iy), Z[Cell.i]);
+
+					Queue.push(Neighbour);
+				}
+				else if( pSpills && Label[i] != Label[Cell.i] )
+				{
+					double	z	= M_GET_MAX(Z[i], Z[Cell.i]);
+
+					pair<int, int>	Key(M_GET_MIN(Label[i], Label[Cell.i]), M_GET_MAX(Label[i], Label[Cell.i]));
+
+					SpillMap::iterator	it	= pSpills->find(Key);
+
+					if( it == pSpills->end() || it->second > z )
+					{
+						(*pSpills)[Key]	= z;
+					}
+				}
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+int CFillSinks_WL_XXL::Get_Perimeter_Label(const vector< vector<int> > &Perimeter, int x, int y)
+{
+	int	xTile	= x / m_Tile_Size, xOff = xTile * m_Tile_Size, nx = M_GET_MIN(m_Tile_Size, Get_NX() - xOff);
+	int	yTile	= y / m_Tile_Size, yOff = yTile * m_Tile_Size, ny = M_GET_MIN(m_Tile_Size, Get_NY() - yOff);
+
+	const vector<int>	&Border	= Perimeter[yTile * m_nxTiles + xTile];	x -= xOff; y -= yOff;
+
+	if( y ==      0 )	return( Border[         x] );
+	if( y == ny - 1 )	return( Border[nx +     x] );
+	if( x ==      0 )	return( Border[2 * nx + y] );
+
+	return( Border[2 * nx + ny + y] );	// x == nx - 1
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------